@@ -0,0 +1,284 @@
+/*
+ * backend_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <tip/db/pg.hpp>
+
+#include "mock_server.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** Allocations made by the library and the benchmark, not the mock server */
+std::atomic< std::size_t > allocations{0};
+thread_local bool track_allocations = true;
+
+}  // namespace
+
+void*
+operator new(std::size_t size)
+{
+    if (track_allocations)
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc{};
+    return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+using namespace tip::db::pg;
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * Database service connected to a mock backend, the io service is run by
+ * several threads.
+ */
+class mock_backend {
+public:
+    mock_backend(test::mock_script const& script, std::size_t pool_size,
+            std::size_t threads)
+        : server_{ script, [](){ track_allocations = false; } },
+          alias_{ "bench" },
+          svc_{}, work_{}, threads_{},
+          mutex_{}, done_{}, waiting_{0}, errors_{0}
+    {
+        db_service::add_connection(server_.connection_string(alias_), pool_size);
+        svc_ = db_service::io_service();
+        work_.reset(new asio_config::io_service::work(*svc_));
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([](){ db_service::run(); });
+        }
+        // Open the connections
+        run_transactions(pool_size, 1);
+    }
+    ~mock_backend()
+    {
+        svc_->post([](){ db_service::stop(); });
+        work_.reset();
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    /**
+     * Run transactions in parallel, each runs the queries one after another.
+     * Return when all are committed.
+     */
+    void
+    run_transactions(std::size_t count, std::size_t queries)
+    {
+        std::vector< client_state > clients(count);
+        start_wait(count);
+        for (auto& client : clients) {
+            client.remaining = queries;
+            client_state* cl = &client;
+            db_service::begin(alias_,
+                [this, cl](transaction_ptr tran)
+                {
+                    cl->tran = tran;
+                    next_query(*cl);
+                },
+                [this](error::db_error const&) { failed(); });
+        }
+        wait();
+    }
+
+    /**
+     * Start transactions in parallel and commit them as soon as they are
+     * started. Return the average time from the call to begin until
+     * the transaction is handed out.
+     */
+    clock_type::duration
+    checkout(std::size_t count)
+    {
+        std::vector< clock_type::time_point > started(count);
+        std::atomic< clock_type::rep > total{0};
+        start_wait(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            clock_type::time_point* start = &started[i];
+            *start = clock_type::now();
+            db_service::begin(alias_,
+                [this, start, &total](transaction_ptr tran)
+                {
+                    total += (clock_type::now() - *start).count();
+                    tran->commit_async([this]() { finished(); },
+                            [this](error::db_error const&) { failed(); });
+                },
+                [this](error::db_error const&) { failed(); });
+        }
+        wait();
+        return clock_type::duration{ total / static_cast< clock_type::rep >(count) };
+    }
+
+    std::size_t
+    errors() const
+    { return errors_; }
+private:
+    struct client_state {
+        transaction_ptr tran;
+        std::size_t     remaining;
+    };
+
+    void
+    next_query(client_state& client)
+    {
+        client_state* cl = &client;
+        query(client.tran, "select * from bench").run_async(
+            [this, cl](transaction_ptr, resultset res, bool complete)
+            {
+                if (complete) {
+                    benchmark::DoNotOptimize(res.size());
+                    if (--cl->remaining) {
+                        next_query(*cl);
+                    } else {
+                        cl->tran->commit_async([this]() { finished(); },
+                                [this](error::db_error const&) { failed(); });
+                        cl->tran.reset();
+                    }
+                }
+            },
+            [this](error::db_error const&) { failed(); });
+    }
+
+    void
+    start_wait(std::size_t count)
+    {
+        waiting_ = count;
+    }
+    void
+    finished()
+    {
+        if (--waiting_ == 0) {
+            std::lock_guard< std::mutex > lock{mutex_};
+            done_.notify_all();
+        }
+    }
+    void
+    failed()
+    {
+        ++errors_;
+        finished();
+    }
+    void
+    wait()
+    {
+        std::unique_lock< std::mutex > lock{mutex_};
+        done_.wait(lock, [this]() { return waiting_ == 0; });
+    }
+private:
+    test::mock_server                                   server_;
+    dbalias                                             alias_;
+    asio_config::io_service_ptr                         svc_;
+    std::unique_ptr< asio_config::io_service::work >    work_;
+    std::vector< std::thread >                          threads_;
+
+    std::mutex                                          mutex_;
+    std::condition_variable                             done_;
+    std::atomic< std::size_t >                          waiting_;
+    std::atomic< std::size_t >                          errors_;
+};
+
+const std::size_t io_threads = 2;
+const std::size_t queries_per_transaction = 10;
+
+/**
+ * Transactions of simple queries on a number of connections.
+ * Arguments: connections, rows per resultset, backend latency in us.
+ * The resultsets have 4 text columns of 16 bytes.
+ */
+void
+BackendQueries(benchmark::State& state)
+{
+    std::size_t connections = state.range(0);
+    test::mock_script script;
+    script.columns  = 4;
+    script.value_size = 16;
+    script.rows     = state.range(1);
+    script.latency  = std::chrono::microseconds{ state.range(2) };
+
+    mock_backend backend(script, connections, io_threads);
+    std::size_t allocs_before = allocations;
+    while (state.KeepRunning()) {
+        backend.run_transactions(connections, queries_per_transaction);
+    }
+    std::size_t allocs = allocations - allocs_before;
+    if (backend.errors()) {
+        state.SkipWithError("Mock backend returned errors");
+        return;
+    }
+
+    double queries = state.iterations() * connections * queries_per_transaction;
+    state.counters["queries"] = benchmark::Counter(queries,
+            benchmark::Counter::kIsRate);
+    state.counters["rows"] = benchmark::Counter(queries * script.rows,
+            benchmark::Counter::kIsRate);
+    state.counters["allocs/query"] = queries > 0 ? allocs / queries : 0;
+}
+BENCHMARK(BackendQueries)
+    ->Args({1, 1, 0})->Args({1, 100, 0})->Args({1, 1000, 0})
+    ->Args({4, 100, 0})->Args({4, 100, 100})->Args({16, 100, 100})
+    ->UseRealTime();
+
+/**
+ * Average time from db_service::begin to the transaction callback,
+ * including the begin command round trip.
+ * Arguments: pool size, concurrent transactions. When there are more
+ * transactions than connections the latency includes waiting for
+ * a connection to become idle.
+ */
+void
+PoolCheckout(benchmark::State& state)
+{
+    std::size_t pool_size = state.range(0);
+    std::size_t clients = state.range(1);
+
+    mock_backend backend(test::mock_script{}, pool_size, io_threads);
+    std::size_t allocs_before = allocations;
+    while (state.KeepRunning()) {
+        auto elapsed = backend.checkout(clients);
+        state.SetIterationTime(
+                std::chrono::duration_cast< std::chrono::duration< double > >(
+                        elapsed).count());
+    }
+    std::size_t allocs = allocations - allocs_before;
+    if (backend.errors()) {
+        state.SkipWithError("Mock backend returned errors");
+        return;
+    }
+    double transactions = state.iterations() * clients;
+    state.counters["allocs/tran"] = transactions > 0 ? allocs / transactions : 0;
+}
+BENCHMARK(PoolCheckout)
+    ->Args({1, 1})->Args({4, 4})->Args({2, 8})
+    ->UseManualTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+/*
+ * bytea_parse_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <tip/db/pg/io/bytea.hpp>
+#include <tip/db/pg/detail/protocol_parsers.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace tip::db::pg;
+
+std::vector< byte >
+make_hex_bytea(std::size_t size)
+{
+    static char const HEX[] = "0123456789abcdef";
+    std::vector< byte > buffer{ '\\', 'x' };
+    buffer.reserve(size * 2 + 2);
+    for (std::size_t i = 0; i < size; ++i) {
+        unsigned char b = (i * 131 + 7) & 0xff;
+        buffer.push_back(HEX[b >> 4]);
+        buffer.push_back(HEX[b & 0x0f]);
+    }
+    return buffer;
+}
+
+void
+ByteaStateMachineParse(benchmark::State& state)
+{
+    auto buffer = make_hex_bytea(state.range(0));
+    while (state.KeepRunning()) {
+        std::vector< byte > data;
+        io::detail::bytea_parser().parse(buffer.begin(), buffer.end(),
+                std::back_inserter(data));
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(ByteaStateMachineParse)->Range(1 << 10, 16 << 20);
+
+void
+ByteaTextParse(benchmark::State& state)
+{
+    auto buffer = make_hex_bytea(state.range(0));
+    while (state.KeepRunning()) {
+        bytea data;
+        io::protocol_read< TEXT_DATA_FORMAT >(buffer.begin(), buffer.end(), data);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(ByteaTextParse)->Range(1 << 10, 16 << 20);
+
+}  // namespace
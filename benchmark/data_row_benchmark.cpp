@@ -0,0 +1,94 @@
+/*
+ * data_row_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <tip/db/pg/detail/protocol.hpp>
+#include <tip/db/pg/protocol_io_traits.hpp>
+#include <tip/db/pg/log.hpp>
+
+#include "db/mock_backend.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+LOCAL_LOGGING_FACILITY(PGBENCH, OFF);
+LOCAL_LOGGING_FACILITY_FUNC(PGTRACE, TRACE, trace_log);
+
+namespace {
+
+using namespace tip::db::pg;
+using namespace tip::db::pg::detail;
+
+/**
+ * DataRow message as it is read from the socket, fields are int4 in text
+ * format
+ */
+void
+make_data_row(message& m, int fields)
+{
+    std::vector< test::wire_field > values;
+    for (int i = 0; i < fields; ++i) {
+        values.emplace_back(std::to_string(i * 1000));
+    }
+    test::backend_stream out;
+    out.data_row(values);
+    std::copy(out.bytes().begin(), out.bytes().end(), m.output());
+}
+
+/**
+ * Read a DataRow message, the message logs its size at the internals
+ * log level
+ */
+void
+DataRowRead(benchmark::State& state)
+{
+    message m;
+    make_data_row(m, state.range(0));
+    row_data row;
+    while (state.KeepRunning()) {
+        m.reset_read();
+        m.read(row);
+        benchmark::DoNotOptimize(row.data.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(DataRowRead)->Arg(4)->Arg(16);
+
+/**
+ * The log statement for a DataRow, with the default severity of the
+ * facility turned off
+ */
+void
+DataRowLogOff(benchmark::State& state)
+{
+    std::size_t len = 0;
+    while (state.KeepRunning()) {
+        local_log() << "Row data message size " << ++len;
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(DataRowLogOff);
+
+/**
+ * The log statement for a DataRow, the severity is below the minimum
+ * severity of the logger
+ */
+void
+DataRowLogFiltered(benchmark::State& state)
+{
+    logger::min_severity(logger::INFO);
+    std::size_t len = 0;
+    while (state.KeepRunning()) {
+        trace_log() << "Row data message size " << ++len;
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(DataRowLogFiltered);
+
+}  // namespace
@@ -0,0 +1,138 @@
+/*
+ * datetime_parse_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <tip/db/pg/io/boost_date_time.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#include <boost/spirit/include/qi.hpp>
+#include <boost/spirit/include/phoenix.hpp>
+#pragma GCC diagnostic pop
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace tip::db::pg;
+
+/**
+ * Spirit.Qi grammar previously used for parsing timestamps, kept as
+ * a baseline
+ */
+template < typename InputIterator >
+struct qi_datetime_grammar :
+        boost::spirit::qi::grammar< InputIterator, boost::posix_time::ptime()> {
+    typedef boost::posix_time::ptime value_type;
+    qi_datetime_grammar() : qi_datetime_grammar::base_type(datetime)
+    {
+        namespace qi = boost::spirit::qi;
+        namespace phx = boost::phoenix;
+        using qi::_pass;
+        using qi::_val;
+        using qi::_1;
+        using qi::_2;
+        using qi::_3;
+        using qi::_4;
+        _2digits = qi::uint_parser< std::uint32_t, 10, 2, 2 >();
+        _4digits = qi::uint_parser< std::uint32_t, 10, 4, 4 >();
+        fractional_part = -('.' >> qi::long_);
+        time = (_2digits >> ':' >> _2digits >> ':' >> _2digits >> fractional_part )
+            [ _pass = (_1 < 24) && (_2 < 60) && (_3 < 60),
+              _val = phx::construct< boost::posix_time::time_duration >(_1, _2, _3, _4)];
+        date = (_4digits >> "-" >> _2digits >> "-" >> _2digits)
+            [
+                  _pass = (1400 <= _1) && (_1 <= 10000) && (_3 < 32),
+                 phx::try_[
+                    _val = phx::construct< boost::gregorian::date > (_1, _2, _3)
+                ].catch_all[
+                    _pass = false
+                ]
+            ];
+        datetime = (date >> ' ' >> time)
+            [ _val = phx::construct< value_type >( _1, _2) ];
+    }
+    boost::spirit::qi::rule< InputIterator, value_type()> datetime;
+    boost::spirit::qi::rule< InputIterator, boost::gregorian::date()> date;
+    boost::spirit::qi::rule< InputIterator, boost::posix_time::time_duration()> time;
+    boost::spirit::qi::rule< InputIterator, std::uint32_t() > _2digits;
+    boost::spirit::qi::rule< InputIterator, std::int32_t() > _4digits;
+    boost::spirit::qi::rule< InputIterator, std::uint64_t() > fractional_part;
+};
+
+std::vector< std::vector< byte > > const&
+timestamps()
+{
+    static std::vector< std::vector< byte > > values = [](){
+        std::vector< std::string > literals {
+            "2016-03-24 18:00:00",
+            "2016-03-24 18:00:00.123456",
+            "2000-01-01 00:00:00.5+03",
+            "1999-12-31 23:59:59.999+05:30",
+            "2017-07-15 09:41:12.000001-08"
+        };
+        std::vector< std::vector< byte > > buffers;
+        for (auto const& l : literals) {
+            buffers.emplace_back(l.begin(), l.end());
+        }
+        return buffers;
+    }();
+    return values;
+}
+
+void
+QiTimestampParse(benchmark::State& state)
+{
+    namespace qi = boost::spirit::qi;
+    typedef std::vector< byte >::const_iterator iterator;
+    auto const& values = timestamps();
+    boost::posix_time::ptime val;
+    std::size_t n{0};
+    while (state.KeepRunning()) {
+        auto const& buffer = values[n++ % values.size()];
+        // The grammar was constructed for each field parsed
+        qi_datetime_grammar< iterator > grammar;
+        iterator begin = buffer.begin();
+        qi::parse(begin, buffer.end(), grammar, val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+BENCHMARK(QiTimestampParse);
+
+void
+TimestampTextParse(benchmark::State& state)
+{
+    auto const& values = timestamps();
+    boost::posix_time::ptime val;
+    std::size_t n{0};
+    while (state.KeepRunning()) {
+        auto const& buffer = values[n++ % values.size()];
+        io::protocol_read< TEXT_DATA_FORMAT >(buffer.begin(), buffer.end(), val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+BENCHMARK(TimestampTextParse);
+
+void
+TimestampBinaryParse(benchmark::State& state)
+{
+    std::vector< byte > buffer;
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer,
+            boost::posix_time::time_from_string("2016-03-24 18:00:00.123456"));
+    boost::posix_time::ptime val;
+    while (state.KeepRunning()) {
+        io::protocol_read< BINARY_DATA_FORMAT >(buffer.begin(), buffer.end(), val);
+        benchmark::DoNotOptimize(val);
+    }
+}
+BENCHMARK(TimestampBinaryParse);
+
+}  // namespace
+
+BENCHMARK_MAIN();
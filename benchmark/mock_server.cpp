@@ -0,0 +1,400 @@
+/*
+ * mock_server.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include "mock_server.hpp"
+#include "db/mock_backend.hpp"
+
+#include <tip/db/pg/asio_config.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace test {
+
+namespace {
+
+using buffer_type = std::vector< char >;
+using stream_protocol = asio_config::stream_protocol;
+using error_code = asio_config::error_code;
+
+const std::int32_t ssl_request_code = 80877103;
+
+std::int32_t
+read_int(char const* p)
+{
+    unsigned char const* u = reinterpret_cast< unsigned char const* >(p);
+    return static_cast< std::int32_t >(
+            (std::uint32_t(u[0]) << 24) | (std::uint32_t(u[1]) << 16) |
+            (std::uint32_t(u[2]) << 8) | std::uint32_t(u[3]));
+}
+
+std::string
+make_socket_path()
+{
+    static std::atomic< int > counter{0};
+    std::ostringstream os;
+    os << "/tmp/.pg_async_mock." << ::getpid() << "." << counter++;
+    return os.str();
+}
+
+}  // namespace
+
+struct mock_server::impl {
+    class session;
+    using session_ptr = std::shared_ptr< session >;
+
+    asio_config::io_service         svc_;
+    mock_script                     script_;
+    std::string                     path_;
+    stream_protocol::acceptor       acceptor_;
+    std::atomic< std::size_t >      queries_;
+
+    /** Row description and data rows of the scripted resultset */
+    backend_stream                  row_description_;
+    backend_stream                  data_rows_;
+    std::string                     select_tag_;
+
+    std::thread                     thread_;
+
+    impl(mock_script const& script, thread_init init)
+        : svc_{}, script_(script), path_{ make_socket_path() },
+          acceptor_{svc_}, queries_{0}
+    {
+        make_resultset();
+        ::unlink(path_.c_str());
+        stream_protocol::endpoint ep{path_};
+        acceptor_.open(ep.protocol());
+        acceptor_.bind(ep);
+        acceptor_.listen();
+        accept();
+        thread_ = std::thread{ [this, init]()
+        {
+            if (init)
+                init();
+            svc_.run();
+        } };
+    }
+    ~impl()
+    {
+        svc_.stop();
+        thread_.join();
+        ::unlink(path_.c_str());
+    }
+
+    void
+    make_resultset()
+    {
+        std::vector< wire_column > columns;
+        for (std::size_t i = 0; i < script_.columns; ++i) {
+            columns.emplace_back("col" + std::to_string(i));
+        }
+        row_description_.row_description(columns);
+        // Text values are the same in text and binary format, any result
+        // format requested in Bind is satisfied
+        std::vector< wire_field > values(script_.columns,
+                wire_field{ std::string(script_.value_size, 'x') });
+        for (std::size_t r = 0; r < script_.rows; ++r) {
+            data_rows_.data_row(values);
+        }
+        select_tag_ = "SELECT " + std::to_string(script_.rows);
+    }
+
+    void
+    accept();
+};
+
+/**
+ * A client connection, answers the frontend messages in order they come
+ */
+class mock_server::impl::session
+        : public std::enable_shared_from_this< session > {
+public:
+    explicit
+    session(impl& server)
+        : server_(server), socket_{server.svc_}, timer_{server.svc_},
+          header_{}, in_{}, out_{}, tran_status_{'I'}, parse_params_{0}
+    {
+    }
+
+    stream_protocol::socket&
+    socket()
+    { return socket_; }
+
+    void
+    start()
+    {
+        read_startup();
+    }
+private:
+    void
+    read_startup()
+    {
+        auto _this = shared_from_this();
+        ASIO_NAMESPACE::async_read(socket_, ASIO_NAMESPACE::buffer(header_, 4),
+            [_this](error_code const& ec, std::size_t)
+            {
+                if (!ec)
+                    _this->read_body(0);
+            });
+    }
+    void
+    read_message()
+    {
+        auto _this = shared_from_this();
+        ASIO_NAMESPACE::async_read(socket_, ASIO_NAMESPACE::buffer(header_, 5),
+            [_this](error_code const& ec, std::size_t)
+            {
+                if (!ec)
+                    _this->read_body(_this->header_[0]);
+            });
+    }
+    void
+    read_body(char tag)
+    {
+        std::int32_t len = read_int(tag ? header_ + 1 : header_);
+        in_.resize(len - 4);
+        auto _this = shared_from_this();
+        ASIO_NAMESPACE::async_read(socket_, ASIO_NAMESPACE::buffer(in_),
+            [_this, tag](error_code const& ec, std::size_t)
+            {
+                if (!ec) {
+                    if (tag)
+                        _this->handle_message(tag);
+                    else
+                        _this->handle_startup();
+                }
+            });
+    }
+
+    void
+    handle_startup()
+    {
+        if (in_.size() >= 4 && read_int(in_.data()) == ssl_request_code) {
+            // No SSL
+            out_.bytes().push_back('N');
+            flush(false);
+            return;
+        }
+        switch (server_.script_.auth) {
+            case mock_script::cleartext:
+                out_.authentication(3);
+                break;
+            case mock_script::md5:
+                out_.authentication(5, "salt");
+                break;
+            default:
+                greet();
+                break;
+        }
+        flush();
+    }
+
+    void
+    greet()
+    {
+        out_.authentication(0)
+            .parameter_status("server_version", "9.6.0")
+            .parameter_status("server_encoding", "UTF8")
+            .parameter_status("client_encoding", "UTF8")
+            .parameter_status("integer_datetimes", "on")
+            .backend_key_data(::getpid(), 42)
+            .ready_for_query(tran_status_);
+    }
+
+    void
+    handle_message(char tag)
+    {
+        switch (tag) {
+            case 'p':   // password
+                greet();
+                flush();
+                break;
+            case 'Q':   // simple query
+                simple_query(std::string{ in_.data() });
+                flush();
+                break;
+            case 'P': { // parse
+                std::size_t name_len = std::strlen(in_.data()) + 1;
+                std::size_t expr_len = std::strlen(in_.data() + name_len) + 1;
+                char const* p = in_.data() + name_len + expr_len;
+                parse_params_ = (std::int16_t(std::uint8_t(p[0])) << 8) | std::uint8_t(p[1]);
+                out_.message(detail::parse_complete_tag);
+                read_message();
+                break;
+            }
+            case 'B':   // bind
+                out_.message(detail::bind_complete_tag);
+                read_message();
+                break;
+            case 'D': { // describe
+                if (in_[0] == 'S') {
+                    out_.parameter_description(std::vector< oids::type::oid_type >(
+                            parse_params_, oids::type::text));
+                }
+                append(server_.row_description_);
+                read_message();
+                break;
+            }
+            case 'E':   // execute
+                ++server_.queries_;
+                append(server_.data_rows_);
+                out_.command_complete(server_.select_tag_);
+                read_message();
+                break;
+            case 'C':   // close
+                out_.message(detail::close_complete_tag);
+                read_message();
+                break;
+            case 'S':   // sync
+                out_.ready_for_query(tran_status_);
+                flush();
+                break;
+            case 'H':   // flush
+                flush();
+                break;
+            case 'X':   // terminate
+                socket_.close();
+                break;
+            default:
+                read_message();
+                break;
+        }
+    }
+
+    void
+    simple_query(std::string const& query)
+    {
+        if (!query.compare(0, 5, "begin")) {
+            tran_status_ = 'T';
+            out_.command_complete("BEGIN");
+        } else if (query == "commit") {
+            tran_status_ = 'I';
+            out_.command_complete("COMMIT");
+        } else if (query == "rollback") {
+            tran_status_ = 'I';
+            out_.command_complete("ROLLBACK");
+        } else {
+            ++server_.queries_;
+            append(server_.row_description_);
+            append(server_.data_rows_);
+            out_.command_complete(server_.select_tag_);
+        }
+        out_.ready_for_query(tran_status_);
+    }
+
+    void
+    append(backend_stream const& data)
+    {
+        out_.bytes().insert(out_.bytes().end(),
+                data.bytes().begin(), data.bytes().end());
+    }
+
+    /**
+     * Send the responses collected so far after the scripted latency,
+     * then go on reading messages or the startup packet.
+     */
+    void
+    flush(bool started = true)
+    {
+        auto _this = shared_from_this();
+        if (server_.script_.latency.count() > 0) {
+            timer_.expires_from_now(server_.script_.latency);
+            timer_.async_wait(
+                [_this, started](error_code const& ec)
+                {
+                    if (!ec)
+                        _this->write(started);
+                });
+        } else {
+            write(started);
+        }
+    }
+    void
+    write(bool started)
+    {
+        auto _this = shared_from_this();
+        ASIO_NAMESPACE::async_write(socket_, ASIO_NAMESPACE::buffer(out_.bytes()),
+            [_this, started](error_code const& ec, std::size_t)
+            {
+                if (!ec) {
+                    _this->out_.bytes().clear();
+                    if (started)
+                        _this->read_message();
+                    else
+                        _this->read_startup();
+                }
+            });
+    }
+private:
+    impl&                       server_;
+    stream_protocol::socket     socket_;
+    ASIO_NAMESPACE::steady_timer timer_;
+    char                        header_[5];
+    buffer_type                 in_;
+    backend_stream              out_;
+    char                        tran_status_;
+    std::int16_t                parse_params_;
+};
+
+void
+mock_server::impl::accept()
+{
+    auto s = std::make_shared< session >(*this);
+    acceptor_.async_accept(s->socket(),
+        [this, s](error_code const& ec)
+        {
+            if (!ec) {
+                s->start();
+                accept();
+            }
+        });
+}
+
+mock_server::mock_server(mock_script const& script, thread_init init)
+    : pimpl_{ new impl{script, init} }
+{
+}
+
+mock_server::~mock_server() = default;
+
+mock_script const&
+mock_server::script() const
+{
+    return pimpl_->script_;
+}
+
+std::string const&
+mock_server::socket_path() const
+{
+    return pimpl_->path_;
+}
+
+std::string
+mock_server::connection_string(std::string const& alias) const
+{
+    return alias + "=socket://bench:secret@" + pimpl_->path_ + "[bench]";
+}
+
+std::size_t
+mock_server::queries() const
+{
+    return pimpl_->queries_;
+}
+
+}  // namespace test
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
@@ -0,0 +1,90 @@
+/*
+ * mock_server.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_BENCHMARK_MOCK_SERVER_HPP_
+#define LIB_PG_ASYNC_BENCHMARK_MOCK_SERVER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace test {
+
+/**
+ * Responses of the mock backend.
+ *
+ * Every query that is not a transaction command is answered with the same
+ * resultset of text columns, via simple or extended query protocol.
+ */
+struct mock_script {
+    enum auth_type {
+        trust,
+        cleartext,
+        md5
+    };
+    /** Authentication requested at startup, the password is not checked */
+    auth_type                   auth        = trust;
+    std::size_t                 columns     = 1;
+    std::size_t                 rows        = 10;
+    /** Size of a column value in bytes */
+    std::size_t                 value_size  = 8;
+    /** Delay before sending a response */
+    std::chrono::microseconds   latency     = std::chrono::microseconds{0};
+};
+
+/**
+ * In-process PostgreSQL backend speaking protocol v3 over a UNIX socket.
+ * Runs in a thread of its own until destroyed.
+ *
+ * @code
+ * mock_server server{ mock_script{} };
+ * db_service::add_connection(server.connection_string("main"));
+ * @endcode
+ */
+class mock_server {
+public:
+    /** Called in the server thread before it starts serving */
+    using thread_init = std::function< void() >;
+public:
+    explicit
+    mock_server(mock_script const& script, thread_init init = thread_init{});
+    ~mock_server();
+
+    mock_server(mock_server const&) = delete;
+    mock_server&
+    operator = (mock_server const&) = delete;
+
+    mock_script const&
+    script() const;
+
+    std::string const&
+    socket_path() const;
+    /**
+     * Connection string for tip::db::pg::db_service::add_connection
+     */
+    std::string
+    connection_string(std::string const& alias) const;
+
+    /** Number of queries answered since start */
+    std::size_t
+    queries() const;
+private:
+    struct impl;
+    std::unique_ptr< impl > pimpl_;
+};
+
+}  // namespace test
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+#endif /* LIB_PG_ASYNC_BENCHMARK_MOCK_SERVER_HPP_ */
@@ -539,6 +539,35 @@
  * 	concurrently.
  */
 
+/**
+ *	@page coroutines Coroutines
+ *
+ *	When compiled with C++20 coroutine support, tip/db/pg/coroutine.hpp
+ *	provides awaitable versions of the asynchronous functions. A coroutine
+ *	is resumed in the io thread that runs the callback, no promise or
+ *	future is created.
+ *
+ *	* tip::db::pg::async_begin - start a transaction
+ *	* tip::db::pg::async_run, or co_await on a tip::db::pg::query - run
+ *		a query and get the complete resultset of the first statement
+ *	* tip::db::pg::async_commit, tip::db::pg::async_rollback - finish the
+ *		transaction
+ *
+ *	Errors are thrown from the co_await expression. Committing a transaction
+ *	that is rolled back after an error throws, rolling it back succeeds.
+ *
+ *	@code
+ *	task
+ *	count_types()
+ *	{
+ *		using namespace tip::db::pg;
+ *		transaction_ptr tran = co_await async_begin("main"_db);
+ *		resultset res = co_await query(tran, "select * from pg_catalog.pg_type");
+ *		co_await async_commit(tran);
+ *	}
+ *	@endcode
+ */
+
 /**
  *	@page valueio Values input/output
  *
@@ -594,6 +623,12 @@
  *		field reader implementation that uses the binary parser.
  *	* Call tip::db::pg::io::traits::register_binary_parser for pg_async runtime
  *		to request fields with the type oid in binary format.
+ *	* If the parser can read more than the type oid the type is mapped to,
+ *		specialize tip::db::pg::io::traits::binary_compatible.
+ *
+ *	When a field in binary format is read into a type that cannot parse it
+ *	(e.g. a float8 field is read into a std::string), the field is converted
+ *	to the PostgreSQL text representation and read by the text parser.
  *
  *	@code
  *	// Example specialization of a parser for boolean type
@@ -753,7 +788,9 @@
 #include <tip/db/pg/database.hpp>
 #include <tip/db/pg/transaction.hpp>
 #include <tip/db/pg/query.hpp>
+#include <tip/db/pg/prepared_query.hpp>
 #include <tip/db/pg/resultset.hpp>
 #include <tip/db/pg/error.hpp>
+#include <tip/db/pg/coroutine.hpp>
 
 #endif /* TIP_DB_PG_HPP_ */
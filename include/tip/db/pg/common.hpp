@@ -17,8 +17,8 @@
  *    smallint            | tip::db::pg::smallint
  *    integer                | tip::db::pg::integer
  *    bigint                | tip::db::pg::bigint
- *    decimal                | @todo decide MPFR or GMP - ?
- *    numeric                | @todo decide MPFR or GMP - ?
+ *    decimal                | std::string, double (read only)
+ *    numeric                | std::string, double (read only)
  *  real                | float
  *  double precision    | double
  *  smallserial            | tip::db::pg::smallint
@@ -51,12 +51,14 @@
  *  [Boost.DateTime library](http://www.boost.org/doc/libs/1_58_0/doc/html/date_time.html)
  *    PostgreSQL            | C++
  *    ------------------- | -------------------
- *  timestamp            |
- *  timestamptz            |
- *  date                |
- *  time                |
- *  time with tz        |
- *  interval            |
+ *  timestamp            | boost::posix_time::ptime
+ *  timestamptz            | boost::posix_time::ptime (read only)
+ *  timestamptz            | std::chrono::system_clock::time_point
+ *  date                | boost::gregorian::date
+ *  time                | boost::posix_time::time_duration (read only)
+ *  time with tz        | boost::posix_time::time_duration (read only, zone is skipped)
+ *  interval            | boost::posix_time::time_duration
+ *  interval            | std::chrono::duration
  *
  *
  *    ### Boolean type
@@ -76,9 +78,10 @@
  *
  *    PostgreSQL            | C++
  *    ------------------- | -------------------
- *    cidr                |
+ *    cidr                | boost::asio::ip::address (read only)
  *    inet                | boost::asio::ip::address
- *    macaddr                |
+ *    macaddr                | tip::db::pg::bytea (read only, 6 bytes)
+ *    macaddr                | std::string
  *
  *  ### Bit String types
  *  [PostgreSQL documentation](http://www.postgresql.org/docs/9.4/static/datatype-bit.html)
@@ -107,12 +110,18 @@
  *    PostgreSQL            | C++
  *    ------------------- | -------------------
  *    json                | std::string
+ *    jsonb                | std::string
  *
  *    ### Arrays
  *    [PostgreSQL documentation](http://www.postgresql.org/docs/9.4/static/arrays.html)
  *    PostgreSQL            | C++
  *    ------------------- | -------------------
  *    type array(n)        | std::vector< type mapping >
+ *    type array(n)        | std::array< type mapping, n >
+ *    type array(n)(m)     | std::vector< std::vector< type mapping > >
+ *
+ *    Arrays of types having a binary format are sent and received in binary
+ *    format, elements that can be NULL should be boost::optional.
  *
  *    ### Composite types
  *    [PostgreSQL documentation](http://www.postgresql.org/docs/9.4/static/rowtypes.html)
@@ -368,6 +377,7 @@ using row_description_type = std::vector< field_description >;
 class resultset;
 class transaction;
 class basic_connection;
+struct prepared_statement;
 namespace error {
 class db_error;
 class connection_error;
@@ -378,12 +388,31 @@ class query_error;
 /** @name Pointer types */
 using transaction_ptr = std::shared_ptr<transaction>;
 using connection_ptr = std::shared_ptr<basic_connection>;
+using prepared_statement_ptr = std::shared_ptr<prepared_statement const>;
+/** Encoded query parameters, shared by a query and its runs */
+using params_buffer_ptr = std::shared_ptr<std::vector<byte> const>;
 //@}
 
 /** @brief  */
 using client_options_type = std::map< std::string, std::string >;
 using type_oid_sequence = std::vector< oids::type::oid_type >;
 
+/**
+ * @brief SQL expression and parameter types of a prepared statement.
+ *
+ * Immutable, shared by all runs of a prepared query.
+ */
+struct prepared_statement {
+    std::string         expression;
+    type_oid_sequence   param_types;
+    /** Name of the statement on the server, derived from the expression
+     * and parameter types */
+    std::string         name;
+
+    prepared_statement(std::string const& expression,
+            type_oid_sequence param_types);
+};
+
 using simple_callback = std::function< void () >;
 /** @brief Callback for error handling */
 using error_callback = std::function< void (error::db_error const&) >;
@@ -0,0 +1,268 @@
+/**
+ * @file tip/db/pg/coroutine.hpp
+ *
+ *    @date Oct 19, 2026
+ *  @author zmij
+ */
+
+#ifndef LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_COROUTINE_HPP_
+#define LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_COROUTINE_HPP_
+
+#if defined(__cpp_impl_coroutine)
+
+#include <tip/db/pg/common.hpp>
+#include <tip/db/pg/database.hpp>
+#include <tip/db/pg/transaction.hpp>
+#include <tip/db/pg/query.hpp>
+#include <tip/db/pg/resultset.hpp>
+#include <tip/db/pg/error.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace tip {
+namespace db {
+namespace pg {
+
+namespace detail {
+
+/**
+ * State of a single asynchronous operation shared by the awaiter and the
+ * operation callbacks.
+ *
+ * Only the first callback resumes the coroutine, callbacks fired after it
+ * are ignored. The callbacks own the state, so a late callback never
+ * touches the coroutine frame after it is gone.
+ */
+template < typename T >
+struct operation_state {
+    ::std::atomic< bool >       fired{ false };
+    ::std::coroutine_handle<>   handle = nullptr;
+    T                           value  = T{};
+    ::std::exception_ptr        error  = nullptr;
+
+    void
+    set_value(T v)
+    {
+        if (!fired.exchange(true)) {
+            value = ::std::move(v);
+            handle.resume();
+        }
+    }
+    void
+    set_error(error::db_error const& e)
+    {
+        if (!fired.exchange(true)) {
+            error = ::std::make_exception_ptr(e);
+            handle.resume();
+        }
+    }
+};
+
+template <>
+struct operation_state< void > {
+    ::std::atomic< bool >       fired{ false };
+    ::std::coroutine_handle<>   handle = nullptr;
+    ::std::exception_ptr        error  = nullptr;
+
+    void
+    set_value()
+    {
+        if (!fired.exchange(true)) {
+            handle.resume();
+        }
+    }
+    void
+    set_error(error::db_error const& e)
+    {
+        if (!fired.exchange(true)) {
+            error = ::std::make_exception_ptr(e);
+            handle.resume();
+        }
+    }
+};
+
+/**
+ * Base for awaiters of a single asynchronous operation.
+ *
+ * The coroutine is resumed in the thread that calls the operation
+ * callbacks. The only allocation besides the coroutine frame is the
+ * state block shared with the callbacks.
+ */
+template < typename T >
+class operation_awaiter {
+public:
+    using state_type    = operation_state< T >;
+    using state_ptr     = ::std::shared_ptr< state_type >;
+
+    bool
+    await_ready() const noexcept
+    { return false; }
+
+    T
+    await_resume()
+    {
+        if (state_->error)
+            ::std::rethrow_exception(state_->error);
+        if constexpr (!::std::is_void< T >::value)
+            return ::std::move(state_->value);
+    }
+protected:
+    /**
+     * Create the state for the suspended coroutine, the operation
+     * callbacks must hold a copy of the returned pointer.
+     */
+    state_ptr
+    suspend(::std::coroutine_handle<> h)
+    {
+        state_ = ::std::make_shared< state_type >();
+        state_->handle = h;
+        return state_;
+    }
+
+    state_ptr   state_;
+};
+
+/**
+ * Awaiter for tip::db::pg::db_service::begin
+ */
+class begin_awaiter : public operation_awaiter< transaction_ptr > {
+public:
+    begin_awaiter(dbalias const& alias, transaction_mode const& mode)
+        : alias_{alias}, mode_{mode} {}
+
+    void
+    await_suspend(::std::coroutine_handle<> h)
+    {
+        auto state = suspend(h);
+        db_service::begin(alias_,
+            [state](transaction_ptr tran) { state->set_value(::std::move(tran)); },
+            [state](error::db_error const& e) { state->set_error(e); },
+            mode_);
+    }
+private:
+    dbalias             alias_;
+    transaction_mode    mode_;
+};
+
+/**
+ * Awaiter for tip::db::pg::query::run_async, resumes the coroutine when
+ * the result of the first statement is complete. Results of further
+ * statements of the query and errors after it are dropped.
+ */
+class query_awaiter : public operation_awaiter< resultset > {
+public:
+    explicit
+    query_awaiter(query const& q)
+        : query_{q} {}
+
+    void
+    await_suspend(::std::coroutine_handle<> h)
+    {
+        auto state = suspend(h);
+        query_.run_async(
+            [state](transaction_ptr, resultset res, bool complete)
+            {
+                if (complete)
+                    state->set_value(::std::move(res));
+            },
+            [state](error::db_error const& e) { state->set_error(e); });
+    }
+private:
+    query   query_;
+};
+
+/**
+ * Awaiter for transaction commit or rollback
+ */
+class transaction_awaiter : public operation_awaiter< void > {
+public:
+    using operation = void (transaction::*)(
+            transaction::notification_callback, error_callback);
+
+    transaction_awaiter(transaction_ptr tran, operation op)
+        : tran_{::std::move(tran)}, op_{op} {}
+
+    void
+    await_suspend(::std::coroutine_handle<> h)
+    {
+        auto state = suspend(h);
+        ((*tran_).*op_)(
+            [state]() { state->set_value(); },
+            [state](error::db_error const& e) { state->set_error(e); });
+    }
+private:
+    transaction_ptr tran_;
+    operation       op_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Start a transaction in a coroutine.
+ *
+ * @code
+ * transaction_ptr tran = co_await async_begin("main"_db);
+ * @endcode
+ * @param alias Database connection alias
+ * @param mode Transaction mode
+ * @throws tip::db::pg::error::connection_error if the alias is not
+ *         registered or the transaction cannot start.
+ */
+inline detail::begin_awaiter
+async_begin(dbalias const& alias, transaction_mode const& mode = transaction_mode{})
+{
+    return detail::begin_awaiter{ alias, mode };
+}
+
+/**
+ * @brief Run a query in a coroutine, the result is returned when complete.
+ *
+ * @code
+ * resultset res = co_await async_run(query(tran, "select * from pg_catalog.pg_type"));
+ * @endcode
+ */
+inline detail::query_awaiter
+async_run(query const& q)
+{
+    return detail::query_awaiter{ q };
+}
+
+/**
+ * Shortcut for @ref tip::db::pg::async_run
+ */
+inline detail::query_awaiter
+operator co_await(query const& q)
+{
+    return detail::query_awaiter{ q };
+}
+
+/**
+ * @brief Commit a transaction in a coroutine
+ */
+inline detail::transaction_awaiter
+async_commit(transaction_ptr tran)
+{
+    return detail::transaction_awaiter{ ::std::move(tran), &transaction::commit_async };
+}
+
+/**
+ * @brief Rollback a transaction in a coroutine
+ */
+inline detail::transaction_awaiter
+async_rollback(transaction_ptr tran)
+{
+    return detail::transaction_awaiter{ ::std::move(tran), &transaction::rollback_async };
+}
+
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_COROUTINE_HPP_ */
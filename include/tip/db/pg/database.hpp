@@ -19,6 +19,7 @@
 #include <tip/db/pg/future_config.hpp>
 #include <tip/db/pg/common.hpp>
 #include <tip/db/pg/error.hpp>
+#include <tip/db/pg/detail/fiber_wait.hpp>
 
 
 namespace tip {
@@ -150,6 +151,38 @@ public:
         return future.get();
     }
 
+#ifdef WITH_BOOST_FIBERS
+    /**
+     * Start a transaction suspending the calling fiber until a connection
+     * is checked out from the pool and the transaction is started.
+     * The io threads are not blocked and no promise is allocated.
+     *
+     * @code
+     * auto tran = db_service::begin("main"_db, fiber_yield{});
+     * @endcode
+     * @throws tip::db::pg::error::db_error
+     */
+    static transaction_ptr
+    begin(dbalias const& alias, fiber_yield const& yield,
+            transaction_mode const& mode = transaction_mode{})
+    {
+        detail::fiber_wait< transaction_ptr > waiter{ yield };
+        auto w = waiter.handle();
+        begin(
+            alias,
+            [w](transaction_ptr trx)
+            {
+                w.set_value(trx);
+            },
+            [w](error::db_error const& e)
+            {
+                w.set_error(e);
+            }, mode
+        );
+        return waiter.get();
+    }
+#endif
+
     static void
     run();
     static void
@@ -55,6 +55,16 @@ template < >
 struct pgcpp_data_mapping < oids::type::xid > : detail::data_mapping_base< oids::type::xid, integer > {};
 template < >
 struct pgcpp_data_mapping < oids::type::cid > : detail::data_mapping_base< oids::type::cid, integer > {};
+
+template < >
+struct binary_compatible< integer > {
+    static bool
+    accepts( oids::type::oid_type id )
+    {
+        return id == oids::type::int4 || id == oids::type::oid
+                || id == oids::type::xid || id == oids::type::cid;
+    }
+};
 //@}
 
 //@{
@@ -0,0 +1,180 @@
+/*
+ * fiber_wait.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_DETAIL_FIBER_WAIT_HPP_
+#define LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_DETAIL_FIBER_WAIT_HPP_
+
+#ifdef WITH_BOOST_FIBERS
+
+#include <tip/db/pg/future_config.hpp>
+#include <tip/db/pg/error.hpp>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace detail {
+
+/**
+ * Handle to a fiber_wait for the operation callbacks.
+ *
+ * Copies of a handle share a one-shot flag, only the first call reaches
+ * the waiter. Later calls are ignored, as the waiter is gone from the
+ * fiber stack after the fiber goes on.
+ */
+template < typename Waiter >
+class fiber_wait_handle {
+public:
+	explicit
+	fiber_wait_handle(Waiter& w)
+		: state_{ ::std::make_shared< state >(w) } {}
+
+	template < typename ... Args >
+	void
+	set_value(Args&& ... args) const
+	{
+		if (!state_->fired.exchange(true))
+			state_->waiter.set_value(::std::forward<Args>(args)...);
+	}
+	void
+	set_error(error::db_error const& e) const
+	{
+		if (!state_->fired.exchange(true))
+			state_->waiter.set_error(e);
+	}
+private:
+	struct state {
+		explicit
+		state(Waiter& w) : waiter(w) {}
+
+		::std::atomic< bool >	fired{ false };
+		Waiter&					waiter;
+	};
+	::std::shared_ptr< state >	state_;
+};
+
+/**
+ * Suspends the current fiber until an asynchronous operation calls back.
+ *
+ * Lives on the stack of the waiting fiber, the operation callbacks hold
+ * a @ref fiber_wait_handle to it, a small shared block is the only
+ * allocation. The fiber is resumed via asio-fiber's yield handler, the
+ * thread that calls back is not blocked.
+ */
+template < typename T >
+class fiber_wait {
+public:
+	using handler_type	= ::psst::asio::fiber::detail::yield_handler< T >;
+	using result_type	= ::psst::asio::fiber::detail::async_result_value< T >;
+	using handle_type	= fiber_wait_handle< fiber_wait >;
+public:
+	explicit
+	fiber_wait(fiber_yield const& y)
+		: handler_{y}, result_{handler_} {}
+
+	fiber_wait(fiber_wait const&) = delete;
+	fiber_wait&
+	operator = (fiber_wait const&) = delete;
+
+	/**
+	 * Handle for the operation callbacks
+	 */
+	handle_type
+	handle()
+	{
+		return handle_type{ *this };
+	}
+
+	void
+	set_value(T v)
+	{
+		handler_(::std::move(v));
+	}
+	void
+	set_error(error::db_error const& e)
+	{
+		error_ = ::std::make_exception_ptr(e);
+		handler_.yield_handler_base::operator()(error_code{});
+	}
+
+	T
+	get()
+	{
+		T v = result_.get();
+		if (error_)
+			::std::rethrow_exception(error_);
+		return v;
+	}
+private:
+	using error_code = ::psst::asio::error_code;
+
+	handler_type			handler_;
+	result_type				result_;
+	::std::exception_ptr	error_ = nullptr;
+};
+
+template <>
+class fiber_wait< void > {
+public:
+	using handler_type	= ::psst::asio::fiber::detail::yield_handler< void >;
+	using result_type	= ::psst::asio::fiber::detail::async_result_value< void >;
+	using handle_type	= fiber_wait_handle< fiber_wait >;
+public:
+	explicit
+	fiber_wait(fiber_yield const& y)
+		: handler_{y}, result_{handler_} {}
+
+	fiber_wait(fiber_wait const&) = delete;
+	fiber_wait&
+	operator = (fiber_wait const&) = delete;
+
+	/**
+	 * Handle for the operation callbacks
+	 */
+	handle_type
+	handle()
+	{
+		return handle_type{ *this };
+	}
+
+	void
+	set_value()
+	{
+		handler_();
+	}
+	void
+	set_error(error::db_error const& e)
+	{
+		error_ = ::std::make_exception_ptr(e);
+		handler_();
+	}
+
+	void
+	get()
+	{
+		result_.get();
+		if (error_)
+			::std::rethrow_exception(error_);
+	}
+private:
+	handler_type			handler_;
+	result_type				result_;
+	::std::exception_ptr	error_ = nullptr;
+};
+
+} /* namespace detail */
+} /* namespace pg */
+} /* namespace db */
+} /* namespace tip */
+
+#endif /* WITH_BOOST_FIBERS */
+
+#endif /* LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_DETAIL_FIBER_WAIT_HPP_ */
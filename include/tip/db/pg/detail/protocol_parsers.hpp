@@ -11,6 +11,8 @@
 #include <boost/logic/tribool.hpp>
 #include <algorithm>
 #include <cctype>
+#include <cstddef>
+#include <vector>
 
 namespace tip {
 namespace db {
@@ -77,7 +79,7 @@ private:
 				}
 			case nibble_two:
 				if (std::isxdigit(input)) {
-					*data++ = (hex_to_byte(input) << 4) | most_sighificant_nibble_;
+					*data++ = (most_sighificant_nibble_ << 4) | hex_to_byte(input);
 					state_ = nibble_one;
 					return true;
 				} else {
@@ -93,6 +95,58 @@ private:
 	hex_to_byte(char);
 };
 
+/**
+ * @brief Decode a string of hex digits.
+ *
+ * Uses SSE2 (or AVX2 when the library is compiled with AVX2 enabled) to
+ * decode 16 (32) bytes at a time, the rest is decoded with a lookup table.
+ * @param hex pointer to hex digits
+ * @param size number of hex digits, must be even
+ * @param out output buffer, must have room for size / 2 bytes
+ * @return false if size is odd or the input contains a non-hex character
+ */
+bool
+hex_decode(char const* hex, std::size_t size, char* out);
+
+/**
+ * @brief Decode bytea value in hex format (\x followed by hex digits)
+ * @param data pointer to the field data
+ * @param size size of the field data
+ * @param out output buffer, is resized to fit the decoded data
+ * @return false if the data is not a valid hex format bytea
+ */
+bool
+decode_bytea_hex(char const* data, std::size_t size, std::vector<char>& out);
+
+/**
+ * @brief Convert a null-terminated string to a floating point value.
+ *
+ * Works like strtof/strtod/strtold, but always in the "C" locale, the
+ * decimal point doesn't depend on the locale set by setlocale.
+ * @param str null-terminated string
+ * @param end receives pointer past the last character converted
+ */
+float
+string_to_floating(char const* str, char** end, float);
+double
+string_to_floating(char const* str, char** end, double);
+long double
+string_to_floating(char const* str, char** end, long double);
+
+/**
+ * @brief Convert an array of fixed size values from network (big endian)
+ * to native byte order in place.
+ *
+ * On x86 uses AVX2 or SSSE3 byte shuffles when the CPU supports them (checked
+ * at run time), SSE2 shifts otherwise. The rest is swapped one value at
+ * a time.
+ * @param data pointer to the values
+ * @param count number of values
+ * @param width size of a single value, 2, 4 or 8 bytes
+ */
+void
+big_to_native(char* data, std::size_t count, std::size_t width);
+
 }  // namespace detail
 }  // namespace io
 }  // namespace pg
@@ -11,6 +11,7 @@
 #ifdef WITH_BOOST_FIBERS
 #include <boost/fiber/future.hpp>
 #include <boost/fiber/fiber.hpp>
+#include <pushkin/asio/fiber/yield.hpp>
 #else
 #include <future>
 #endif
@@ -23,6 +24,11 @@ namespace pg {
 template < typename _Res >
 using promise = ::boost::fibers::promise< _Res >;
 using fiber = ::boost::fibers::fiber;
+/**
+ * Completion token for suspending the calling fiber until an operation
+ * finishes, without allocating a promise.
+ */
+using fiber_yield = ::psst::asio::fiber::yield_t;
 #else
 template < typename _Res >
 using promise = ::std::promise< _Res >;
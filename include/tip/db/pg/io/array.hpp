@@ -60,6 +60,24 @@ struct protocol_parser< std::array< T, Sz >, TEXT_DATA_FORMAT > :
 	}
 };
 
+template < typename T, std::size_t Sz >
+struct protocol_formatter< std::array< T, Sz >, BINARY_DATA_FORMAT > :
+		detail::binary_container_formatter< std::array< T, Sz > > {
+	typedef detail::binary_container_formatter< std::array< T, Sz > > base_type;
+	typedef typename base_type::value_type value_type;
+
+	protocol_formatter(value_type const& v) : base_type(v) {}
+};
+
+template < typename T, std::size_t Sz >
+struct protocol_parser< std::array< T, Sz >, BINARY_DATA_FORMAT > :
+		detail::binary_container_parser< std::array< T, Sz > > {
+	typedef detail::binary_container_parser< std::array< T, Sz > > base_type;
+	typedef typename base_type::value_type value_type;
+
+	protocol_parser(value_type& v) : base_type(v) {}
+};
+
 namespace traits {
 
 template < typename T, std::size_t Sz >
@@ -67,9 +85,31 @@ struct has_formatter< std::array< T, Sz >, TEXT_DATA_FORMAT > : std::true_type {
 template < typename T, std::size_t Sz >
 struct has_parser< std::array< T, Sz >, TEXT_DATA_FORMAT > : std::true_type {};
 
+template < typename T, std::size_t Sz >
+struct has_formatter< std::array< T, Sz >, BINARY_DATA_FORMAT > :
+	std::integral_constant< bool,
+		detail::binary_array_traits< std::array< T, Sz > >::has_formatter > {};
+template < typename T, std::size_t Sz >
+struct has_parser< std::array< T, Sz >, BINARY_DATA_FORMAT > :
+	std::integral_constant< bool,
+		detail::binary_array_traits< std::array< T, Sz > >::has_parser > {};
+
 template < typename T, std::size_t Sz  >
 struct cpppg_data_mapping< std::array< T, Sz > > :
-	detail::data_mapping_base < oids::type::text, std::array< T, Sz > > {};
+	detail::data_mapping_base <
+		(detail::binary_array_traits< std::array< T, Sz > >::has_formatter ?
+			detail::binary_array_traits< std::array< T, Sz > >::array_oid :
+			oids::type::text),
+		std::array< T, Sz > > {};
+
+template < typename T, std::size_t Sz >
+struct binary_compatible< std::array< T, Sz > > {
+	static bool
+	accepts(oids::type::oid_type id)
+	{
+		return id == detail::binary_array_traits< std::array< T, Sz > >::array_oid;
+	}
+};
 
 }  // namespace traits
 
@@ -11,104 +11,181 @@
 #include <tip/db/pg/protocol_io_traits.hpp>
 #include <tip/util/endian.hpp>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsign-compare"
-#include <boost/spirit/include/qi.hpp>
-#include <boost/spirit/include/karma.hpp>
-#include <boost/spirit/include/phoenix.hpp>
 #include <boost/date_time.hpp>
 
-#pragma GCC diagnostic pop
-
 namespace tip {
 namespace db {
 namespace pg {
 namespace io {
 
-namespace grammar {
-namespace parse {
-
-template < typename InputIterator >
-struct time_grammar :
-        boost::spirit::qi::grammar< InputIterator, boost::posix_time::time_duration()> {
-    typedef boost::posix_time::time_duration value_type;
-    time_grammar() : time_grammar::base_type(time)
-    {
-        namespace qi = boost::spirit::qi;
-        namespace phx = boost::phoenix;
-        using qi::_pass;
-        using qi::_val;
-        using qi::_1;
-        using qi::_2;
-        using qi::_3;
-        using qi::_4;
-        _2digits = qi::uint_parser< std::uint32_t, 10, 2, 2 >();
-        fractional_part = -('.' >> qi::long_);
-
-        time = (_2digits >> ':' >> _2digits >> ':' >> _2digits >> fractional_part )
-            [ _pass = (_1 < 24) && (_2 < 60) && (_3 < 60),
-              _val = phx::construct< value_type >(_1, _2, _3, _4)];
-    }
-    boost::spirit::qi::rule< InputIterator, value_type()> time;
-    boost::spirit::qi::rule< InputIterator, std::uint32_t() > _2digits;
-    boost::spirit::qi::rule< InputIterator, std::uint64_t() > fractional_part;
-};
+namespace detail {
 
-template < typename InputIterator >
-struct date_grammar :
-        boost::spirit::qi::grammar< InputIterator, boost::gregorian::date()> {
-    typedef boost::gregorian::date value_type;
-    date_grammar() : date_grammar::base_type(date)
-    {
-        namespace qi = boost::spirit::qi;
-        namespace phx = boost::phoenix;
-        using qi::_pass;
-        using qi::_val;
-        using qi::_1;
-        using qi::_2;
-        using qi::_3;
-        _2digits = qi::uint_parser< std::uint32_t, 10, 2, 2 >();
-        _4digits = qi::uint_parser< std::uint32_t, 10, 4, 4 >();
-        date = (_4digits >> "-" >> _2digits >> "-" >> _2digits)
-            [
-                  _pass = (1400 <= _1) && (_1 <= 10000) && (_3 < 32),
-                 phx::try_[
-                    _val = phx::construct< value_type > (_1, _2, _3)
-                ].catch_all[
-                    _pass = false
-                ]
-            ];
-    }
-    boost::spirit::qi::rule< InputIterator, value_type()> date;
-    boost::spirit::qi::rule< InputIterator, std::int32_t() > _2digits;
-    boost::spirit::qi::rule< InputIterator, std::int32_t() > _4digits;
-};
+/**
+ * @brief Parser for date and time values in PostgreSQL ISO output layout
+ *
+ * Parses YYYY-MM-DD dates, HH:MM:SS[.ffffff] times and timestamps composed
+ * of them, with an optional timezone offset [+-]HH[:MM[:SS]] for timestamptz.
+ * Digits are decoded at fixed offsets, fields are validated without
+ * throwing exceptions.
+ */
+struct iso_datetime_parser {
+    template < typename InputIterator >
+    static bool
+    parse_digits(InputIterator& p, InputIterator end, int n, int& val)
+    {
+        if (end - p < n)
+            return false;
+        int v{0};
+        for (InputIterator e = p + n; p != e; ++p) {
+            unsigned d = static_cast< unsigned char >(*p) - '0';
+            if (d > 9)
+                return false;
+            v = v * 10 + d;
+        }
+        val = v;
+        return true;
+    }
+
+    template < typename InputIterator >
+    static bool
+    expect(InputIterator& p, InputIterator end, char c)
+    {
+        if (p == end || *p != c)
+            return false;
+        ++p;
+        return true;
+    }
+
+    template < typename InputIterator >
+    static bool
+    parse_literal(InputIterator& p, InputIterator end, char const* literal)
+    {
+        InputIterator c = p;
+        for (; *literal; ++literal, ++c) {
+            if (c == end || *c != *literal)
+                return false;
+        }
+        p = c;
+        return true;
+    }
+
+    template < typename InputIterator >
+    static bool
+    parse_date(InputIterator& p, InputIterator end, boost::gregorian::date& val)
+    {
+        typedef boost::gregorian::gregorian_calendar calendar;
+        InputIterator c = p;
+        int year{0}, month{0}, day{0};
+        if (!parse_digits(c, end, 4, year) || !expect(c, end, '-')
+                || !parse_digits(c, end, 2, month) || !expect(c, end, '-')
+                || !parse_digits(c, end, 2, day))
+            return false;
+        if (year < 1400 || month < 1 || month > 12 || day < 1
+                || day > calendar::end_of_month_day(year, month))
+            return false;
+        val = boost::gregorian::date(year, month, day);
+        p = c;
+        return true;
+    }
+
+    template < typename InputIterator >
+    static bool
+    parse_time(InputIterator& p, InputIterator end,
+            boost::posix_time::time_duration& val)
+    {
+        InputIterator c = p;
+        int hours{0}, minutes{0}, seconds{0};
+        if (!parse_digits(c, end, 2, hours) || !expect(c, end, ':')
+                || !parse_digits(c, end, 2, minutes) || !expect(c, end, ':')
+                || !parse_digits(c, end, 2, seconds))
+            return false;
+        if (hours > 23 || minutes > 59 || seconds > 59)
+            return false;
+        std::int64_t usecs{0};
+        if (c != end && *c == '.') {
+            ++c;
+            InputIterator digits = c;
+            int scale{100000};
+            for (; c != end && '0' <= *c && *c <= '9'; ++c) {
+                usecs += (*c - '0') * scale; // Extra digits are truncated
+                scale /= 10;
+            }
+            if (c == digits)
+                return false;
+        }
+        val = boost::posix_time::time_duration(hours, minutes, seconds, 0)
+                + boost::posix_time::microseconds(usecs);
+        p = c;
+        return true;
+    }
 
-template < typename InputIterator, typename DateTime >
-struct datetime_grammar;
+    template < typename InputIterator >
+    static bool
+    parse_tz_offset(InputIterator& p, InputIterator end, int& seconds)
+    {
+        if (p == end || (*p != '+' && *p != '-'))
+            return false;
+        InputIterator c = p;
+        bool negative = *c++ == '-';
+        int hours{0}, minutes{0}, secs{0};
+        if (!parse_digits(c, end, 2, hours))
+            return false;
+        InputIterator tmp = c;
+        if (expect(tmp, end, ':') && parse_digits(tmp, end, 2, minutes)) {
+            c = tmp;
+            if (expect(tmp, end, ':') && parse_digits(tmp, end, 2, secs))
+                c = tmp;
+        }
+        seconds = (hours * 60 + minutes) * 60 + secs;
+        if (negative)
+            seconds = -seconds;
+        p = c;
+        return true;
+    }
 
-template < typename InputIterator >
-struct datetime_grammar< InputIterator, boost::posix_time::ptime > :
-        boost::spirit::qi::grammar< InputIterator, boost::posix_time::ptime()> {
-    typedef boost::posix_time::ptime value_type;
-    datetime_grammar() : datetime_grammar::base_type(datetime)
+    /**
+     * Parse a timestamp. Timezone offset is skipped, the value is the
+     * timestamp as it is displayed in the session's time zone.
+     */
+    template < typename InputIterator >
+    static bool
+    parse_timestamp(InputIterator& p, InputIterator end,
+            boost::posix_time::ptime& val)
     {
-        namespace qi = boost::spirit::qi;
-        namespace phx = boost::phoenix;
-        using qi::_val;
-        using qi::_1;
-        using qi::_2;
+        int offset{0};
+        return parse_timestamp(p, end, val, offset);
+    }
 
-        datetime = (date >> ' ' >> time)
-            [ _val = phx::construct< value_type >( _1, _2) ];
+    /**
+     * Parse a timestamp, store timezone offset in seconds east of UTC
+     * to the offset parameter, 0 if there is no offset.
+     */
+    template < typename InputIterator >
+    static bool
+    parse_timestamp(InputIterator& p, InputIterator end,
+            boost::posix_time::ptime& val, int& offset)
+    {
+        if (parse_literal(p, end, "infinity")) {
+            val = boost::posix_time::ptime{ boost::posix_time::pos_infin };
+            return true;
+        } else if (parse_literal(p, end, "-infinity")) {
+            val = boost::posix_time::ptime{ boost::posix_time::neg_infin };
+            return true;
+        }
+        InputIterator c = p;
+        boost::gregorian::date d;
+        boost::posix_time::time_duration t;
+        if (!parse_date(c, end, d) || !expect(c, end, ' ') || !parse_time(c, end, t))
+            return false;
+        offset = 0;
+        parse_tz_offset(c, end, offset);
+        val = boost::posix_time::ptime(d, t);
+        p = c;
+        return true;
     }
-    boost::spirit::qi::rule< InputIterator, value_type()> datetime;
-    date_grammar< InputIterator > date;
-    time_grammar< InputIterator > time;
 };
 
-}  // namespace parse
-}  // namespace grammar
+}  // namespace detail
 
 template < >
 struct protocol_parser< boost::posix_time::ptime, TEXT_DATA_FORMAT > :
@@ -128,14 +205,7 @@ struct protocol_parser< boost::posix_time::ptime, TEXT_DATA_FORMAT > :
         typedef typename iter_traits::value_type iter_value_type;
         static_assert(std::is_same< iter_value_type, byte >::type::value,
                 "Input iterator must be over a char container");
-        namespace qi = boost::spirit::qi;
-        namespace parse = grammar::parse;
-
-        parse::datetime_grammar< InputIterator, value_type > grammar;
-        value_type tmp;
-        if (qi::parse(begin, end, grammar, tmp)) {
-            std::swap(tmp, base_type::value);
-        }
+        detail::iso_datetime_parser::parse_timestamp(begin, end, base_type::value);
         return begin;
     }
 };
@@ -191,6 +261,190 @@ struct protocol_formatter< boost::posix_time::ptime, BINARY_DATA_FORMAT> :
     operator() (std::vector<byte>& buffer);
 };
 
+template < >
+struct protocol_parser< boost::gregorian::date, TEXT_DATA_FORMAT > :
+        detail::parser_base< boost::gregorian::date > {
+    typedef detail::parser_base< boost::gregorian::date > base_type;
+    typedef typename base_type::value_type value_type;
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end)
+    {
+        typedef std::iterator_traits< InputIterator > iter_traits;
+        typedef typename iter_traits::value_type iter_value_type;
+        static_assert(std::is_same< iter_value_type, byte >::type::value,
+                "Input iterator must be over a char container");
+        detail::iso_datetime_parser::parse_date(begin, end, base_type::value);
+        return begin;
+    }
+};
+
+/**
+ * @brief Binary parser for date.
+ * Date is transferred as a number of days since 2000-01-01.
+ */
+template < >
+struct protocol_parser< boost::gregorian::date, BINARY_DATA_FORMAT > :
+        detail::parser_base< boost::gregorian::date > {
+
+    using base_type     = detail::parser_base< boost::gregorian::date >;
+    using value_type    =  base_type::value_type;
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(integer);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()( InputIterator begin, InputIterator end )
+    {
+        integer tmp{0};
+        auto res = protocol_read<BINARY_DATA_FORMAT>(begin, end, tmp);
+        if (res != begin)
+            from_int_value(tmp);
+        return res;
+    }
+
+    void
+    from_int_value(integer);
+};
+
+template < >
+struct protocol_formatter< boost::gregorian::date, BINARY_DATA_FORMAT> :
+        detail::formatter_base<boost::gregorian::date> {
+
+    using base_type     = detail::formatter_base<boost::gregorian::date>;
+    using value_type    = base_type::value_type;
+
+    protocol_formatter(value_type const& val) : base_type(val) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(integer);
+    }
+
+    bool
+    operator() (std::vector<byte>& buffer);
+};
+
+/**
+ * @brief Text parser for time_duration.
+ * Accepts PostgreSQL time and interval (postgres interval style) text
+ * representations. Intervals with years or months are rejected.
+ */
+template < >
+struct protocol_parser< boost::posix_time::time_duration, TEXT_DATA_FORMAT > :
+        detail::parser_base< boost::posix_time::time_duration > {
+    typedef detail::parser_base< boost::posix_time::time_duration > base_type;
+    typedef typename base_type::value_type value_type;
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end)
+    {
+        typedef std::iterator_traits< InputIterator > iter_traits;
+        typedef typename iter_traits::value_type iter_value_type;
+        static_assert(std::is_same< iter_value_type, byte >::type::value,
+                "Input iterator must be over a char container");
+        InputIterator c = begin;
+        value_type tmp;
+        if (detail::iso_datetime_parser::parse_time(c, end, tmp)) {
+            // Time zone of timetz is skipped
+            int offset{0};
+            detail::iso_datetime_parser::parse_tz_offset(c, end, offset);
+            if (c == end) {
+                base_type::value = tmp;
+                return end;
+            }
+        }
+        std::string literal(begin, end);
+        if (parse_interval(literal)) {
+            return end;
+        }
+        return begin;
+    }
+
+    bool
+    parse_interval(std::string const&);
+};
+
+/**
+ * @brief Binary parser for time_duration.
+ * Reads time (8 bytes of microseconds), timetz (time and 4 bytes of zone
+ * offset, the offset is skipped) and interval (microseconds, days and months)
+ * values. A day is converted to 24 hours. A month has no fixed length, an
+ * interval with a non-zero month field is rejected, read it as a string.
+ */
+template < >
+struct protocol_parser< boost::posix_time::time_duration, BINARY_DATA_FORMAT > :
+        detail::parser_base< boost::posix_time::time_duration > {
+
+    using base_type     = detail::parser_base< boost::posix_time::time_duration >;
+    using value_type    =  base_type::value_type;
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(bigint) + 2 * sizeof(integer);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()( InputIterator begin, InputIterator end )
+    {
+        bigint usecs{0};
+        integer days{0}, months{0};
+        InputIterator c = protocol_read<BINARY_DATA_FORMAT>(begin, end, usecs);
+        if (c == begin)
+            return begin;
+        if (end - c >= (decltype (end - c))(2 * sizeof(integer))) {
+            c = protocol_read<BINARY_DATA_FORMAT>(c, end, days);
+            c = protocol_read<BINARY_DATA_FORMAT>(c, end, months);
+            if (months != 0)
+                return begin;
+        } else if (end - c == (decltype (end - c))sizeof(integer)) {
+            integer zone{0};
+            c = protocol_read<BINARY_DATA_FORMAT>(c, end, zone);
+        }
+        from_int_values(usecs, days);
+        return c;
+    }
+
+    void
+    from_int_values(bigint usecs, integer days);
+};
+
+/**
+ * @brief Binary formatter for time_duration.
+ * Writes the value as an interval.
+ */
+template < >
+struct protocol_formatter< boost::posix_time::time_duration, BINARY_DATA_FORMAT> :
+        detail::formatter_base<boost::posix_time::time_duration> {
+
+    using base_type     = detail::formatter_base<boost::posix_time::time_duration>;
+    using value_type    = base_type::value_type;
+
+    protocol_formatter(value_type const& val) : base_type(val) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(bigint) + 2 * sizeof(integer);
+    }
+
+    bool
+    operator() (std::vector<byte>& buffer);
+};
+
 namespace traits {
 
 template <>
@@ -203,6 +457,9 @@ template < >
 struct pgcpp_data_mapping< oids::type::timestamp > :
         detail::data_mapping_base< oids::type::timestamp, boost::posix_time::ptime > {};
 template < >
+struct pgcpp_data_mapping< oids::type::timestamptz > :
+        detail::data_mapping_base< oids::type::timestamptz, boost::posix_time::ptime > {};
+template < >
 struct cpppg_data_mapping< boost::posix_time::ptime > :
         detail::data_mapping_base< oids::type::timestamp, boost::posix_time::ptime > {};
 
@@ -225,6 +482,102 @@ struct nullable_traits< boost::posix_time::ptime > {
 
 template <>
 struct needs_quotes< boost::posix_time::ptime > : ::std::true_type {};
+
+template <>
+struct binary_compatible< boost::posix_time::ptime > {
+    static bool
+    accepts( oids::type::oid_type id )
+    {
+        return id == oids::type::timestamp || id == oids::type::timestamptz;
+    }
+};
+//@}
+
+//@{
+/** @name boost::gregorian::date traits */
+template <>
+struct has_parser < boost::gregorian::date, TEXT_DATA_FORMAT > : std::true_type {};
+template <>
+struct has_parser < boost::gregorian::date, BINARY_DATA_FORMAT > : std::true_type {};
+template <>
+struct has_formatter < boost::gregorian::date, BINARY_DATA_FORMAT > : std::true_type {};
+
+template < >
+struct pgcpp_data_mapping< oids::type::date > :
+        detail::data_mapping_base< oids::type::date, boost::gregorian::date > {};
+template < >
+struct cpppg_data_mapping< boost::gregorian::date > :
+        detail::data_mapping_base< oids::type::date, boost::gregorian::date > {};
+
+template <>
+struct is_nullable< boost::gregorian::date > : ::std::true_type {};
+
+template <>
+struct nullable_traits< boost::gregorian::date > {
+    inline static bool
+    is_null(boost::gregorian::date const& val)
+    {
+        return val.is_not_a_date();
+    }
+    inline static void
+    set_null(boost::gregorian::date& val)
+    {
+        val = boost::gregorian::date{};
+    }
+};
+//@}
+
+//@{
+/** @name boost::posix_time::time_duration traits */
+template <>
+struct has_parser < boost::posix_time::time_duration, TEXT_DATA_FORMAT > : std::true_type {};
+template <>
+struct has_parser < boost::posix_time::time_duration, BINARY_DATA_FORMAT > : std::true_type {};
+template <>
+struct has_formatter < boost::posix_time::time_duration, BINARY_DATA_FORMAT > : std::true_type {};
+
+template < >
+struct pgcpp_data_mapping< oids::type::time > :
+        detail::data_mapping_base< oids::type::time, boost::posix_time::time_duration > {};
+template < >
+struct pgcpp_data_mapping< oids::type::timetz > :
+        detail::data_mapping_base< oids::type::timetz, boost::posix_time::time_duration > {};
+template < >
+struct pgcpp_data_mapping< oids::type::interval > :
+        detail::data_mapping_base< oids::type::interval, boost::posix_time::time_duration > {};
+template < >
+struct cpppg_data_mapping< boost::posix_time::time_duration > :
+        detail::data_mapping_base< oids::type::interval, boost::posix_time::time_duration > {};
+
+template <>
+struct binary_compatible< boost::posix_time::time_duration > {
+    static bool
+    accepts( oids::type::oid_type id )
+    {
+        return id == oids::type::time || id == oids::type::timetz
+                || id == oids::type::interval;
+    }
+};
+
+template <>
+struct is_nullable< boost::posix_time::time_duration > : ::std::true_type {};
+
+template <>
+struct nullable_traits< boost::posix_time::time_duration > {
+    inline static bool
+    is_null(boost::posix_time::time_duration const& val)
+    {
+        return val.is_not_a_date_time();
+    }
+    inline static void
+    set_null(boost::posix_time::time_duration& val)
+    {
+        val = boost::posix_time::time_duration{ boost::posix_time::not_a_date_time };
+    }
+};
+
+template <>
+struct needs_quotes< boost::posix_time::time_duration > : ::std::true_type {};
 //@}
 
 }  // namespace traits
@@ -9,6 +9,7 @@
 #define LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_IO_BYTEA_HPP_
 
 #include <tip/db/pg/protocol_io_traits.hpp>
+#include <tip/db/pg/detail/protocol_parsers.hpp>
 
 namespace tip {
 namespace db {
@@ -104,6 +105,18 @@ struct cpppg_data_mapping < bytea > :
 		detail::data_mapping_base< oids::type::bytea, bytea > {};
 //@}
 
+/**
+ * Binary macaddr value is read as 6 raw bytes
+ */
+template <>
+struct binary_compatible< bytea > {
+	static bool
+	accepts( oids::type::oid_type id )
+	{
+		return id == oids::type::bytea || id == oids::type::macaddr;
+	}
+};
+
 static_assert(has_parser<bytea, BINARY_DATA_FORMAT>::value,
                   "Binary data parser for bool");
 static_assert(best_parser<bytea>::value == BINARY_DATA_FORMAT,
@@ -121,12 +134,9 @@ protocol_parser< bytea, TEXT_DATA_FORMAT >::operator ()
 	typedef typename iter_traits::value_type iter_value_type;
 	static_assert(std::is_same< iter_value_type, byte >::type::value,
 			"Input iterator must be over a char container");
-	std::vector<byte> data;
-
-	auto result = detail::bytea_parser().parse(begin, end, std::back_inserter(data));
-	if (result.first) {
-		base_type::value.swap(data);
-		return result.second;
+	// Field data is contiguous
+	if (begin != end && detail::decode_bytea_hex(&*begin, end - begin, base_type::value)) {
+		return end;
 	}
 	return begin;
 }
@@ -142,9 +152,7 @@ protocol_parser< bytea, BINARY_DATA_FORMAT >::operator ()
 	static_assert(std::is_same< iter_value_type, byte >::type::value,
 			"Input iterator must be over a char container");
 
-	bytea tmp(begin, end);
-	std::swap(base_type::value, tmp);
-
+	base_type::value.assign(begin, end);
 	return end;
 }
 
@@ -11,10 +11,65 @@
 #include <tip/db/pg/protocol_io_traits.hpp>
 #include <tip/db/pg/detail/array_tokenizer.hpp>
 
+#include <array>
+#include <vector>
+
 namespace tip {
 namespace db {
 namespace pg {
 namespace io {
+
+namespace traits {
+
+/**
+ * @brief PostgreSQL array type oid for an element type oid
+ */
+template < oids::type::oid_type ElementOid >
+struct array_type_oid :
+		std::integral_constant< oids::type::oid_type, oids::type::unknown > {};
+
+//@{
+/** @name Array types for built-in types */
+template < > struct array_type_oid< oids::type::boolean > :
+		std::integral_constant< oids::type::oid_type, oids::type::bool_array > {};
+template < > struct array_type_oid< oids::type::bytea > :
+		std::integral_constant< oids::type::oid_type, oids::type::bytea_array > {};
+template < > struct array_type_oid< oids::type::int2 > :
+		std::integral_constant< oids::type::oid_type, oids::type::int2_array > {};
+template < > struct array_type_oid< oids::type::int4 > :
+		std::integral_constant< oids::type::oid_type, oids::type::int4_array > {};
+template < > struct array_type_oid< oids::type::int8 > :
+		std::integral_constant< oids::type::oid_type, oids::type::int8_array > {};
+template < > struct array_type_oid< oids::type::oid > :
+		std::integral_constant< oids::type::oid_type, oids::type::oid_array > {};
+template < > struct array_type_oid< oids::type::float4 > :
+		std::integral_constant< oids::type::oid_type, oids::type::float4_array > {};
+template < > struct array_type_oid< oids::type::float8 > :
+		std::integral_constant< oids::type::oid_type, oids::type::float8_array > {};
+template < > struct array_type_oid< oids::type::text > :
+		std::integral_constant< oids::type::oid_type, oids::type::text_array > {};
+template < > struct array_type_oid< oids::type::date > :
+		std::integral_constant< oids::type::oid_type, oids::type::date_array > {};
+template < > struct array_type_oid< oids::type::time > :
+		std::integral_constant< oids::type::oid_type, oids::type::time_array > {};
+template < > struct array_type_oid< oids::type::timetz > :
+		std::integral_constant< oids::type::oid_type, oids::type::timetz_array > {};
+template < > struct array_type_oid< oids::type::timestamp > :
+		std::integral_constant< oids::type::oid_type, oids::type::timestamp_array > {};
+template < > struct array_type_oid< oids::type::timestamptz > :
+		std::integral_constant< oids::type::oid_type, oids::type::timestamptz_array > {};
+template < > struct array_type_oid< oids::type::interval > :
+		std::integral_constant< oids::type::oid_type, oids::type::interval_array > {};
+template < > struct array_type_oid< oids::type::uuid > :
+		std::integral_constant< oids::type::oid_type, oids::type::uuid_array > {};
+template < > struct array_type_oid< oids::type::inet > :
+		std::integral_constant< oids::type::oid_type, oids::type::inet_array > {};
+template < > struct array_type_oid< oids::type::cidr > :
+		std::integral_constant< oids::type::oid_type, oids::type::cidr_array > {};
+//@}
+
+}  // namespace traits
+
 namespace detail {
 
 template < typename Container >
@@ -91,7 +146,410 @@ struct text_container_parser :
 	}
 };
 
+/**
+ * @brief Metafunction for containers mapped to PostgreSQL arrays.
+ *
+ * Nested containers are mapped to multi-dimensional arrays.
+ */
+template < typename T >
+struct array_traits {
+	typedef T element_type;
+	enum { rank = 0 };
+};
+
+template < typename T >
+struct array_traits< std::vector< T > > {
+	typedef typename array_traits< T >::element_type element_type;
+	enum { rank = array_traits< T >::rank + 1 };
+
+	/**
+	 * Prepare the container to receive sz elements
+	 * @return number of elements that fit the container
+	 */
+	static std::size_t
+	prepare(std::vector< T >& v, std::size_t sz)
+	{
+		v.resize(sz);
+		return sz;
+	}
+};
+
+template < typename T, std::size_t Sz >
+struct array_traits< std::array< T, Sz > > {
+	typedef typename array_traits< T >::element_type element_type;
+	enum { rank = array_traits< T >::rank + 1 };
+
+	static std::size_t
+	prepare(std::array< T, Sz >&, std::size_t sz)
+	{
+		return sz < Sz ? sz : Sz;
+	}
+};
+
+template < typename T >
+struct is_array_container :
+		std::integral_constant< bool, array_traits< T >::rank != 0 > {};
+
+template < typename T >
+struct array_element_value {
+	typedef T type;
+
+	static T const&
+	get(T const& v)
+	{ return v; }
+};
+
+template < typename T >
+struct array_element_value< boost::optional< T > > {
+	typedef T type;
+
+	static T const&
+	get(boost::optional< T > const& v)
+	{ return *v; }
+};
+
+/**
+ * @brief Binary array format properties of a container
+ */
+template < typename Container >
+struct binary_array_traits {
+	typedef array_traits< Container > container_traits;
+	/** Type of array element as stored in the container */
+	typedef typename container_traits::element_type element_type;
+	/** Type of element value, boost::optional is unwrapped */
+	typedef typename array_element_value< element_type >::type value_type;
+
+	static constexpr oids::type::oid_type element_oid =
+			traits::cpppg_data_mapping< value_type >::type_oid;
+	static constexpr oids::type::oid_type array_oid =
+			traits::array_type_oid< element_oid >::value;
+	static constexpr bool has_formatter =
+			traits::has_formatter< value_type, BINARY_DATA_FORMAT >::value
+			&& array_oid != oids::type::unknown;
+	static constexpr bool has_parser =
+			traits::has_parser< value_type, BINARY_DATA_FORMAT >::value;
+};
+
+/**
+ * @brief Formatter for PostgreSQL binary array format.
+ *
+ * Writes number of dimensions, null flag, element type oid, size and lower
+ * bound for each of dimensions and then the elements prefixed with their
+ * length. Nested containers must be rectangular.
+ */
+template < typename Container >
+struct binary_container_formatter : formatter_base< Container > {
+	typedef formatter_base< Container > base_type;
+	typedef typename base_type::value_type value_type;
+	typedef binary_array_traits< value_type > array_traits_type;
+	typedef typename array_traits_type::element_type element_type;
+	enum { rank = array_traits_type::container_traits::rank };
+	typedef std::array< integer, rank > dimensions_type;
+
+	binary_container_formatter(value_type const& v) : base_type(v) {}
+
+	size_t
+	size() const
+	{
+		dimensions_type dims;
+		if (!get_dimensions(base_type::value, dims, 0))
+			return 3 * sizeof(integer);
+		return 3 * sizeof(integer) + rank * 2 * sizeof(integer)
+				+ elements_size(base_type::value);
+	}
+
+	bool
+	operator()(std::vector<byte>& buffer)
+	{
+		dimensions_type dims;
+		bool empty = !get_dimensions(base_type::value, dims, 0);
+		size_t start = buffer.size();
+		protocol_write< BINARY_DATA_FORMAT >(buffer, (integer)(empty ? 0 : rank));
+		size_t null_flag_pos = buffer.size();
+		protocol_write< BINARY_DATA_FORMAT >(buffer, integer{0});
+		protocol_write< BINARY_DATA_FORMAT >(buffer,
+				(integer)array_traits_type::element_oid);
+		if (empty)
+			return true;
+		for (integer dim : dims) {
+			protocol_write< BINARY_DATA_FORMAT >(buffer, dim);
+			protocol_write< BINARY_DATA_FORMAT >(buffer, integer{1}); // lower bound
+		}
+		bool has_nulls{false};
+		if (!write_elements(buffer, base_type::value, dims, 0, has_nulls)) {
+			buffer.resize(start);
+			return false;
+		}
+		if (has_nulls) {
+			protocol_write< BINARY_DATA_FORMAT >(
+					buffer.begin() + null_flag_pos, integer{1});
+		}
+		return true;
+	}
+private:
+	template < typename C >
+	static bool
+	get_dimensions(C const& c, dimensions_type& dims, std::size_t level)
+	{
+		if (c.empty())
+			return false;
+		dims[level] = c.size();
+		return nested_dimensions(*c.begin(), dims, level + 1,
+				is_array_container< typename C::value_type >{});
+	}
+	template < typename C >
+	static bool
+	nested_dimensions(C const& c, dimensions_type& dims, std::size_t level,
+			std::true_type const&)
+	{
+		return get_dimensions(c, dims, level);
+	}
+	template < typename E >
+	static bool
+	nested_dimensions(E const&, dimensions_type&, std::size_t, std::false_type const&)
+	{
+		return true;
+	}
+
+	template < typename C >
+	static size_t
+	elements_size(C const& c)
+	{
+		size_t sz{0};
+		for (auto const& e : c) {
+			sz += element_size(e, is_array_container< typename C::value_type >{});
+		}
+		return sz;
+	}
+	template < typename C >
+	static size_t
+	element_size(C const& c, std::true_type const&)
+	{
+		return elements_size(c);
+	}
+	template < typename E >
+	static size_t
+	element_size(E const& e, std::false_type const&)
+	{
+		typedef array_element_value< E > element_value;
+		if (is_null(e))
+			return sizeof(integer);
+		return sizeof(integer) +
+				protocol_writer< BINARY_DATA_FORMAT >(element_value::get(e)).size();
+	}
+
+	template < typename C >
+	static bool
+	write_elements(std::vector<byte>& buffer, C const& c, dimensions_type const& dims,
+			std::size_t level, bool& has_nulls)
+	{
+		if ((integer)c.size() != dims[level])
+			return false;
+		for (auto const& e : c) {
+			if (!write_element(buffer, e, dims, level + 1, has_nulls,
+					is_array_container< typename C::value_type >{}))
+				return false;
+		}
+		return true;
+	}
+	template < typename C >
+	static bool
+	write_element(std::vector<byte>& buffer, C const& c, dimensions_type const& dims,
+			std::size_t level, bool& has_nulls, std::true_type const&)
+	{
+		return write_elements(buffer, c, dims, level, has_nulls);
+	}
+	template < typename E >
+	static bool
+	write_element(std::vector<byte>& buffer, E const& e, dimensions_type const&,
+			std::size_t, bool& has_nulls, std::false_type const&)
+	{
+		typedef array_element_value< E > element_value;
+		if (is_null(e)) {
+			has_nulls = true;
+			return protocol_write< BINARY_DATA_FORMAT >(buffer, integer{-1});
+		}
+		size_t len_pos = buffer.size();
+		buffer.resize(len_pos + sizeof(integer));
+		size_t prev_size = buffer.size();
+		if (!protocol_write< BINARY_DATA_FORMAT >(buffer, element_value::get(e)))
+			return false;
+		integer len = buffer.size() - prev_size;
+		protocol_write< BINARY_DATA_FORMAT >(buffer.begin() + len_pos, len);
+		return true;
+	}
+
+	template < typename E >
+	static bool
+	is_null(E const& e)
+	{
+		return is_null(e, traits::is_nullable< E >{});
+	}
+	template < typename E >
+	static bool
+	is_null(E const& e, std::true_type const&)
+	{
+		return traits::nullable_traits< E >::is_null(e);
+	}
+	template < typename E >
+	static bool
+	is_null(E const&, std::false_type const&)
+	{
+		return false;
+	}
+};
+
+/**
+ * @brief Parser for PostgreSQL binary array format.
+ *
+ * Number of dimensions must match the container nesting level. Null
+ * elements can be read only into nullable types. If a fixed-size container
+ * is smaller than the array dimension, the rest of elements is skipped.
+ */
+template < typename Container >
+struct binary_container_parser : parser_base< Container > {
+	typedef parser_base< Container > base_type;
+	typedef typename base_type::value_type value_type;
+	typedef binary_array_traits< value_type > array_traits_type;
+	typedef typename array_traits_type::container_traits container_traits;
+	enum { rank = container_traits::rank };
+	typedef std::array< integer, rank > dimensions_type;
+
+	binary_container_parser(value_type& v) : base_type(v) {}
+
+	template < typename InputIterator >
+	InputIterator
+	operator()(InputIterator begin, InputIterator end)
+	{
+		typedef std::iterator_traits< InputIterator > iter_traits;
+		typedef typename iter_traits::value_type iter_value_type;
+		static_assert(std::is_same< iter_value_type, byte >::type::value,
+				"Input iterator must be over a char container");
+
+		InputIterator c = begin;
+		integer ndim{0}, has_nulls{0}, element_oid{0};
+		if (!read(c, end, ndim) || !read(c, end, has_nulls)
+				|| !read(c, end, element_oid))
+			return begin;
+		if (ndim == 0) {
+			container_traits::prepare(base_type::value, 0);
+			return c;
+		}
+		if (ndim != rank || !traits::binary_compatible<
+				typename array_traits_type::value_type >::accepts(
+						(oids::type::oid_type)element_oid))
+			return begin;
+		dimensions_type dims;
+		for (integer& dim : dims) {
+			integer lower_bound{0};
+			if (!read(c, end, dim) || !read(c, end, lower_bound) || dim < 0)
+				return begin;
+		}
+		if (!read_elements(c, end, base_type::value, dims, 0))
+			return begin;
+		return c;
+	}
+private:
+	template < typename InputIterator, typename T >
+	static bool
+	read(InputIterator& c, InputIterator end, T& val)
+	{
+		if (end - c < (decltype(end - c))sizeof(T))
+			return false;
+		c = protocol_read< BINARY_DATA_FORMAT >(c, end, val);
+		return true;
+	}
+
+	template < typename InputIterator, typename C >
+	static bool
+	read_elements(InputIterator& c, InputIterator end, C& cont,
+			dimensions_type const& dims, std::size_t level)
+	{
+		typedef typename C::value_type element_type;
+		std::size_t n = array_traits< C >::prepare(cont, dims[level]);
+		auto out = cont.begin();
+		for (std::size_t i = 0; i < n; ++i, ++out) {
+			if (!read_element(c, end, *out, dims, level + 1,
+					is_array_container< element_type >{}))
+				return false;
+		}
+		std::size_t skip = dims[level] - n;
+		for (std::size_t l = level + 1; l < rank; ++l) {
+			skip *= dims[l];
+		}
+		for (; skip > 0; --skip) {
+			integer len{0};
+			if (!read(c, end, len))
+				return false;
+			if (len > 0) {
+				if (end - c < len)
+					return false;
+				c += len;
+			}
+		}
+		return true;
+	}
+	template < typename InputIterator, typename C >
+	static bool
+	read_element(InputIterator& c, InputIterator end, C& cont,
+			dimensions_type const& dims, std::size_t level, std::true_type const&)
+	{
+		return read_elements(c, end, cont, dims, level);
+	}
+	template < typename InputIterator, typename E >
+	static bool
+	read_element(InputIterator& c, InputIterator end, E& elem,
+			dimensions_type const&, std::size_t, std::false_type const&)
+	{
+		integer len{0};
+		if (!read(c, end, len))
+			return false;
+		if (len < 0)
+			return set_null(elem, traits::is_nullable< E >{});
+		if (end - c < len)
+			return false;
+		InputIterator e = c + len;
+		if (!read_value(c, e, elem) && len > 0)
+			return false;
+		c = e;
+		return true;
+	}
+
+	template < typename InputIterator, typename E >
+	static bool
+	read_value(InputIterator begin, InputIterator end, E& elem)
+	{
+		return protocol_read< BINARY_DATA_FORMAT >(begin, end, elem) != begin;
+	}
+	template < typename InputIterator, typename E >
+	static bool
+	read_value(InputIterator begin, InputIterator end, boost::optional< E >& elem)
+	{
+		E tmp;
+		if (read_value(begin, end, tmp)) {
+			elem = std::move(tmp);
+			return true;
+		}
+		return false;
+	}
+
+	template < typename E >
+	static bool
+	set_null(E& elem, std::true_type const&)
+	{
+		traits::nullable_traits< E >::set_null(elem);
+		return true;
+	}
+	template < typename E >
+	static bool
+	set_null(E&, std::false_type const&)
+	{
+		return false;
+	}
+};
+
 }  // namespace detail
+
 }  // namespace io
 }  // namespace pg
 }  // namespace db
@@ -56,17 +56,151 @@ struct protocol_parser< ASIO_NAMESPACE::ip::address, TEXT_DATA_FORMAT > :
 	}
 };
 
+namespace detail {
+
+/**
+ * @brief Address family markers used by PostgreSQL in binary inet/cidr
+ * representation
+ */
+enum inet_family : byte {
+	PGSQL_AF_INET = 2,
+	PGSQL_AF_INET6 = 3
+};
+
+}  // namespace detail
+
+/**
+ * @brief Binary parser for ip address.
+ * Reads inet and cidr values, netmask bits are ignored.
+ */
+template < >
+struct protocol_parser< ASIO_NAMESPACE::ip::address, BINARY_DATA_FORMAT > :
+		detail::parser_base< ASIO_NAMESPACE::ip::address > {
+	typedef detail::parser_base< ASIO_NAMESPACE::ip::address > base_type;
+	typedef base_type::value_type value_type;
+	typedef ASIO_NAMESPACE::ip::address_v4 address_v4;
+	typedef ASIO_NAMESPACE::ip::address_v6 address_v6;
+
+	protocol_parser(value_type& v) : base_type(v) {}
+
+	size_t
+	size() const
+	{
+		return 4 + (base_type::value.is_v4() ?
+				address_v4::bytes_type{}.size() : address_v6::bytes_type{}.size());
+	}
+
+	template < typename InputIterator >
+	InputIterator
+	operator()(InputIterator begin, InputIterator end)
+	{
+		typedef InputIterator iterator_type;
+		typedef std::iterator_traits< iterator_type > iter_traits;
+		typedef typename iter_traits::value_type iter_value_type;
+		static_assert(std::is_same< iter_value_type, byte >::type::value,
+				"Input iterator must be over a char container");
+		if (end - begin < 4)
+			return begin;
+		InputIterator c = begin;
+		byte family = *c++;
+		++c; // netmask bits
+		++c; // is cidr
+		byte len = *c++;
+		if (end - c < len)
+			return begin;
+		if (family == detail::PGSQL_AF_INET) {
+			address_v4::bytes_type bytes;
+			if ((size_t)len != bytes.size())
+				return begin;
+			std::copy(c, c + len, bytes.begin());
+			base_type::value = address_v4{bytes};
+		} else if (family == detail::PGSQL_AF_INET6) {
+			address_v6::bytes_type bytes;
+			if ((size_t)len != bytes.size())
+				return begin;
+			std::copy(c, c + len, bytes.begin());
+			base_type::value = address_v6{bytes};
+		} else {
+			return begin;
+		}
+		return c + len;
+	}
+};
+
+/**
+ * @brief Binary formatter for ip address.
+ * Writes the address as an inet value with a full netmask.
+ */
+template < >
+struct protocol_formatter< ASIO_NAMESPACE::ip::address, BINARY_DATA_FORMAT > :
+		detail::formatter_base< ASIO_NAMESPACE::ip::address > {
+	typedef detail::formatter_base< ASIO_NAMESPACE::ip::address > base_type;
+	typedef base_type::value_type value_type;
+	typedef ASIO_NAMESPACE::ip::address_v4 address_v4;
+	typedef ASIO_NAMESPACE::ip::address_v6 address_v6;
+
+	protocol_formatter(value_type const& v) : base_type(v) {}
+
+	size_t
+	size() const
+	{
+		return 4 + (base_type::value.is_v4() ?
+				address_v4::bytes_type{}.size() : address_v6::bytes_type{}.size());
+	}
+
+	bool
+	operator()(std::vector<byte>& buffer)
+	{
+		if (base_type::value.is_v4()) {
+			address_v4::bytes_type bytes = base_type::value.to_v4().to_bytes();
+			write(buffer, detail::PGSQL_AF_INET, bytes.begin(), bytes.end());
+		} else {
+			address_v6::bytes_type bytes = base_type::value.to_v6().to_bytes();
+			write(buffer, detail::PGSQL_AF_INET6, bytes.begin(), bytes.end());
+		}
+		return true;
+	}
+private:
+	template < typename Iterator >
+	void
+	write(std::vector<byte>& buffer, byte family, Iterator begin, Iterator end)
+	{
+		byte len = end - begin;
+		buffer.push_back(family);
+		buffer.push_back(len * 8);	// netmask bits
+		buffer.push_back(0);		// is cidr
+		buffer.push_back(len);
+		buffer.insert(buffer.end(), begin, end);
+	}
+};
+
 namespace traits {
 
 template < >
 struct has_parser< ASIO_NAMESPACE::ip::address, TEXT_DATA_FORMAT > : std::true_type {};
+template < >
+struct has_parser< ASIO_NAMESPACE::ip::address, BINARY_DATA_FORMAT > : std::true_type {};
+template < >
+struct has_formatter< ASIO_NAMESPACE::ip::address, BINARY_DATA_FORMAT > : std::true_type {};
 //@{
 template < >
 struct pgcpp_data_mapping< oids::type::inet > :
-		detail::data_mapping_base< oids::type::inet, boost::asio::ip::address > {};
+		detail::data_mapping_base< oids::type::inet, ASIO_NAMESPACE::ip::address > {};
+template < >
+struct pgcpp_data_mapping< oids::type::cidr > :
+		detail::data_mapping_base< oids::type::cidr, ASIO_NAMESPACE::ip::address > {};
+template < >
+struct cpppg_data_mapping< ASIO_NAMESPACE::ip::address > :
+		detail::data_mapping_base< oids::type::inet, ASIO_NAMESPACE::ip::address > {};
+
 template < >
-struct cpppg_data_mapping< boost::asio::ip::address > :
-		detail::data_mapping_base< oids::type::inet, boost::asio::ip::address > {};
+struct binary_compatible< ASIO_NAMESPACE::ip::address > {
+	static bool
+	accepts( oids::type::oid_type id )
+	{
+		return id == oids::type::inet || id == oids::type::cidr;
+	}
+};
 //@}
 
 }  // namespace traits
@@ -0,0 +1,351 @@
+/*
+ * std_chrono.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_IO_STD_CHRONO_HPP_
+#define LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_IO_STD_CHRONO_HPP_
+
+#include <tip/db/pg/protocol_io_traits.hpp>
+#include <tip/db/pg/io/boost_date_time.hpp>
+
+#include <chrono>
+#include <limits>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace io {
+
+namespace detail {
+
+/**
+ * @brief Conversions between std::chrono types and PostgreSQL binary
+ * date/time representations.
+ *
+ * Timestamps are microseconds since 2000-01-01 00:00:00 UTC, intervals are
+ * microseconds, days and months. A day is converted to 24 hours, a month has
+ * no fixed length and is not converted.
+ */
+struct chrono_conversion {
+    typedef std::chrono::microseconds           microseconds;
+    typedef std::chrono::system_clock           clock_type;
+    /** Seconds between the Unix epoch and PostgreSQL epoch */
+    static constexpr bigint pg_epoch_offset     = 946684800;
+    static constexpr bigint usecs_per_day       = 86400LL * 1000000;
+
+    template < typename Duration >
+    static bigint
+    to_pg_timestamp(std::chrono::time_point< clock_type, Duration > const& tp)
+    {
+        typedef std::chrono::time_point< clock_type, Duration > time_point;
+        if (tp == time_point::max())
+            return std::numeric_limits< bigint >::max();
+        if (tp == time_point::min())
+            return std::numeric_limits< bigint >::min();
+        return std::chrono::duration_cast< microseconds >(
+                tp.time_since_epoch()).count() - pg_epoch_offset * 1000000;
+    }
+
+    template < typename Duration >
+    static void
+    from_pg_timestamp(bigint usecs,
+            std::chrono::time_point< clock_type, Duration >& tp)
+    {
+        typedef std::chrono::time_point< clock_type, Duration > time_point;
+        if (usecs == std::numeric_limits< bigint >::max()) {
+            tp = time_point::max();
+        } else if (usecs == std::numeric_limits< bigint >::min()) {
+            tp = time_point::min();
+        } else {
+            tp = time_point{ std::chrono::duration_cast< Duration >(
+                    microseconds{ usecs + pg_epoch_offset * 1000000 }) };
+        }
+    }
+
+    static bigint
+    interval_usecs(bigint usecs, integer days)
+    {
+        return usecs + days * usecs_per_day;
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Text parser for std::chrono::system_clock time points.
+ * Timezone offset of a timestamptz value is applied, timestamps without
+ * time zone are considered UTC.
+ */
+template < typename Duration >
+struct protocol_parser<
+        std::chrono::time_point< std::chrono::system_clock, Duration >,
+        TEXT_DATA_FORMAT > :
+        detail::parser_base<
+            std::chrono::time_point< std::chrono::system_clock, Duration > > {
+    typedef detail::parser_base<
+            std::chrono::time_point< std::chrono::system_clock, Duration > > base_type;
+    typedef typename base_type::value_type value_type;
+
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end)
+    {
+        typedef std::iterator_traits< InputIterator > iter_traits;
+        typedef typename iter_traits::value_type iter_value_type;
+        static_assert(std::is_same< iter_value_type, byte >::type::value,
+                "Input iterator must be over a char container");
+        typedef detail::chrono_conversion conversion;
+
+        boost::posix_time::ptime tmp;
+        int offset{0};
+        InputIterator c = begin;
+        if (!detail::iso_datetime_parser::parse_timestamp(c, end, tmp, offset))
+            return begin;
+        if (tmp.is_pos_infinity()) {
+            base_type::value = value_type::max();
+        } else if (tmp.is_neg_infinity()) {
+            base_type::value = value_type::min();
+        } else {
+            boost::posix_time::ptime const pg_epoch(
+                    boost::gregorian::date{2000, boost::gregorian::Jan, 1});
+            conversion::from_pg_timestamp(
+                    (tmp - pg_epoch).total_microseconds() - offset * 1000000LL,
+                    base_type::value);
+        }
+        return c;
+    }
+};
+
+/**
+ * @brief Binary parser for std::chrono::system_clock time points.
+ */
+template < typename Duration >
+struct protocol_parser<
+        std::chrono::time_point< std::chrono::system_clock, Duration >,
+        BINARY_DATA_FORMAT > :
+        detail::parser_base<
+            std::chrono::time_point< std::chrono::system_clock, Duration > > {
+    typedef detail::parser_base<
+            std::chrono::time_point< std::chrono::system_clock, Duration > > base_type;
+    typedef typename base_type::value_type value_type;
+
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(bigint);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end)
+    {
+        bigint tmp{0};
+        auto res = protocol_read< BINARY_DATA_FORMAT >(begin, end, tmp);
+        if (res != begin)
+            detail::chrono_conversion::from_pg_timestamp(tmp, base_type::value);
+        return res;
+    }
+};
+
+/**
+ * @brief Binary formatter for std::chrono::system_clock time points.
+ * Writes the value as a timestamptz.
+ */
+template < typename Duration >
+struct protocol_formatter<
+        std::chrono::time_point< std::chrono::system_clock, Duration >,
+        BINARY_DATA_FORMAT > :
+        detail::formatter_base<
+            std::chrono::time_point< std::chrono::system_clock, Duration > > {
+    typedef detail::formatter_base<
+            std::chrono::time_point< std::chrono::system_clock, Duration > > base_type;
+    typedef typename base_type::value_type value_type;
+
+    protocol_formatter(value_type const& v) : base_type(v) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(bigint);
+    }
+
+    bool
+    operator()(std::vector<byte>& buffer)
+    {
+        return protocol_write< BINARY_DATA_FORMAT >(buffer,
+                detail::chrono_conversion::to_pg_timestamp(base_type::value));
+    }
+};
+
+/**
+ * @brief Text parser for std::chrono durations.
+ * Accepts the same representations as the time_duration parser.
+ */
+template < typename Rep, typename Period >
+struct protocol_parser< std::chrono::duration< Rep, Period >, TEXT_DATA_FORMAT > :
+        detail::parser_base< std::chrono::duration< Rep, Period > > {
+    typedef detail::parser_base< std::chrono::duration< Rep, Period > > base_type;
+    typedef typename base_type::value_type value_type;
+
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end)
+    {
+        boost::posix_time::time_duration tmp;
+        auto res = protocol_read< TEXT_DATA_FORMAT >(begin, end, tmp);
+        if (res != begin) {
+            base_type::value = std::chrono::duration_cast< value_type >(
+                    std::chrono::microseconds{ tmp.total_microseconds() });
+        }
+        return res;
+    }
+};
+
+/**
+ * @brief Binary parser for std::chrono durations.
+ * Reads time, timetz and interval values. An interval with a non-zero month
+ * field is rejected.
+ */
+template < typename Rep, typename Period >
+struct protocol_parser< std::chrono::duration< Rep, Period >, BINARY_DATA_FORMAT > :
+        detail::parser_base< std::chrono::duration< Rep, Period > > {
+    typedef detail::parser_base< std::chrono::duration< Rep, Period > > base_type;
+    typedef typename base_type::value_type value_type;
+
+    protocol_parser(value_type& v) : base_type(v) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(bigint) + 2 * sizeof(integer);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end)
+    {
+        bigint usecs{0};
+        integer days{0}, months{0};
+        InputIterator c = protocol_read< BINARY_DATA_FORMAT >(begin, end, usecs);
+        if (c == begin)
+            return begin;
+        if (end - c >= (decltype (end - c))(2 * sizeof(integer))) {
+            c = protocol_read< BINARY_DATA_FORMAT >(c, end, days);
+            c = protocol_read< BINARY_DATA_FORMAT >(c, end, months);
+            if (months != 0)
+                return begin;
+        } else if (end - c == (decltype (end - c))sizeof(integer)) {
+            integer zone{0};
+            c = protocol_read< BINARY_DATA_FORMAT >(c, end, zone);
+        }
+        base_type::value = std::chrono::duration_cast< value_type >(
+                std::chrono::microseconds{
+                    detail::chrono_conversion::interval_usecs(usecs, days) });
+        return c;
+    }
+};
+
+/**
+ * @brief Binary formatter for std::chrono durations.
+ * Writes the value as an interval.
+ */
+template < typename Rep, typename Period >
+struct protocol_formatter< std::chrono::duration< Rep, Period >, BINARY_DATA_FORMAT > :
+        detail::formatter_base< std::chrono::duration< Rep, Period > > {
+    typedef detail::formatter_base< std::chrono::duration< Rep, Period > > base_type;
+    typedef typename base_type::value_type value_type;
+
+    protocol_formatter(value_type const& v) : base_type(v) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(bigint) + 2 * sizeof(integer);
+    }
+
+    bool
+    operator()(std::vector<byte>& buffer)
+    {
+        bigint usecs = std::chrono::duration_cast< std::chrono::microseconds >(
+                base_type::value).count();
+        protocol_write< BINARY_DATA_FORMAT >(buffer, usecs);
+        protocol_write< BINARY_DATA_FORMAT >(buffer, integer{0});  // days
+        protocol_write< BINARY_DATA_FORMAT >(buffer, integer{0});  // months
+        return true;
+    }
+};
+
+namespace traits {
+
+//@{
+/** @name std::chrono::system_clock::time_point traits */
+template < typename Duration >
+struct has_parser< std::chrono::time_point< std::chrono::system_clock, Duration >,
+        TEXT_DATA_FORMAT > : std::true_type {};
+template < typename Duration >
+struct has_parser< std::chrono::time_point< std::chrono::system_clock, Duration >,
+        BINARY_DATA_FORMAT > : std::true_type {};
+template < typename Duration >
+struct has_formatter< std::chrono::time_point< std::chrono::system_clock, Duration >,
+        BINARY_DATA_FORMAT > : std::true_type {};
+
+template < typename Duration >
+struct cpppg_data_mapping< std::chrono::time_point< std::chrono::system_clock, Duration > > :
+        detail::data_mapping_base< oids::type::timestamptz,
+            std::chrono::time_point< std::chrono::system_clock, Duration > > {};
+
+template < typename Duration >
+struct binary_compatible< std::chrono::time_point< std::chrono::system_clock, Duration > > {
+    static bool
+    accepts( oids::type::oid_type id )
+    {
+        return id == oids::type::timestamp || id == oids::type::timestamptz;
+    }
+};
+//@}
+
+//@{
+/** @name std::chrono::duration traits */
+template < typename Rep, typename Period >
+struct has_parser< std::chrono::duration< Rep, Period >, TEXT_DATA_FORMAT > :
+        std::true_type {};
+template < typename Rep, typename Period >
+struct has_parser< std::chrono::duration< Rep, Period >, BINARY_DATA_FORMAT > :
+        std::true_type {};
+template < typename Rep, typename Period >
+struct has_formatter< std::chrono::duration< Rep, Period >, BINARY_DATA_FORMAT > :
+        std::true_type {};
+
+template < typename Rep, typename Period >
+struct cpppg_data_mapping< std::chrono::duration< Rep, Period > > :
+        detail::data_mapping_base< oids::type::interval,
+            std::chrono::duration< Rep, Period > > {};
+
+template < typename Rep, typename Period >
+struct binary_compatible< std::chrono::duration< Rep, Period > > {
+    static bool
+    accepts( oids::type::oid_type id )
+    {
+        return id == oids::type::time || id == oids::type::timetz
+                || id == oids::type::interval;
+    }
+};
+//@}
+
+}  // namespace traits
+
+}  // namespace io
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+#endif /* LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_IO_STD_CHRONO_HPP_ */
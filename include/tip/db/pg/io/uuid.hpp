@@ -45,7 +45,7 @@ struct protocol_parser< ::boost::uuids::uuid, BINARY_DATA_FORMAT >:
         assert( (end - begin) >= (decltype (end - begin))size() && "Buffer size is insufficient" );
         end = begin + size();
         ::std::copy(begin, end, base_type::value.begin());
-        return begin;
+        return end;
     }
 };
 
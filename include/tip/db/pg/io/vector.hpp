@@ -59,6 +59,30 @@ struct protocol_parser< std::vector< T >, TEXT_DATA_FORMAT > :
 	}
 };
 
+/**
+ * @brief Binary format specialization for std::vector, mapping to postgre array.
+ * Nested vectors are mapped to multi-dimensional arrays.
+ */
+template < typename T >
+struct protocol_formatter< std::vector< T >, BINARY_DATA_FORMAT > :
+		detail::binary_container_formatter< std::vector< T > > {
+
+	typedef detail::binary_container_formatter< std::vector< T > > base_type;
+	typedef typename base_type::value_type value_type;
+
+	protocol_formatter(value_type const& v) : base_type(v) {}
+};
+
+template < typename T >
+struct protocol_parser< std::vector< T >, BINARY_DATA_FORMAT > :
+		detail::binary_container_parser< std::vector< T > > {
+
+	typedef detail::binary_container_parser< std::vector< T > > base_type;
+	typedef typename base_type::value_type value_type;
+
+	protocol_parser(value_type& v) : base_type(v) {}
+};
+
 namespace traits {
 
 template < typename T >
@@ -66,9 +90,35 @@ struct has_formatter< std::vector< T >, TEXT_DATA_FORMAT > : std::true_type {};
 template < typename T >
 struct has_parser< std::vector< T >, TEXT_DATA_FORMAT > : std::true_type {};
 
+template < typename T >
+struct has_formatter< std::vector< T >, BINARY_DATA_FORMAT > :
+	std::integral_constant< bool,
+		detail::binary_array_traits< std::vector< T > >::has_formatter > {};
+template < typename T >
+struct has_parser< std::vector< T >, BINARY_DATA_FORMAT > :
+	std::integral_constant< bool,
+		detail::binary_array_traits< std::vector< T > >::has_parser > {};
+
+/**
+ * Vectors of elements that can be written in binary format are mapped to
+ * the corresponding array type, others are sent as text
+ */
 template < typename T >
 struct cpppg_data_mapping< std::vector< T > > :
-	detail::data_mapping_base < oids::type::text, std::vector< T > > {};
+	detail::data_mapping_base <
+		(detail::binary_array_traits< std::vector< T > >::has_formatter ?
+			detail::binary_array_traits< std::vector< T > >::array_oid :
+			oids::type::text),
+		std::vector< T > > {};
+
+template < typename T >
+struct binary_compatible< std::vector< T > > {
+	static bool
+	accepts(oids::type::oid_type id)
+	{
+		return id == detail::binary_array_traits< std::vector< T > >::array_oid;
+	}
+};
 
 }  // namespace traits
 
@@ -59,6 +59,30 @@ enum oid_type {
 	text_array			= 1009,
 	oid_array			= 1028,
 	float4_array		= 1021,
+	bool_array			= 1000,
+	bytea_array			= 1001,
+	char_array			= 1002,
+	name_array			= 1003,
+	int8_array			= 1016,
+	tid_array			= 1010,
+	xid_array			= 1011,
+	cid_array			= 1012,
+	bpchar_array		= 1014,
+	varchar_array		= 1015,
+	float8_array		= 1022,
+	macaddr_array		= 1040,
+	inet_array			= 1041,
+	cidr_array			= 651,
+	timestamp_array		= 1115,
+	date_array			= 1182,
+	time_array			= 1183,
+	timestamptz_array	= 1185,
+	interval_array		= 1187,
+	timetz_array		= 1270,
+	numeric_array		= 1231,
+	uuid_array			= 2951,
+	json_array			= 199,
+	jsonb_array			= 3807,
 	acl_item			= 1033,
 	cstring_array		= 1263,
 	bpchar				= 1042,
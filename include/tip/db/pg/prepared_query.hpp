@@ -0,0 +1,200 @@
+/**
+ * @file tip/db/pg/prepared_query.hpp
+ *
+ *    @date Oct 19, 2026
+ *  @author zmij
+ */
+
+#ifndef LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_PREPARED_QUERY_HPP_
+#define LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_PREPARED_QUERY_HPP_
+
+#include <tip/db/pg/common.hpp>
+#include <tip/db/pg/query.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tip {
+namespace db {
+namespace pg {
+
+namespace detail {
+
+/**
+ * Type-independent part of a prepared query
+ */
+class prepared_query_base {
+public:
+    /**
+     * The statement shared by all runs of the query
+     */
+    prepared_statement_ptr const&
+    statement() const
+    { return statement_; }
+protected:
+    prepared_query_base(dbalias const& alias, transaction_mode const& mode,
+            std::string const& expression, type_oid_sequence&& param_types);
+
+    void
+    run_async(std::vector<byte>&& params,
+            query_result_callback const& result, error_callback const& error) const;
+    void
+    run_async(transaction_ptr tran, std::vector<byte>&& params,
+            query_result_callback const& result, error_callback const& error) const;
+private:
+    dbalias                 alias_;
+    transaction_mode        mode_;
+    prepared_statement_ptr  statement_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief A reusable prepared query with parameter types known at compile time.
+ *
+ * SQL expression, parameter types and the statement name are computed once
+ * and shared by all runs, every run encodes only its parameter values into
+ * a buffer that is moved to the connection.
+ *
+ * Synopsis:
+ * @code
+ * prepared_query< integer, std::string > find_user(alias,
+ *         "select * from users where id = $1 and name = $2");
+ * find_user(10, "Ann",
+ *     [](transaction_ptr tran, resultset res, bool complete)
+ *     {
+ *         // process the query results
+ *     },
+ *     [](error::db_error const& e)
+ *     {
+ *         // handle the error here
+ *     });
+ * resultset res = find_user.run(20, "Bob");
+ * @endcode
+ *
+ * @tparam T query parameter types
+ */
+template < typename ... T >
+class prepared_query : public detail::prepared_query_base {
+public:
+    /**
+     * @brief Construct a prepared query.
+     *
+     * Every run of the query will start a transaction in a connection with
+     * the alias.
+     * @param alias Database connection alias.
+     * @param expression SQL query expression
+     */
+    prepared_query(dbalias const& alias, std::string const& expression)
+        : prepared_query_base(alias, transaction_mode{}, expression, param_types())
+    {
+    }
+    /**
+     * @brief Construct a prepared query.
+     *
+     * Every run of the query will start a transaction in a connection with
+     * the alias with the specified mode.
+     * @param alias Database connection alias.
+     * @param mode  Transaction mode
+     * @param expression SQL query expression
+     */
+    prepared_query(dbalias const& alias, transaction_mode const& mode,
+            std::string const& expression)
+        : prepared_query_base(alias, mode, expression, param_types())
+    {
+    }
+
+    /**
+     * @brief Run the query in a new transaction
+     * @param params query parameters
+     * @param result result callback
+     * @param error error callback
+     */
+    void
+    run_async(T const& ... params,
+            query_result_callback const& result, error_callback const& error) const
+    {
+        prepared_query_base::run_async(encode(params ...), result, error);
+    }
+    /**
+     * @brief Run the query in a transaction
+     * @param tran transaction object pointer
+     * @param params query parameters
+     * @param result result callback
+     * @param error error callback
+     */
+    void
+    run_async(transaction_ptr tran, T const& ... params,
+            query_result_callback const& result, error_callback const& error) const
+    {
+        prepared_query_base::run_async(tran, encode(params ...), result, error);
+    }
+    /**
+     * Shortcut for @ref tip::db::pg::prepared_query::run_async
+     */
+    void
+    operator()(T const& ... params,
+            query_result_callback const& result, error_callback const& error) const
+    {
+        run_async(params ..., result, error);
+    }
+
+    /**
+     * Start running the query, return future
+     */
+    template < template <typename> class _Promise = promise >
+    auto
+    run_async(T const& ... params) const
+        -> decltype(::std::declval<_Promise<resultset>>().get_future())
+    {
+        auto promise = ::std::make_shared<_Promise<resultset>>();
+
+        run_async(params ...,
+            [promise](transaction_ptr trx, resultset r, bool complete)
+            {
+                if (complete) {
+                    promise->set_value(r);
+                }
+            },
+            [promise](error::db_error const& e)
+            {
+                promise->set_exception(::std::make_exception_ptr(e));
+            }
+        );
+
+        return promise->get_future();
+    }
+    /**
+     * Run query "synchronously". Will return when the resultset is fully
+     * transferred from database.
+     */
+    template < template<typename> class _Promise = promise >
+    resultset
+    run(T const& ... params) const
+    {
+        auto future = run_async<_Promise>(params ...);
+        return future.get();
+    }
+private:
+    static type_oid_sequence
+    param_types()
+    {
+        type_oid_sequence types;
+        detail::param_types_writer< T ... >::write(types);
+        return types;
+    }
+    static std::vector<byte>
+    encode(T const& ... params)
+    {
+        std::vector<byte> buffer;
+        detail::write_param_values(buffer, params ...);
+        return buffer;
+    }
+};
+
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+#endif /* LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_PREPARED_QUERY_HPP_ */
@@ -47,8 +47,8 @@ typedef std::integral_constant< protocol_binary_type, OTHER > other_binary_type;
  */
 typedef std::integral_constant< protocol_binary_type, INTEGRAL > integral_binary_type;
 /** @brief Floating point datatypes.
- * Binary parser is not implemented yet.
- * @todo Implement binary parser for floating point values
+ * Selects binary parser specialization with network byte order conversion
+ * of the IEEE 754 representation.
  */
 typedef std::integral_constant< protocol_binary_type, FLOATING_POINT > floating_point_binary_type;
 
@@ -73,6 +73,24 @@ template <> struct protocol_binary_selector<float> : floating_point_binary_type{
 template <> struct protocol_binary_selector<double> : floating_point_binary_type{};
 //@}
 
+/**
+ * @brief Metafunction for specifying text protocol parser type.
+ *
+ * Integral types except character types and floating point types are parsed
+ * directly from the data buffer, other types use the input operator.
+ */
+template < typename T >
+struct protocol_text_selector : std::integral_constant< protocol_binary_type,
+        std::is_floating_point< T >::value ? FLOATING_POINT :
+        (std::is_integral< T >::value
+            && !std::is_same< T, bool >::value
+            && !std::is_same< T, char >::value
+            && !std::is_same< T, signed char >::value
+            && !std::is_same< T, unsigned char >::value
+            && !std::is_same< T, wchar_t >::value
+            && !std::is_same< T, char16_t >::value
+            && !std::is_same< T, char32_t >::value) ? INTEGRAL : OTHER > {};
+
 }  // namespace detail
 
 namespace traits {
@@ -173,6 +191,26 @@ protocol_read(InputIterator begin, InputIterator end, T& value)
     return typename protocol_io_traits< T, F >::parser_type(value)(begin, end);
 }
 
+/**
+ * @brief Read value from a raw memory buffer
+ *
+ * Entry point for reading field data in place, without building an input
+ * buffer around it. Used when traits::has_raw_parser is true for the type
+ * and protocol.
+ *
+ * @param data pointer to the start of the value
+ * @param size size of the value
+ * @param value variable to read into
+ * @return pointer after the value. If the pointer returned is equal to
+ *             data, nothing has been read and it means an error.
+ */
+template < protocol_data_format F, typename T >
+char const*
+protocol_read(char const* data, std::size_t size, T& value)
+{
+    return protocol_read< F >(data, data + size, value);
+}
+
 /**
  * @brief Helper function to create a protocol formatter
  *
@@ -292,6 +330,38 @@ struct binary_data_parser < T, INTEGRAL > : parser_base< T > {
     operator()( InputIterator begin, InputIterator end );
 };
 
+/**
+ * @brief Specification of a binary parser for floating point values
+ *
+ * Supports float (float4) and double (float8). The value is transferred as
+ * an IEEE 754 bit pattern in network byte order.
+ * @tparam T floating point data type
+ */
+template < typename T >
+struct binary_data_parser < T, FLOATING_POINT > : parser_base< T > {
+    typedef parser_base<T> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename std::conditional< sizeof(T) == sizeof(integer),
+            integer, bigint >::type integral_type;
+    static_assert(sizeof(T) == sizeof(integral_type),
+            "Floating point type size doesn't match an integral type size");
+
+    /**
+     * @brief data size
+     */
+    size_t
+    size() const
+    {
+        return sizeof(T);
+    }
+
+    binary_data_parser(value_type& val) : base_type(val) {}
+
+    template < typename InputIterator >
+    InputIterator
+    operator()( InputIterator begin, InputIterator end );
+};
+
 template < typename T >
 struct binary_data_parser < T, OTHER >;
 
@@ -332,6 +402,119 @@ struct binary_data_formatter < T, INTEGRAL > : formatter_base< T > {
     operator()(OutputIterator);
 };
 
+/**
+ * @brief Specification of a binary formatter for floating point values
+ *
+ * Supports float (float4) and double (float8).
+ * @tparam T floating point data type
+ */
+template < typename T >
+struct binary_data_formatter < T, FLOATING_POINT > : formatter_base< T > {
+    typedef formatter_base< T > base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename std::conditional< sizeof(T) == sizeof(integer),
+            integer, bigint >::type integral_type;
+    static_assert(sizeof(T) == sizeof(integral_type),
+            "Floating point type size doesn't match an integral type size");
+
+    size_t
+    size() const
+    {
+        return sizeof(T);
+    }
+
+    binary_data_formatter(value_type const& val) : base_type(val) {}
+
+    bool
+    operator()(std::vector<byte>& buffer);
+
+    template < typename OutputIterator >
+    bool
+    operator()(OutputIterator);
+};
+
+/**
+ * @brief Base structure for a text data parser.
+ * @tparam T type of value to parse
+ * @tparam TYPE selector for the type
+ */
+template < typename T, protocol_binary_type TYPE >
+struct text_data_parser;
+
+/**
+ * @brief Text parser for types having an input operator
+ */
+template < typename T >
+struct text_data_parser< T, OTHER > : parser_base< T > {
+    typedef parser_base< T > base_type;
+    typedef typename base_type::value_type value_type;
+
+    typedef tip::util::input_iterator_buffer buffer_type;
+
+    text_data_parser(value_type& val) : base_type(val) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(T);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end);
+};
+
+/**
+ * @brief Text parser for integral values.
+ *
+ * Parses an optional sign and decimal digits directly from the buffer,
+ * fails on overflow and on a minus sign for unsigned types.
+ * @tparam T integral data type
+ */
+template < typename T >
+struct text_data_parser< T, INTEGRAL > : parser_base< T > {
+    typedef parser_base< T > base_type;
+    typedef typename base_type::value_type value_type;
+
+    text_data_parser(value_type& val) : base_type(val) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(T);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end);
+};
+
+/**
+ * @brief Text parser for floating point values.
+ *
+ * Copies the value to a stack buffer and converts it with strtod family of
+ * functions in the "C" locale, so that the global locale doesn't change the
+ * decimal point. Accepts NaN and Infinity literals.
+ * @tparam T floating point data type
+ */
+template < typename T >
+struct text_data_parser< T, FLOATING_POINT > : parser_base< T > {
+    typedef parser_base< T > base_type;
+    typedef typename base_type::value_type value_type;
+
+    text_data_parser(value_type& val) : base_type(val) {}
+
+    size_t
+    size() const
+    {
+        return sizeof(T);
+    }
+
+    template < typename InputIterator >
+    InputIterator
+    operator()(InputIterator begin, InputIterator end);
+};
+
 /**
  * @brief Base structure for specifying mapping between C++ data type and
  *           PostgreSQL type oid.
@@ -362,6 +545,28 @@ register_binary_parser( oids::type::oid_type id );
 bool
 has_binary_parser( oids::type::oid_type id );
 
+}  // namespace traits
+
+/**
+ * @brief Convert a field value in binary data format to PostgreSQL text
+ *           representation of the value.
+ *
+ * Is used when a field was requested in binary format, but the C++ type
+ * it is read into cannot be parsed from the binary representation of the
+ * field type, e.g. a float8 field is read to a std::string.
+ * @param id PostgreSQL type oid of the field.
+ * @param begin Iterator to start of the field buffer
+ * @param end Iterator beyond the end of the field buffer
+ * @param text Output string
+ * @return false if the type oid is not supported
+ */
+bool
+binary_to_text( oids::type::oid_type id,
+        field_buffer::const_iterator begin, field_buffer::const_iterator end,
+        std::string& text );
+
+namespace traits {
+
 /**
  * Struct for using for generating wanted data formats from oids
  * Default type mapping falls back to string type and text format
@@ -381,6 +586,26 @@ struct cpppg_data_mapping : detail::data_mapping_base < oids::type::unknown, T >
 template < typename T >
 struct cpppg_data_mapping< boost::optional< T > > : cpppg_data_mapping< T > {};
 
+/**
+ * @brief Check if the binary parser of a C++ type can read a value of a
+ *           PostgreSQL type.
+ *
+ * By default a binary parser accepts the type oid the C++ type is mapped to.
+ * If the C++ type has no mapping, it is up to the user to read the field
+ * into an appropriate type.
+ * If the binary parser cannot read the field, the field is converted to
+ * text representation and read with a text parser.
+ */
+template < typename T >
+struct binary_compatible {
+    static bool
+    accepts( oids::type::oid_type id )
+    {
+        return cpppg_data_mapping< T >::type_oid == oids::type::unknown
+                || cpppg_data_mapping< T >::type_oid == id;
+    }
+};
+
 //@{
 /** @name parser and formatter traits */
 struct __io_meta_function_helper {
@@ -424,6 +649,8 @@ struct has_parser< T, TEXT_DATA_FORMAT >
 template < > struct has_parser< smallint, BINARY_DATA_FORMAT > : std::true_type {};
 template < > struct has_parser< integer, BINARY_DATA_FORMAT > : std::true_type {};
 template < > struct has_parser< bigint, BINARY_DATA_FORMAT > : std::true_type {};
+template < > struct has_parser< float, BINARY_DATA_FORMAT > : std::true_type {};
+template < > struct has_parser< double, BINARY_DATA_FORMAT > : std::true_type {};
 
 template < typename T >
 struct has_formatter< T, TEXT_DATA_FORMAT >
@@ -431,6 +658,8 @@ struct has_formatter< T, TEXT_DATA_FORMAT >
 template < > struct has_formatter< smallint, BINARY_DATA_FORMAT > : std::true_type {};
 template < > struct has_formatter< integer, BINARY_DATA_FORMAT > : std::true_type {};
 template < > struct has_formatter< bigint, BINARY_DATA_FORMAT > : std::true_type {};
+template < > struct has_formatter< float, BINARY_DATA_FORMAT > : std::true_type {};
+template < > struct has_formatter< double, BINARY_DATA_FORMAT > : std::true_type {};
 //@}
 
 //@{
@@ -521,35 +750,31 @@ static_assert(best_formatter< bigint >::value == BINARY_DATA_FORMAT,
 /** @name checks for floating-point types */
 static_assert(has_parser<float, TEXT_DATA_FORMAT>::value,
         "Text format parser for float");
-// @todo implement binary parser for floats
-//static_assert(has_parser<float, BINARY_DATA_FORMAT>::value,
-//        "Binary format parser for float");
-static_assert(best_parser< float >::value == TEXT_DATA_FORMAT,
-        "Best parser for float is text");
+static_assert(has_parser<float, BINARY_DATA_FORMAT>::value,
+        "Binary format parser for float");
+static_assert(best_parser< float >::value == BINARY_DATA_FORMAT,
+        "Best parser for float is binary");
 
 static_assert(has_formatter<float, TEXT_DATA_FORMAT>::value,
         "Text format writer for float");
-// @todo implement binary formatter for floats
-//static_assert(has_formatter<float, BINARY_DATA_FORMAT>::value,
-//        "Binary format writer for float");
-static_assert(best_formatter< float >::value == TEXT_DATA_FORMAT,
-        "Best writer for float is text");
+static_assert(has_formatter<float, BINARY_DATA_FORMAT>::value,
+        "Binary format writer for float");
+static_assert(best_formatter< float >::value == BINARY_DATA_FORMAT,
+        "Best writer for float is binary");
 
 static_assert(has_parser<double, TEXT_DATA_FORMAT>::value,
         "Text format parser for double");
-// @todo implement binary parser for doubles
-//static_assert(has_parser<double, BINARY_DATA_FORMAT>::value,
-//        "Binary format parser for double");
-static_assert(best_parser< double >::value == TEXT_DATA_FORMAT,
-        "Best parser for double is text");
+static_assert(has_parser<double, BINARY_DATA_FORMAT>::value,
+        "Binary format parser for double");
+static_assert(best_parser< double >::value == BINARY_DATA_FORMAT,
+        "Best parser for double is binary");
 
 static_assert(has_formatter<double, TEXT_DATA_FORMAT>::value,
         "Text format writer for double");
-// @todo implement binary formatter for doubles
-//static_assert(has_formatter<double, BINARY_DATA_FORMAT>::value,
-//        "Binary format writer for double");
-static_assert(best_formatter< double >::value == TEXT_DATA_FORMAT,
-        "Best writer for double is text");
+static_assert(has_formatter<double, BINARY_DATA_FORMAT>::value,
+        "Binary format writer for double");
+static_assert(best_formatter< double >::value == BINARY_DATA_FORMAT,
+        "Best writer for double is binary");
 //@}
 
 }  // namespace traits
@@ -589,24 +814,34 @@ struct protocol_formatter< T, TEXT_DATA_FORMAT > : detail::formatter_base< T > {
  * Default parser for text data format implementation
  */
 template < typename T >
-struct protocol_parser< T, TEXT_DATA_FORMAT > : detail::parser_base< T > {
-    typedef detail::parser_base< T > base_type;
-    typedef typename base_type::value_type value_type;
+struct protocol_parser< T, TEXT_DATA_FORMAT > :
+    detail::text_data_parser< T,
+        detail::protocol_text_selector< typename std::decay<T>::type >::value > {
 
-    typedef tip::util::input_iterator_buffer buffer_type;
+    typedef detail::text_data_parser< T,
+            detail::protocol_text_selector< typename std::decay<T>::type >::value > parser_base;
+    typedef typename parser_base::value_type value_type;
 
-    protocol_parser(value_type& v) : base_type(v) {}
+    protocol_parser(value_type& v) : parser_base(v) {}
+};
 
-    size_t
-    size() const
-    {
-        return sizeof(T);
-    }
+namespace traits {
+/**
+ * @brief Parser for the type reads the data in place via
+ * protocol_read(char const*, std::size_t, T&).
+ *
+ * False for text parsers that rely on the type's input operator, they
+ * are read through an input buffer.
+ */
+template < typename T, protocol_data_format F >
+struct has_raw_parser : has_parser< T, F > {};
 
-    template < typename InputIterator >
-    InputIterator
-    operator()(InputIterator begin, InputIterator end);
-};
+template < typename T >
+struct has_raw_parser< T, TEXT_DATA_FORMAT >
+    : std::integral_constant< bool, has_parser< T, TEXT_DATA_FORMAT >::value
+        && !std::is_base_of< detail::text_data_parser< T, OTHER >,
+                protocol_parser< T, TEXT_DATA_FORMAT > >::value > {};
+}  // namespace traits
 
 template < typename T >
 struct protocol_formatter < T, BINARY_DATA_FORMAT > :
@@ -721,6 +956,8 @@ struct protocol_parser< bool, TEXT_DATA_FORMAT > :
     }
     bool
     use_literal(std::string const& l);
+    bool
+    use_literal(char const* l, std::size_t sz);
 
     template < typename InputIterator >
     InputIterator
@@ -749,14 +986,49 @@ struct protocol_parser< bool, BINARY_DATA_FORMAT > :
     operator()( InputIterator begin, InputIterator end );
 };
 
+/**
+ * @brief Protocol formatter specialization for bool, binary data format
+ */
+template < >
+struct protocol_formatter< bool, BINARY_DATA_FORMAT > :
+            detail::formatter_base< bool > {
+    typedef detail::formatter_base< bool > base_type;
+    typedef base_type::value_type value_type;
+
+    protocol_formatter(value_type const& v) : base_type(v) {}
+    size_t
+    size() const
+    {
+        return sizeof(bool);
+    }
+    bool
+    operator()(std::vector<byte>& buffer)
+    {
+        buffer.push_back(base_type::value ? 1 : 0);
+        return true;
+    }
+    template < typename OutputIterator >
+    bool
+    operator()(OutputIterator out)
+    {
+        *out++ = base_type::value ? 1 : 0;
+        return true;
+    }
+};
+
 namespace traits {
 template < > struct has_parser< bool, BINARY_DATA_FORMAT > : std::true_type {};
+template < > struct has_formatter< bool, BINARY_DATA_FORMAT > : std::true_type {};
 static_assert(has_parser<bool, TEXT_DATA_FORMAT>::value,
                   "Text data parser for bool");
 static_assert(has_parser<bool, BINARY_DATA_FORMAT>::value,
                   "Binary data parser for bool");
 static_assert(best_parser<bool>::value == BINARY_DATA_FORMAT,
         "Best parser for bool is binary");
+static_assert(has_formatter<bool, BINARY_DATA_FORMAT>::value,
+                  "Binary data formatter for bool");
+static_assert(best_formatter<bool>::value == BINARY_DATA_FORMAT,
+        "Best formatter for bool is binary");
 }  // namespace traits
 
 /**
@@ -18,6 +18,8 @@
 #include <tip/util/endian.hpp>
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <iterator>
 
 namespace tip {
@@ -72,14 +74,40 @@ binary_data_formatter< T, INTEGRAL >::operator ()(OutputIterator out)
 	return true;
 }
 
+template < typename T >
+template < typename InputIterator >
+InputIterator
+binary_data_parser<T, FLOATING_POINT>::operator()(InputIterator begin, InputIterator end)
+{
+	integral_type tmp(0);
+	InputIterator res = protocol_read< BINARY_DATA_FORMAT >(begin, end, tmp);
+	if (res != begin) {
+		std::memcpy(&this->value, &tmp, sizeof(T));
+	}
+	return res;
+}
 
-}  // namespace detail
+template < typename T >
+bool
+binary_data_formatter<T, FLOATING_POINT>::operator()(std::vector<byte>& buffer)
+{
+	return (*this)( std::back_inserter(buffer) );
+}
+
+template < typename T >
+template < typename OutputIterator >
+bool
+binary_data_formatter< T, FLOATING_POINT >::operator ()(OutputIterator out)
+{
+	integral_type tmp(0);
+	std::memcpy(&tmp, &this->value, sizeof(T));
+	return protocol_write< BINARY_DATA_FORMAT >(out, tmp);
+}
 
 template < typename T >
 template < typename InputIterator >
 InputIterator
-protocol_parser< T, TEXT_DATA_FORMAT >::operator()
-	(InputIterator begin, InputIterator end)
+text_data_parser< T, OTHER >::operator()(InputIterator begin, InputIterator end)
 {
 	typedef std::iterator_traits< InputIterator > iter_traits;
 	typedef typename iter_traits::value_type iter_value_type;
@@ -91,6 +119,84 @@ protocol_parser< T, TEXT_DATA_FORMAT >::operator()
 	return begin;
 }
 
+template < typename T >
+template < typename InputIterator >
+InputIterator
+text_data_parser< T, INTEGRAL >::operator()(InputIterator begin, InputIterator end)
+{
+	typedef std::iterator_traits< InputIterator > iter_traits;
+	typedef typename iter_traits::value_type iter_value_type;
+	static_assert(std::is_same< iter_value_type, byte >::type::value,
+			"Input iterator must be over a char container");
+	typedef typename std::make_unsigned< T >::type unsigned_type;
+
+	InputIterator c = begin;
+	bool negative = false;
+	if (c != end && (*c == '-' || *c == '+')) {
+		negative = *c == '-';
+		++c;
+	}
+	if (negative && std::is_unsigned< T >::value)
+		return begin;
+	unsigned_type const limit = negative ?
+			unsigned_type(std::numeric_limits< T >::max()) + 1 :
+			unsigned_type(std::numeric_limits< T >::max());
+	unsigned_type acc{0};
+	InputIterator digits = c;
+	for (; c != end && '0' <= *c && *c <= '9'; ++c) {
+		unsigned_type d = *c - '0';
+		if (acc > (limit - d) / 10)
+			return begin; // Overflow
+		acc = acc * 10 + d;
+	}
+	if (c == digits)
+		return begin;
+	if (negative && acc) {
+		base_type::value = static_cast< T >(-static_cast< T >(acc - 1) - 1);
+	} else {
+		base_type::value = static_cast< T >(acc);
+	}
+	return c;
+}
+
+template < typename T >
+template < typename InputIterator >
+InputIterator
+text_data_parser< T, FLOATING_POINT >::operator()(InputIterator begin, InputIterator end)
+{
+	typedef std::iterator_traits< InputIterator > iter_traits;
+	typedef typename iter_traits::value_type iter_value_type;
+	static_assert(std::is_same< iter_value_type, byte >::type::value,
+			"Input iterator must be over a char container");
+
+	char buffer[64];
+	std::size_t n{0};
+	InputIterator c = begin;
+	for (; c != end && *c && n < sizeof(buffer) - 1; ++c) {
+		buffer[n++] = *c;
+	}
+	buffer[n] = 0;
+	char* e = buffer;
+	T tmp{0};
+	if (c != end && *c) {
+		// Doesn't fit the buffer, shouldn't happen for a float value
+		std::string str(begin, end);
+		char* se = nullptr;
+		tmp = string_to_floating(str.c_str(), &se, T{});
+		if (se == str.c_str())
+			return begin;
+		base_type::value = tmp;
+		return begin + (se - str.c_str());
+	}
+	tmp = string_to_floating(buffer, &e, T{});
+	if (e == buffer)
+		return begin;
+	base_type::value = tmp;
+	return begin + (e - buffer);
+}
+
+}  // namespace detail
+
 template < typename InputIterator >
 InputIterator
 protocol_parser< std::string, TEXT_DATA_FORMAT >::operator ()
@@ -126,10 +232,19 @@ protocol_parser< bool, TEXT_DATA_FORMAT >::operator()
 	static_assert(std::is_same< iter_value_type, byte >::type::value,
 			"Input iterator must be over a char container");
 
-	std::string literal;
-	iterator_type tmp = protocol_read< TEXT_DATA_FORMAT >(begin, end, literal);
-	if (use_literal(literal)) {
-		return tmp;
+	// The longest literal is 'false'
+	char literal[6];
+	std::size_t n{0};
+	iterator_type c = begin;
+	for (; c != end && *c && n < sizeof(literal); ++c) {
+		literal[n++] = *c;
+	}
+	if (c != end && *c)
+		return begin;
+	if (c != end)
+		++c;
+	if (use_literal(literal, n)) {
+		return c;
 	}
 	return begin;
 }
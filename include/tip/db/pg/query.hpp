@@ -11,6 +11,7 @@
 #include <tip/db/pg/future_config.hpp>
 #include <tip/db/pg/common.hpp>
 #include <tip/db/pg/resultset.hpp>
+#include <tip/db/pg/detail/fiber_wait.hpp>
 
 #include <memory>
 #include <functional>
@@ -186,15 +187,34 @@ public:
     resultset
     operator()() const
     { return run<_Promise>(); }
+#ifdef WITH_BOOST_FIBERS
+    /**
+     * Run query suspending the calling fiber until the resultset is fully
+     * transferred from database. No promise is allocated. For a query of
+     * several statements the result of the first one is returned.
+     * @return
+     */
+    resultset
+    run(fiber_yield const& yield) const;
+    /**
+     * Shortcut for @ref tip::db::pg::query::run(fiber_yield const&)
+     * @return
+     */
+    resultset
+    operator()(fiber_yield const& yield) const
+    { return run(yield); }
+#endif
 private:
     using params_buffer = std::vector<byte>;
     struct impl;
     using pimpl = std::shared_ptr<impl>;
 
-    type_oid_sequence&
-    param_types();
-    params_buffer&
-    buffer();
+    /**
+     * Replace the parameters of the query. Runs that are already started
+     * keep the parameters they were started with.
+     */
+    void
+    set_params(type_oid_sequence&& param_types, params_buffer&& params);
     mutable pimpl pimpl_;
 private:
     template < typename ... T >
@@ -37,7 +37,20 @@ struct nth_param {
     static bool
     write_value (std::vector<byte>& buffer, type const& value)
     {
-        return write_value_impl(buffer, value, io::traits::is_nullable<type>{});
+        return write_value(buffer, value, size(value));
+    }
+
+    /**
+     * Write the value preceded by its length
+     * @param buffer
+     * @param value
+     * @param size size of the value as returned by nth_param::size
+     * @return
+     */
+    static bool
+    write_value (std::vector<byte>& buffer, type const& value, integer size)
+    {
+        return write_value_impl(buffer, value, size, io::traits::is_nullable<type>{});
     }
 
     static integer
@@ -47,31 +60,30 @@ struct nth_param {
     }
 private:
     inline static bool
-    write_value_impl(std::vector<byte>& buffer, type const& value, ::std::true_type const&)
+    write_value_impl(std::vector<byte>& buffer, type const& value, integer size,
+            ::std::true_type const&)
     {
         typedef io::traits::nullable_traits< type >    nullable_traits;
         if (!nullable_traits::is_null(value)) {
-            return write_value_impl(buffer, value, ::std::false_type{});
+            return write_value_impl(buffer, value, size, ::std::false_type{});
         }
         // Write null marker
         return io::protocol_write< BINARY_DATA_FORMAT >( buffer, (integer)-1 );
     }
     inline static bool
-    write_value_impl(std::vector<byte>& buffer, type const& value, ::std::false_type const&)
+    write_value_impl(std::vector<byte>& buffer, type const& value, integer size,
+            ::std::false_type const&)
     {
-        size_t buffer_pos = buffer.size();
-        // space for length
-        buffer.resize(buffer.size() + sizeof(integer));
-        size_t prev_size = buffer.size();
+        integer len = size - sizeof(integer);
+        io::protocol_write< BINARY_DATA_FORMAT >( buffer, len );
+        size_t start = buffer.size();
         io::protocol_write< data_format >(buffer, value);
-        integer len = buffer.size() - prev_size;
-        // write length
-        std::vector<byte>::iterator sz_iter = buffer.begin() +
-                buffer_pos;
-        io::protocol_write< BINARY_DATA_FORMAT >( sz_iter, len );
-        integer written(0);
-        io::protocol_read< BINARY_DATA_FORMAT > (sz_iter, sz_iter + sizeof(integer), written);
-        assert(written == len && "Length is written ok");
+        integer written = buffer.size() - start;
+        if (written != len) {
+            // The formatter's size is an estimate, fix the length
+            io::protocol_write< BINARY_DATA_FORMAT >(
+                    buffer.begin() + (start - sizeof(integer)), written );
+        }
         return true;
     }
 
@@ -123,9 +135,15 @@ struct nth_param < Index, boost::optional< T > > {
 
     static bool
     write_value (std::vector<byte>& buffer, boost::optional<type> const& value)
+    {
+        return write_value(buffer, value, size(value));
+    }
+    static bool
+    write_value (std::vector<byte>& buffer, boost::optional<type> const& value,
+            integer size)
     {
         if (value.is_initialized()) {
-            return nth_param< Index, T >::write_value( buffer, *value );
+            return nth_param< Index, T >::write_value( buffer, *value, size );
         }
         // NULL value
         return io::protocol_write< BINARY_DATA_FORMAT >( buffer, (integer)-1 );
@@ -134,7 +152,7 @@ struct nth_param < Index, boost::optional< T > > {
     size(boost::optional<type> const& value)
     {
         if (value.is_initialized())
-            return io::protocol_writer< data_format >(*value).size() + sizeof(integer);
+            return nth_param< Index, T >::size(*value);
         return sizeof(integer);
     }
 };
@@ -174,15 +192,22 @@ struct format_selector< 0, T > {
     }
 
     static void
-    write_param_value( std::vector<byte>& buffer, type const& value)
+    write_param_value( std::vector<byte>& buffer, integer const* sizes,
+            type const& value)
     {
-        nth_param<index, T>::write_value(buffer, value);
+        nth_param<index, T>::write_value(buffer, value, *sizes);
     }
 
+    /**
+     * Calculate output sizes of the parameters
+     * @param sizes array to store size of each parameter
+     * @return total size of the parameters
+     */
     static size_t
-    size( type const& value )
+    size( integer* sizes, type const& value )
     {
-        return nth_param< index, T >::size(value);
+        *sizes = nth_param< index, T >::size(value);
+        return *sizes;
     }
 };
 
@@ -223,16 +248,17 @@ struct format_selector< N, T, Y ... > {
     }
 
     static void
-    write_param_value( std::vector<byte>& buffer, type const& value,
-            Y const& ... next )
+    write_param_value( std::vector<byte>& buffer, integer const* sizes,
+            type const& value, Y const& ... next )
     {
-        nth_param<index, T>::write_value(buffer, value);
-        next_param_type::write_param_value(buffer, next ...);
+        nth_param<index, T>::write_value(buffer, value, *sizes);
+        next_param_type::write_param_value(buffer, sizes + 1, next ...);
     }
     static size_t
-    size( type const& value, Y const& ... next )
+    size( integer* sizes, type const& value, Y const& ... next )
     {
-        return nth_param< index, T >::size(value) + next_param_type::size(next ...);
+        *sizes = nth_param< index, T >::size(value);
+        return *sizes + next_param_type::size(sizes + 1, next ...);
     }
 };
 
@@ -269,20 +295,24 @@ struct param_format_builder< true, util::indexes_tuple< Indexes ... >, T ... > {
     static constexpr protocol_data_format  data_format = first_selector::data_format;
 
 
-    bool
-    static write_params( type_oid_sequence& param_types, std::vector<byte>& buffer,
-            T const& ... args )
+    static void
+    write_types( type_oid_sequence& param_types )
     {
         param_types.reserve(size);
         first_selector::write_type(param_types);
+    }
 
+    bool
+    static write_values( std::vector<byte>& buffer, T const& ... args )
+    {
+        integer sizes[size];
         size_t sz = sizeof(smallint) * 2 //text data format + count of params
-                + first_selector::size(args ...); // size of params
-        buffer.reserve(sz);
+                + first_selector::size(sizes, args ...); // size of params
+        buffer.reserve(buffer.size() + sz);
 
         io::protocol_write<BINARY_DATA_FORMAT>(buffer, (smallint)data_format);
         io::protocol_write<BINARY_DATA_FORMAT>(buffer, (smallint)size);
-        first_selector::write_param_value(buffer, args ...);
+        first_selector::write_param_value(buffer, sizes, args ...);
         return true;
     }
 
@@ -302,22 +332,26 @@ struct param_format_builder< false, util::indexes_tuple< Indexes ... >, T ... >
     static constexpr protocol_data_format  data_format = first_selector::data_format;
 
 
-    bool
-    static write_params( type_oid_sequence& param_types, std::vector<byte>& buffer,
-            T const& ... args )
+    static void
+    write_types( type_oid_sequence& param_types )
     {
         param_types.reserve(size);
         first_selector::write_type(param_types);
+    }
 
+    bool
+    static write_values( std::vector<byte>& buffer, T const& ... args )
+    {
+        integer sizes[size];
         size_t sz = sizeof(smallint) * 2 // data format count + count of params
                 + sizeof(smallint) * size // data formats
-                + first_selector::size(args ...); // params
-        buffer.reserve(sz);
+                + first_selector::size(sizes, args ...); // params
+        buffer.reserve(buffer.size() + sz);
 
         io::protocol_write<BINARY_DATA_FORMAT>(buffer, (smallint)size);
         first_selector::write_format(buffer);
         io::protocol_write<BINARY_DATA_FORMAT>(buffer, (smallint)size);
-        first_selector::write_param_value(buffer, args ...);
+        first_selector::write_param_value(buffer, sizes, args ...);
         return true;
     }
 
@@ -329,7 +363,18 @@ struct param_formatter : param_format_builder <
         is_text_format< T ... >::value,
         typename util::index_builder< sizeof ... (T) >::type,
         T ... > {
+    typedef param_format_builder <
+            is_text_format< T ... >::value,
+            typename util::index_builder< sizeof ... (T) >::type,
+            T ... > base_type;
 
+    static bool
+    write_params( type_oid_sequence& param_types, std::vector<byte>& buffer,
+            T const& ... args )
+    {
+        base_type::write_types(param_types);
+        return base_type::write_values(buffer, args ...);
+    }
 };
 
 struct ___no_binary_format {};
@@ -350,6 +395,41 @@ write_params(std::vector< oids::type::oid_type >& param_types,
     param_formatter< T ... >::write_params(param_types, buffer, params ...);
 }
 
+/**
+ * Write PostgreSQL type oids of parameter types
+ */
+template < typename ... T >
+struct param_types_writer {
+    static void
+    write(type_oid_sequence& param_types)
+    {
+        param_formatter< T ... >::write_types(param_types);
+    }
+};
+
+template < >
+struct param_types_writer< > {
+    static void
+    write(type_oid_sequence&)
+    {
+    }
+};
+
+/**
+ * Write parameter values without the types
+ */
+template < typename ... T >
+void
+write_param_values(std::vector<byte>& buffer, T const& ... params)
+{
+    param_formatter< T ... >::write_values(buffer, params ...);
+}
+
+inline void
+write_param_values(std::vector<byte>&)
+{
+}
+
 }  // namespace detail
 
 template < typename ... T >
@@ -408,11 +488,10 @@ query::bind(T const& ... params)
     // 2. Params
     //  - write the number of params
     //  - write each param preceded by it's length
-    type_oid_sequence& ptypes = param_types();
-    ptypes.clear();
-    params_buffer& buf = buffer();
-    buf.clear();
+    type_oid_sequence ptypes;
+    params_buffer buf;
     detail::write_params(ptypes, buf, params ...);
+    set_params(std::move(ptypes), std::move(buf));
     return *this;
 }
 
@@ -439,6 +518,30 @@ query::run_async() const
     return promise->get_future();
 }
 
+#ifdef WITH_BOOST_FIBERS
+inline resultset
+query::run(fiber_yield const& yield) const
+{
+    detail::fiber_wait< resultset > waiter{ yield };
+    auto w = waiter.handle();
+
+    run_async(
+        [w](transaction_ptr trx, resultset r, bool complete)
+        {
+            if (complete) {
+                w.set_value(r);
+            }
+        },
+        [w](error::db_error const& e)
+        {
+            w.set_error(e);
+        }
+    );
+
+    return waiter.get();
+}
+#endif
+
 }  // namespace pg
 }  // namespace db
 }  // namespace tip
@@ -12,11 +12,13 @@
 #include <tip/db/pg/common.hpp>
 #include <tip/db/pg/error.hpp>
 #include <tip/db/pg/protocol_io_traits.hpp>
+#include <tip/db/pg/row_mapping.hpp>
 
 #include <iterator>
 #include <istream>
 #include <memory>
 #include <tuple>
+#include <vector>
 
 namespace tip {
 namespace db {
@@ -24,6 +26,7 @@ namespace pg {
 
 namespace detail {
 struct result_impl;
+class column_reader;
 }
 
 /**
@@ -149,6 +152,24 @@ public:
     at(size_type index) const;
     //@}
 
+    /**
+     * Extract all rows of the result set to a vector of structures.
+     * The structure must have an io::traits::row_mapping specialization.
+     * Column names are resolved to indexes and the way of parsing each
+     * column is chosen once for the whole result set, not for every row.
+     * @code
+     * std::vector< person > persons;
+     * res.to(persons);
+     * @endcode
+     * @param rows target vector, previous contents are replaced
+     * @exception tip::db::pg::db_error if a mapped column is missing
+     * @exception tip::db::pg::value_is_null if a null value is met for
+     *     a member that is not 'nullable'
+     */
+    template < typename T >
+    void
+    to(std::vector< T >& rows) const;
+
     //@{
     /** @name Result checking */
     /**
@@ -429,11 +450,15 @@ public:
         to_impl( T& val, std::true_type const& ) const
         {
             field_description const& fd = description();
-            field_buffer b = input_buffer();
             if (fd.format_code == TEXT_DATA_FORMAT) {
-                io::protocol_read< TEXT_DATA_FORMAT >(b.begin(), b.end(), val);
+                read< TEXT_DATA_FORMAT >(val,
+                        io::traits::has_raw_parser<T, TEXT_DATA_FORMAT>() );
+            } else if (io::traits::binary_compatible<T>::accepts(fd.type_oid)) {
+                read< BINARY_DATA_FORMAT >(val,
+                        io::traits::has_raw_parser<T, BINARY_DATA_FORMAT>() );
             } else {
-                io::protocol_read< BINARY_DATA_FORMAT >(b.begin(), b.end(), val);
+                return binary_as_text(val,
+                        io::traits::has_parser<T, TEXT_DATA_FORMAT>() );
             }
             return true;
         }
@@ -441,14 +466,66 @@ public:
         template < typename T >
         bool
         to_impl( T& val, std::false_type const& ) const
+        {
+            if (description().format_code == BINARY_DATA_FORMAT) {
+                return binary_as_text(val, std::true_type{});
+            }
+            read< TEXT_DATA_FORMAT >(val,
+                    io::traits::has_raw_parser<T, TEXT_DATA_FORMAT>() );
+            return true;
+        }
+
+        /**
+         * Read the value in place from the field data
+         */
+        template < protocol_data_format F, typename T >
+        void
+        read( T& val, std::true_type const& ) const
+        {
+            std::size_t size = 0;
+            char const* data = raw_data(size);
+            io::protocol_read< F >(data, size, val);
+        }
+        /**
+         * Read the value via an input buffer
+         */
+        template < protocol_data_format F, typename T >
+        void
+        read( T& val, std::false_type const& ) const
+        {
+            field_buffer b = input_buffer();
+            io::protocol_read< F >(b.begin(), b.end(), val);
+        }
+
+        /**
+         * Convert a binary field value to text and read it with a text
+         * parser. Used when the type requested cannot be read from the
+         * binary representation of the field.
+         */
+        template < typename T >
+        bool
+        binary_as_text( T& val, std::true_type const& ) const
         {
             field_buffer b = input_buffer();
-            io::protocol_read< TEXT_DATA_FORMAT >(b.begin(), b.end(), val);
+            std::string text;
+            if (!io::binary_to_text(description().type_oid, b.begin(), b.end(), text))
+                throw error::db_error{
+                    "Cannot convert binary value of field " + name() + " to text"};
+            io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), val);
             return true;
         }
+        template < typename T >
+        bool
+        binary_as_text( T&, std::false_type const& ) const
+        {
+            throw error::db_error{
+                "Type requested has no parser for binary value of field " + name()};
+        }
 
         field_buffer
         input_buffer() const;
+        char const*
+        raw_data(std::size_t& size) const;
     protected:
         friend class resultset;
         friend class row;
@@ -732,17 +809,75 @@ public:
     std::string const&
     field_name(size_type col_index) const;
     //@}
+
+    //@{
+    /**
+     * @name Column extraction
+     * Read values of a single column for all rows at once. The way to parse
+     * the column is chosen once, fixed size binary values (int2, int4, int8,
+     * float4, float8) are copied and converted from network byte order in
+     * bulk.
+     * @code
+     * std::vector< bigint > ids = res.column< bigint >("id");
+     * std::vector< double > prices;
+     * res.column(1, prices);
+     * @endcode
+     * @exception std::out_of_range if the column index is out of range
+     * @exception tip::db::pg::db_error if there is no column with the name
+     * @exception tip::db::pg::value_is_null if a null value is met and the
+     *     type requested is not 'nullable'
+     */
+    template < typename T >
+    std::vector< T >
+    column(size_type col_index) const;
+    template < typename T >
+    std::vector< T >
+    column(std::string const& name) const;
+    template < typename T >
+    void
+    column(size_type col_index, std::vector< T >& values) const;
+    template < typename T >
+    void
+    column(std::string const& name, std::vector< T >& values) const;
+    /**
+     * Read the column values to a user-provided array
+     * @param values array of at least size() elements
+     * @param count number of elements in the array
+     */
+    template < typename T >
+    void
+    column(size_type col_index, T* values, size_type count) const;
+    //@}
 private:
     friend class row;
     friend class field;
+    friend class detail::column_reader;
     typedef std::shared_ptr<const detail::result_impl> const_result_impl_ptr;
     const_result_impl_ptr pimpl_;
 
     field_buffer
     at(size_type r, row::size_type c) const;
+    /**
+     * Pointer to the field data, without building an input buffer
+     * @param size receives the size of the field data
+     */
+    char const*
+    raw_data(size_type r, row::size_type c, std::size_t& size) const;
 
     bool
     is_null(size_type r, row::size_type c) const;
+
+    /**
+     * Copy binary values of a column to a contiguous array converting them
+     * from network byte order.
+     * @param c column index
+     * @param width size of a single value
+     * @param out array of size() * width bytes
+     * @return false if the column contains nulls or values of other size,
+     *     the contents of the array is unspecified then.
+     */
+    bool
+    read_fixed_width(row::size_type c, std::size_t width, void* out) const;
 }; // resultset
 
 inline resultset::row::difference_type
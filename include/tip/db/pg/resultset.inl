@@ -100,6 +100,316 @@ template < typename ... T >
 struct row_data_by_name_extractor
     : field_by_name_extractor< typename util::index_builder< sizeof ... (T) >::type, T ... > {};
 
+/**
+ * Type of a value parsed for a mapped member
+ */
+template < typename T >
+struct mapped_value {
+    typedef T type;
+};
+
+template < typename T >
+struct mapped_value< boost::optional< T > > {
+    typedef T type;
+};
+
+/**
+ * Types that can be copied from a binary column as a contiguous array of
+ * fixed size values, converting only the byte order.
+ */
+template < typename T >
+struct fixed_width_binary : std::false_type {};
+template < >
+struct fixed_width_binary< smallint > : std::true_type {};
+template < >
+struct fixed_width_binary< integer > : std::true_type {};
+template < >
+struct fixed_width_binary< bigint > : std::true_type {};
+template < >
+struct fixed_width_binary< float > : std::true_type {};
+template < >
+struct fixed_width_binary< double > : std::true_type {};
+
+/**
+ * Reads values of a single column of a result set. The way to parse the
+ * column (text, binary or binary converted to text) is selected once on
+ * construction for the type that will be read.
+ */
+class column_reader {
+public:
+    /**
+     * Create a reader for a column by index
+     * @tparam T type of the values that will be read
+     * @exception std::out_of_range if the index is out of range
+     * @exception tip::db::pg::db_error if the column cannot be read as T
+     */
+    template < typename T >
+    static column_reader
+    create(resultset const& res, resultset::size_type index)
+    {
+        typedef typename mapped_value< T >::type value_type;
+        field_description const& fd = res.field(index);
+        read_mode mode = read_text;
+        if (fd.format_code == BINARY_DATA_FORMAT) {
+            if (io::traits::has_parser< value_type, BINARY_DATA_FORMAT >::value
+                    && io::traits::binary_compatible< value_type >::accepts(fd.type_oid)) {
+                mode = read_binary;
+            } else if (io::traits::has_parser< value_type, TEXT_DATA_FORMAT >::value) {
+                mode = read_binary_as_text;
+            } else {
+                throw error::db_error{
+                    "Type requested has no parser for binary value of field " + fd.name};
+            }
+        }
+        return column_reader{ res,
+            static_cast< resultset::row::size_type >(index), fd, mode };
+    }
+    /**
+     * Create a reader for a column by name
+     * @exception tip::db::pg::db_error if there is no column with the name
+     */
+    template < typename T >
+    static column_reader
+    create(resultset const& res, std::string const& name)
+    {
+        resultset::size_type index = res.index_of_name(name);
+        if (index == resultset::npos)
+            throw error::db_error{ "No field with name " + name + " in the result set" };
+        return create< T >(res, index);
+    }
+
+    resultset::row::size_type
+    index() const
+    { return index_; }
+
+    /**
+     * Read the column value in a row
+     * @exception tip::db::pg::value_is_null
+     */
+    template < typename T >
+    void
+    read(resultset::size_type row, T& val) const
+    {
+        if (result_->is_null(row, index_)) {
+            set_null(val, io::traits::is_nullable< T >{});
+        } else {
+            parse(row, val);
+        }
+    }
+    template < typename T >
+    void
+    read(resultset::size_type row, boost::optional< T >& val) const
+    {
+        if (result_->is_null(row, index_)) {
+            val = boost::optional< T >{};
+        } else {
+            T tmp;
+            parse(row, tmp);
+            val = boost::optional< T >{ std::move(tmp) };
+        }
+    }
+
+    /**
+     * Read values of the column for all rows to an array. Fixed size
+     * binary values are copied as a whole and converted from network
+     * byte order in bulk.
+     * @param values array, must have room for all rows of the result set
+     */
+    template < typename T >
+    void
+    read_all(T* values) const
+    {
+        if (!read_fixed_width(values, fixed_width_binary< T >{})) {
+            for (resultset::size_type r = 0; r < result_->size(); ++r) {
+                read(r, values[r]);
+            }
+        }
+    }
+    template < typename T >
+    void
+    read_all(std::vector< T >& values) const
+    {
+        values.resize(result_->size());
+        read_all(values.data());
+    }
+    void
+    read_all(std::vector< bool >& values) const
+    {
+        values.resize(result_->size());
+        for (resultset::size_type r = 0; r < result_->size(); ++r) {
+            bool val;
+            read(r, val);
+            values[r] = val;
+        }
+    }
+private:
+    enum read_mode {
+        read_text,
+        read_binary,
+        read_binary_as_text
+    };
+
+    column_reader(resultset const& res, resultset::row::size_type index,
+            field_description const& fd, read_mode mode)
+        : result_(&res), index_(index), description_(&fd), mode_(mode) {}
+
+    template < typename T >
+    bool
+    read_fixed_width(T* values, std::true_type const&) const
+    {
+        return mode_ == read_binary
+                && result_->read_fixed_width(index_, sizeof(T), values);
+    }
+    template < typename T >
+    bool
+    read_fixed_width(T*, std::false_type const&) const
+    {
+        return false;
+    }
+
+    template < typename T >
+    void
+    set_null(T& val, std::true_type const&) const
+    {
+        io::traits::nullable_traits< T >::set_null(val);
+    }
+    template < typename T >
+    void
+    set_null(T&, std::false_type const&) const
+    {
+        throw error::value_is_null(description_->name);
+    }
+
+    template < typename T >
+    void
+    parse(resultset::size_type row, T& val) const
+    {
+        switch (mode_) {
+            case read_binary:
+                parse_binary(row, val,
+                        io::traits::has_parser< T, BINARY_DATA_FORMAT >{});
+                break;
+            case read_binary_as_text:
+                parse_binary_as_text(row, val,
+                        io::traits::has_parser< T, TEXT_DATA_FORMAT >{});
+                break;
+            default:
+                read_data< TEXT_DATA_FORMAT >(row, val,
+                        io::traits::has_raw_parser< T, TEXT_DATA_FORMAT >{});
+                break;
+        }
+    }
+
+    template < typename T >
+    void
+    parse_binary(resultset::size_type row, T& val, std::true_type const&) const
+    {
+        read_data< BINARY_DATA_FORMAT >(row, val,
+                io::traits::has_raw_parser< T, BINARY_DATA_FORMAT >{});
+    }
+    template < typename T >
+    void
+    parse_binary(resultset::size_type, T&, std::false_type const&) const
+    {
+    }
+
+    template < protocol_data_format F, typename T >
+    void
+    read_data(resultset::size_type row, T& val, std::true_type const&) const
+    {
+        std::size_t size = 0;
+        char const* data = result_->raw_data(row, index_, size);
+        io::protocol_read< F >(data, size, val);
+    }
+    template < protocol_data_format F, typename T >
+    void
+    read_data(resultset::size_type row, T& val, std::false_type const&) const
+    {
+        field_buffer b = result_->at(row, index_);
+        io::protocol_read< F >(b.begin(), b.end(), val);
+    }
+
+    template < typename T >
+    void
+    parse_binary_as_text(resultset::size_type row, T& val, std::true_type const&) const
+    {
+        field_buffer b = result_->at(row, index_);
+        std::string text;
+        if (!io::binary_to_text(description_->type_oid, b.begin(), b.end(), text))
+            throw error::db_error{
+                "Cannot convert binary value of field "
+                    + description_->name + " to text"};
+        io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), val);
+    }
+    template < typename T >
+    void
+    parse_binary_as_text(resultset::size_type, T&, std::false_type const&) const
+    {
+    }
+
+    resultset const*            result_;
+    resultset::row::size_type    index_;
+    field_description const*    description_;
+    read_mode                    mode_;
+};
+
+/**
+ * Reads rows of a result set to structures described by
+ * io::traits::row_mapping. Columns are looked up by name and the way
+ * to parse them is selected on construction, reading a row only walks
+ * the precomputed column list.
+ */
+template < typename T >
+class row_mapper {
+public:
+    typedef T value_type;
+    typedef io::traits::row_mapping< T > mapping_type;
+
+    explicit
+    row_mapper(resultset const& res) : result_(res)
+    {
+        column_resolver resolver{ *this };
+        mapping_type::visit(resolver);
+    }
+
+    void
+    read(resultset::size_type row, value_type& val) const
+    {
+        row_reader reader{ row, val, columns_.begin() };
+        mapping_type::visit(reader);
+    }
+private:
+    typedef std::vector< column_reader > columns_type;
+
+    struct column_resolver {
+        row_mapper& mapper;
+
+        template < typename M >
+        void
+        operator()(char const* name, M value_type::* )
+        {
+            mapper.columns_.push_back(
+                    column_reader::create< M >(mapper.result_, name));
+        }
+    };
+
+    struct row_reader {
+        resultset::size_type                    row;
+        value_type&                                target;
+        typename columns_type::const_iterator    col;
+
+        template < typename M >
+        void
+        operator()(char const*, M value_type::* member)
+        {
+            (col++)->read(row, target.*member);
+        }
+    };
+
+    resultset const&    result_;
+    columns_type        columns_;
+};
+
 }  // namespace detail
 
 template < typename ... T >
@@ -151,6 +461,65 @@ resultset::row::to(::std::initializer_list<::std::string> const& names,
     detail::row_data_by_name_extractor<T...>::get_values(*this, names, val...);
 }
 
+template < typename T >
+void
+resultset::to(std::vector< T >& rows) const
+{
+    detail::row_mapper< T > mapper(*this);
+    std::vector< T > tmp(size());
+    for (size_type r = 0; r < tmp.size(); ++r) {
+        mapper.read(r, tmp[r]);
+    }
+    rows.swap(tmp);
+}
+
+template < typename T >
+void
+resultset::column(size_type col_index, std::vector< T >& values) const
+{
+    detail::column_reader reader = detail::column_reader::create< T >(*this, col_index);
+    std::vector< T > tmp;
+    reader.read_all(tmp);
+    values.swap(tmp);
+}
+
+template < typename T >
+void
+resultset::column(std::string const& name, std::vector< T >& values) const
+{
+    detail::column_reader reader = detail::column_reader::create< T >(*this, name);
+    std::vector< T > tmp;
+    reader.read_all(tmp);
+    values.swap(tmp);
+}
+
+template < typename T >
+void
+resultset::column(size_type col_index, T* values, size_type count) const
+{
+    if (count < size())
+        throw std::out_of_range("Buffer is too small for the column values");
+    detail::column_reader::create< T >(*this, col_index).read_all(values);
+}
+
+template < typename T >
+std::vector< T >
+resultset::column(size_type col_index) const
+{
+    std::vector< T > values;
+    column(col_index, values);
+    return values;
+}
+
+template < typename T >
+std::vector< T >
+resultset::column(std::string const& name) const
+{
+    std::vector< T > values;
+    column(name, values);
+    return values;
+}
+
 }  // namespace pg
 }  // namespace db
 }  // namespace tip
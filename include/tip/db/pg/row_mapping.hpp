@@ -0,0 +1,83 @@
+/*
+ * row_mapping.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_ROW_MAPPING_HPP_
+#define LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_ROW_MAPPING_HPP_
+
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/stringize.hpp>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace io {
+namespace traits {
+
+/**
+ * Mapping of result set columns to members of a structure.
+ * Specialization must provide a static visit function template, that
+ * calls the visitor with a column name and a pointer to member for every
+ * mapped field:
+ * @code
+ * struct person {
+ *     integer                        id;
+ *     std::string                    name;
+ *     boost::optional<std::string>   email;
+ * };
+ *
+ * namespace tip { namespace db { namespace pg { namespace io { namespace traits {
+ * template < >
+ * struct row_mapping< person > {
+ *     template < typename Visitor >
+ *     static void
+ *     visit(Visitor& v)
+ *     {
+ *         v("id",            &person::id);
+ *         v("person_name",   &person::name);
+ *         v("email",         &person::email);
+ *     }
+ * };
+ * }}}}}
+ * @endcode
+ * When column names match the member names, the PG_ASYNC_ROW_MAPPING macro
+ * can be used instead.
+ * @see resultset::to(std::vector<T>&)
+ */
+template < typename T >
+struct row_mapping;
+
+}  // namespace traits
+}  // namespace io
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+/** @cond */
+#define PG_ASYNC_ROW_MAPPING_FIELD(r, Struct, member) \
+    v(BOOST_PP_STRINGIZE(member), &Struct::member);
+/** @endcond */
+
+/**
+ * Declare a row mapping for a structure with column names equal to member
+ * names. Must be used in the global namespace, the structure name must be
+ * fully qualified.
+ * @code
+ * PG_ASYNC_ROW_MAPPING(::app::person, (id)(name)(email))
+ * @endcode
+ */
+#define PG_ASYNC_ROW_MAPPING(Struct, members) \
+namespace tip { namespace db { namespace pg { namespace io { namespace traits { \
+template < > \
+struct row_mapping< Struct > { \
+    template < typename Visitor > \
+    static void \
+    visit(Visitor& v) \
+    { BOOST_PP_SEQ_FOR_EACH(PG_ASYNC_ROW_MAPPING_FIELD, Struct, members) } \
+}; \
+}}}}}
+
+#endif /* LIB_PG_ASYNC_INCLUDE_TIP_DB_PG_ROW_MAPPING_HPP_ */
@@ -2,6 +2,7 @@
 #define TIP_DB_PG_SQLSTATES_HPP_
 
 #include <string>
+#include <cstddef>
 
 namespace tip {
 namespace db {
@@ -366,8 +367,21 @@ enum code {
 	index_corrupted, /**< XX002 */
 };
 
+/**
+ * Get the code for a SQLSTATE string
+ * @return the code, unknown_code if the string is not a known SQLSTATE
+ */
 code
 code_to_state(std::string const& val);
+code
+code_to_state(char const* val, std::size_t size);
+
+/**
+ * Get the SQLSTATE string for the code
+ * @return five character SQLSTATE, an empty string for unknown_code
+ */
+char const*
+state_to_code(code val);
 
 } // namespace sqlstate
 }  // namespace pg
@@ -15,6 +15,7 @@
 #include <tip/db/pg/common.hpp>
 #include <tip/db/pg/future_config.hpp>
 #include <tip/db/pg/error.hpp>
+#include <tip/db/pg/detail/fiber_wait.hpp>
 
 namespace tip {
 namespace db {
@@ -110,6 +111,29 @@ public:
         auto future = commit_future();
         future.get();
     }
+#ifdef WITH_BOOST_FIBERS
+    /**
+     * Commit the transaction suspending the calling fiber, no promise
+     * is allocated.
+     */
+    void
+    commit(fiber_yield const& yield)
+    {
+        detail::fiber_wait< void > waiter{ yield };
+        auto w = waiter.handle();
+        commit_async(
+        [w]()
+        {
+            w.set_value();
+        },
+        [w](error::db_error const& err)
+        {
+            w.set_error(err);
+        }
+        );
+        waiter.get();
+    }
+#endif
 
     void
     rollback_async(notification_callback = notification_callback(),
@@ -138,14 +162,41 @@ public:
         auto future = rollback_future();
         future.get();
     }
+#ifdef WITH_BOOST_FIBERS
+    /**
+     * Rollback the transaction suspending the calling fiber, no promise
+     * is allocated.
+     */
+    void
+    rollback(fiber_yield const& yield)
+    {
+        detail::fiber_wait< void > waiter{ yield };
+        auto w = waiter.handle();
+        rollback_async(
+        [w]()
+        {
+            w.set_value();
+        },
+        [w](error::db_error const& err)
+        {
+            w.set_error(err);
+        }
+        );
+        waiter.get();
+    }
+#endif
 
     void
     execute(std::string const& query, query_result_callback,
             query_error_callback);
     void
-    execute(std::string const& query, type_oid_sequence const& param_types,
+    execute(std::string const& query, type_oid_sequence param_types,
             std::vector< byte > params_buffer,
             query_result_callback, query_error_callback);
+    void
+    execute(prepared_statement_ptr statement,
+            params_buffer_ptr params,
+            query_result_callback, query_error_callback);
 private:
     template < typename Mutex, typename TransportType, typename SharedType >
     friend struct detail::connection_fsm_def;
@@ -5,10 +5,46 @@
  *      Author: zmij
  */
 
-#include <benchmark/benchmark_api.h>
+#include <benchmark/benchmark.h>
 
 #include <afsm/fsm.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+::std::atomic< ::std::size_t > allocation_count{0};
+
+}  /* namespace  */
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void*
+operator new(::std::size_t size)
+{
+    ++allocation_count;
+    if (void* p = ::std::malloc(size ? size : 1))
+        return p;
+    throw ::std::bad_alloc{};
+}
+
+void
+operator delete(void* p) noexcept
+{
+    ::std::free(p);
+}
+
+void
+operator delete(void* p, ::std::size_t) noexcept
+{
+    ::std::free(p);
+}
+
+#pragma GCC diagnostic pop
 
 namespace afsm {
 namespace bench {
@@ -21,22 +57,30 @@ struct b_to_c {};
 struct c_to_a {};
 struct c_to_b {};
 
+/**
+ * Event with a payload of the size of a typical query event
+ */
+struct with_payload {
+    ::std::array< char, 96 >    payload;
+};
+
 }  /* namespace events */
 
 struct defer_fsm_def : ::afsm::def::state_machine_def<defer_fsm_def> {
 
     struct state_a : state<state_a> {};
     struct state_b : state<state_b> {
-        using deferred_events = type_tuple< events::a_to_b >;
+        using deferred_events = type_tuple< events::a_to_b, events::with_payload >;
     };
     struct state_c : state<state_c> {
-        using deferred_events = type_tuple< events::a_to_b >;
+        using deferred_events = type_tuple< events::a_to_b, events::with_payload >;
     };
 
     using initial_state = state_a;
 
     using transitions = transition_table<
         tr< state_a, events::a_to_b, state_b >,
+        tr< state_a, events::with_payload, state_b >,
         tr< state_b, events::b_to_c, state_c >,
         tr< state_b, events::b_to_a, state_a >,
         tr< state_c, events::c_to_a, state_a >,
@@ -56,6 +100,31 @@ enqueue_events(defer_fsm& fsm, int n)
     }
 }
 
+/**
+ * Report heap allocations made while the timer was running, per event
+ */
+class allocation_counter {
+public:
+    allocation_counter() : count_{0}, start_{0} {}
+
+    void
+    resume()
+    { start_ = allocation_count.load(); }
+    void
+    pause()
+    { count_ += allocation_count.load() - start_; }
+
+    void
+    report(::benchmark::State& state, ::std::size_t events)
+    {
+        state.counters["allocs/event"] = events ?
+                static_cast<double>(count_) / events : 0;
+    }
+private:
+    ::std::size_t count_;
+    ::std::size_t start_;
+};
+
 }  /* namespace  */
 
 void
@@ -83,9 +152,30 @@ DeferEnqueue(::benchmark::State& state)
 
     fsm.process_event(events::a_to_b{});
 
+    allocation_counter allocs;
+    allocs.resume();
     while(state.KeepRunning()) {
         ::benchmark::DoNotOptimize(fsm.process_event(events::a_to_b{}));
     }
+    allocs.pause();
+    allocs.report(state, state.iterations());
+}
+
+void
+DeferEnqueuePayload(::benchmark::State& state)
+{
+    defer_fsm fsm;
+
+    fsm.process_event(events::a_to_b{});
+
+    events::with_payload evt{};
+    allocation_counter allocs;
+    allocs.resume();
+    while(state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(fsm.process_event(evt));
+    }
+    allocs.pause();
+    allocs.report(state, state.iterations());
 }
 
 void
@@ -106,6 +196,7 @@ DeferIgnore(::benchmark::State& state)
 void
 DeferProcessOne(::benchmark::State& state)
 {
+    allocation_counter allocs;
     while(state.KeepRunning()) {
         state.PauseTiming();
         defer_fsm fsm;
@@ -113,16 +204,44 @@ DeferProcessOne(::benchmark::State& state)
         // Enqueue N events
         enqueue_events(fsm, state.range(0));
         state.ResumeTiming();
+        allocs.resume();
         fsm.process_event(events::b_to_a{});
+        allocs.pause();
+    }
+    state.SetComplexityN(state.range(0));
+    allocs.report(state, state.iterations() * state.range(0));
+}
+
+/**
+ * Defer and process N events in a machine that has already been through
+ * the same cycle, so the queues have their memory allocated.
+ */
+void
+DeferCycle(::benchmark::State& state)
+{
+    defer_fsm fsm;
+    fsm.process_event(events::a_to_b{});
+    allocation_counter allocs;
+    while(state.KeepRunning()) {
+        allocs.resume();
+        enqueue_events(fsm, state.range(0));
+        // Every transition to state_a consumes one deferred event
+        for (int i = 0; i < state.range(0); ++i) {
+            fsm.process_event(events::b_to_a{});
+        }
+        allocs.pause();
     }
     state.SetComplexityN(state.range(0));
+    allocs.report(state, state.iterations() * state.range(0));
 }
 
 BENCHMARK(DeferNoDefer);
 BENCHMARK(DeferReject);
 BENCHMARK(DeferEnqueue);
+BENCHMARK(DeferEnqueuePayload);
 BENCHMARK(DeferIgnore)->RangeMultiplier(10)->Range(1, 100000)->Complexity();
 BENCHMARK(DeferProcessOne)->RangeMultiplier(10)->Range(1, 100000)->Complexity();
+BENCHMARK(DeferCycle)->RangeMultiplier(10)->Range(1, 1000)->Complexity();
 
 }  /* namespace bench */
 }  /* namespace afsm */
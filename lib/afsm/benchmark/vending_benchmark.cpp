@@ -5,7 +5,7 @@
  *      Author: zmij
  */
 
-#include <benchmark/benchmark_api.h>
+#include <benchmark/benchmark.h>
 #include "vending_machine.hpp"
 
 namespace vending {
@@ -42,6 +42,20 @@ AFSM_ProcessSingleEvent(::benchmark::State& state)
     }
 }
 
+void
+AFSM_ProcessInStateEvent(::benchmark::State& state) // Without a state change
+{
+    vending_machine vm{ goods_storage{
+        { 0, { 10, 15.0f } },
+        { 1, { 100, 5.0f } }
+    }};
+    vm.process_event(events::power_on{});
+    vm.process_event(events::start_maintenance{ vending_machine::factory_code });
+    while (state.KeepRunning()) {
+        vm.process_event(events::set_price{ 0, 10.0f });
+    }
+}
+
 void
 AFSM_OnOffEmpty(::benchmark::State& state) // With a default transition
 {
@@ -83,10 +97,11 @@ AFSM_BuyItem(::benchmark::State& state)
 BENCHMARK(AFSM_ConstructDefault);
 BENCHMARK(AFSM_ConstructWithData);
 BENCHMARK(AFSM_ProcessSingleEvent);
+BENCHMARK(AFSM_ProcessInStateEvent);
 BENCHMARK(AFSM_OnOffEmpty);
 BENCHMARK(AFSM_OnOffLoaded);
 BENCHMARK(AFSM_BuyItem);
 
 }  /* namespace vending */
 
-BENCHMARK_MAIN()
+BENCHMARK_MAIN();
@@ -5,7 +5,7 @@
  *      Author: zmij
  */
 
-#include <benchmark/benchmark_api.h>
+#include <benchmark/benchmark.h>
 
 #include "vending_machine_msm.hpp"
 
@@ -44,6 +44,21 @@ MSM_ProcessSingleEvent(::benchmark::State& state)
     }
 }
 
+void
+MSM_ProcessInStateEvent(::benchmark::State& state) // Without a state change
+{
+    vending_machine vm{ goods_storage{
+        { 0, { 10, 15.0f } },
+        { 1, { 100, 5.0f } }
+    }};
+    vm.start();
+    vm.process_event(events::power_on{});
+    vm.process_event(events::start_maintenance{ vending_machine::factory_code });
+    while (state.KeepRunning()) {
+        vm.process_event(events::set_price{ 0, 10.0f });
+    }
+}
+
 void
 MSM_OnOffEmpty(::benchmark::State& state) // With a default transition
 {
@@ -88,6 +103,7 @@ MSM_BuyItem(::benchmark::State& state)
 BENCHMARK(MSM_ConstructDefault);
 BENCHMARK(MSM_ConstructWithData);
 BENCHMARK(MSM_ProcessSingleEvent);
+BENCHMARK(MSM_ProcessInStateEvent);
 BENCHMARK(MSM_OnOffEmpty);
 BENCHMARK(MSM_OnOffLoaded);
 BENCHMARK(MSM_BuyItem);
@@ -95,4 +111,4 @@ BENCHMARK(MSM_BuyItem);
 
 }  /* namespace vending_msm */
 
-BENCHMARK_MAIN()
+BENCHMARK_MAIN();
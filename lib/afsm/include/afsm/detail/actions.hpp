@@ -16,6 +16,25 @@ namespace afsm {
 
 namespace detail {
 
+/**
+ * Plain function calling a stateless functor. Dispatch tables are built
+ * of pointers to these functions, so a table is a constant array and a
+ * call through it is a single indirect call.
+ */
+template < typename Functor, typename Signature >
+struct functor_invocation;
+
+template < typename Functor, typename R, typename ... Args >
+struct functor_invocation< Functor, R(Args...) > {
+    using function_type = R(*)(Args...);
+
+    static R
+    invoke(Args ... args)
+    {
+        return Functor{}(::std::forward<Args>(args)...);
+    }
+};
+
 template < ::std::size_t StateIndex >
 struct set_enclosing_fsm {
     static constexpr ::std::size_t state_index = StateIndex;
@@ -470,7 +489,7 @@ public:
     using dispatch_tuple    = typename handlers_tuple<indexes_tuple>::type;
     template < typename Event >
     using invocation_table  = ::std::array<
-            ::std::function< event_process_result(states_tuple&, Event&&) >, size >;
+            event_process_result(*)(states_tuple&, Event&&), size >;
 public:
     explicit
     inner_dispatch_table() {}
@@ -482,7 +501,7 @@ public:
         //using event_type = typename ::std::decay<Event>::type;
         if (current_state >= size)
             throw ::std::logic_error{ "Invalid current state index" };
-        auto inv_table = state_table< Event >(indexes_tuple{});
+        auto const& inv_table = state_table< Event >(indexes_tuple{});
         return inv_table[current_state](states, ::std::forward<Event>(event));
     }
 private:
@@ -490,7 +509,10 @@ private:
     static invocation_table<Event> const&
     state_table( ::psst::meta::indexes_tuple< Indexes... > const& )
     {
-        static invocation_table<Event> _table {{ process_event_handler<Indexes>{}... }};
+        static constexpr invocation_table<Event> _table {{
+            &::afsm::detail::functor_invocation< process_event_handler<Indexes>,
+                event_process_result(states_tuple&, Event&&) >::invoke...
+        }};
         return _table;
     }
 };
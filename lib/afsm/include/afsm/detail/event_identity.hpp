@@ -44,6 +44,26 @@ make_event_set( ::psst::meta::type_tuple<T...> const& )
     };
 }
 
+/**
+ * Check if two event sets have common events, doesn't allocate
+ */
+inline bool
+intersects(event_set const& lhs, event_set const& rhs)
+{
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+    while (l != lhs.end() && r != rhs.end()) {
+        if (*l < *r) {
+            ++l;
+        } else if (*r < *l) {
+            ++r;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  /* namespace detail */
 }  /* namespace afsm */
 
@@ -0,0 +1,350 @@
+/*
+ * event_queue.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef AFSM_DETAIL_EVENT_QUEUE_HPP_
+#define AFSM_DETAIL_EVENT_QUEUE_HPP_
+
+#include <afsm/detail/event_identity.hpp>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace afsm {
+namespace detail {
+
+/**
+ * Type-erased event waiting in a state machine queue.
+ *
+ * An event that fits into the inline buffer and can be moved without
+ * throwing is stored in place, a larger event is allocated on heap.
+ * The event is invoked with an owner reference by a plain function pointer.
+ */
+template < typename Owner, typename Result, ::std::size_t Size = 128 >
+class queued_event {
+public:
+    using owner_type        = Owner;
+    using result_type       = Result;
+    using id_type           = event_base::id_type;
+    using invoke_function   = result_type(*)(owner_type&, void*);
+    static constexpr ::std::size_t buffer_size = Size;
+public:
+    queued_event() noexcept
+        : ops_{nullptr}, invoke_{nullptr}, id_{nullptr}, data_{nullptr}, buffer_{} {}
+
+    template < typename Event >
+    queued_event(Event&& event, invoke_function invoke, id_type const* id)
+        : ops_{&operations< typename ::std::decay<Event>::type >::table},
+          invoke_{invoke}, id_{id}, data_{nullptr}, buffer_{}
+    {
+        using event_type = typename ::std::decay<Event>::type;
+        data_ = operations<event_type>::create(buffer_, ::std::forward<Event>(event));
+    }
+
+    queued_event(queued_event&& rhs) noexcept
+        : ops_{rhs.ops_}, invoke_{rhs.invoke_}, id_{rhs.id_}, data_{nullptr}, buffer_{}
+    {
+        if (ops_) {
+            data_ = ops_->move(rhs.data_, buffer_);
+            rhs.release();
+        }
+    }
+    queued_event(queued_event const&) = delete;
+
+    ~queued_event()
+    {
+        reset();
+    }
+
+    queued_event&
+    operator = (queued_event&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            reset();
+            ops_    = rhs.ops_;
+            invoke_ = rhs.invoke_;
+            id_     = rhs.id_;
+            if (ops_) {
+                data_ = ops_->move(rhs.data_, buffer_);
+                rhs.release();
+            }
+        }
+        return *this;
+    }
+    queued_event&
+    operator = (queued_event const&) = delete;
+
+    /**
+     * Invoke the event, the stored event object is moved to the handler
+     */
+    result_type
+    operator()(owner_type& owner)
+    {
+        return invoke_(owner, data_);
+    }
+
+    id_type const*
+    id() const
+    { return id_; }
+
+    bool
+    empty() const
+    { return ops_ == nullptr; }
+    /**
+     * The event is stored in the inline buffer
+     */
+    bool
+    is_inline() const
+    { return data_ == static_cast<void const*>(&buffer_); }
+private:
+    using storage_type = typename ::std::aligned_storage< Size,
+            alignof(::std::max_align_t) >::type;
+
+    struct operations_table {
+        /**
+         * Take the event from another queued event, an inline event is moved
+         * to the buffer and the source is destroyed. Return the new address.
+         */
+        void* (*move)(void* from, storage_type& to);
+        void  (*destroy)(void*);
+    };
+
+    template < typename Event,
+        bool Inline = sizeof(Event) <= Size
+            && alignof(Event) <= alignof(storage_type)
+            && ::std::is_nothrow_move_constructible<Event>::value >
+    struct operations;
+
+    template < typename Event >
+    struct operations< Event, true > {
+        template < typename T >
+        static void*
+        create(storage_type& buffer, T&& event)
+        {
+            return new (&buffer) Event(::std::forward<T>(event));
+        }
+        static void*
+        move(void* from, storage_type& to)
+        {
+            Event* src = static_cast<Event*>(from);
+            void* res = new (&to) Event(::std::move(*src));
+            src->~Event();
+            return res;
+        }
+        static void
+        destroy(void* p)
+        {
+            static_cast<Event*>(p)->~Event();
+        }
+        static constexpr operations_table table{ &move, &destroy };
+    };
+
+    template < typename Event >
+    struct operations< Event, false > {
+        template < typename T >
+        static void*
+        create(storage_type&, T&& event)
+        {
+            return new Event(::std::forward<T>(event));
+        }
+        static void*
+        move(void* from, storage_type&)
+        {
+            return from;
+        }
+        static void
+        destroy(void* p)
+        {
+            delete static_cast<Event*>(p);
+        }
+        static constexpr operations_table table{ &move, &destroy };
+    };
+
+    void
+    reset() noexcept
+    {
+        if (ops_) {
+            ops_->destroy(data_);
+        }
+        release();
+    }
+    void
+    release() noexcept
+    {
+        ops_    = nullptr;
+        invoke_ = nullptr;
+        id_     = nullptr;
+        data_   = nullptr;
+    }
+private:
+    operations_table const* ops_;
+    invoke_function         invoke_;
+    id_type const*          id_;
+    void*                   data_;
+    storage_type            buffer_;
+};
+
+template < typename Owner, typename Result, ::std::size_t Size >
+constexpr ::std::size_t queued_event<Owner, Result, Size>::buffer_size;
+
+template < typename Owner, typename Result, ::std::size_t Size >
+template < typename Event >
+constexpr typename queued_event<Owner, Result, Size>::operations_table
+queued_event<Owner, Result, Size>::operations<Event, true>::table;
+
+template < typename Owner, typename Result, ::std::size_t Size >
+template < typename Event >
+constexpr typename queued_event<Owner, Result, Size>::operations_table
+queued_event<Owner, Result, Size>::operations<Event, false>::table;
+
+/**
+ * FIFO queue on a ring buffer. The buffer grows twice when full and is
+ * never shrunk, so a queue that has reached its working size doesn't
+ * allocate any more.
+ */
+template < typename T >
+class ring_queue {
+public:
+    using value_type        = T;
+    using size_type         = ::std::size_t;
+    using allocator_type    = ::std::allocator<T>;
+    static constexpr size_type min_capacity = 8;
+public:
+    ring_queue() noexcept
+        : buffer_{nullptr}, capacity_{0}, head_{0}, size_{0} {}
+    ring_queue(ring_queue&& rhs) noexcept
+        : buffer_{rhs.buffer_}, capacity_{rhs.capacity_},
+          head_{rhs.head_}, size_{rhs.size_}
+    {
+        rhs.buffer_     = nullptr;
+        rhs.capacity_   = 0;
+        rhs.head_       = 0;
+        rhs.size_       = 0;
+    }
+    ring_queue(ring_queue const&) = delete;
+    ~ring_queue()
+    {
+        clear();
+        if (buffer_)
+            allocator_type{}.deallocate(buffer_, capacity_);
+    }
+
+    ring_queue&
+    operator = (ring_queue&& rhs) noexcept
+    {
+        ring_queue{::std::move(rhs)}.swap(*this);
+        return *this;
+    }
+    ring_queue&
+    operator = (ring_queue const&) = delete;
+
+    void
+    swap(ring_queue& rhs) noexcept
+    {
+        using ::std::swap;
+        swap(buffer_, rhs.buffer_);
+        swap(capacity_, rhs.capacity_);
+        swap(head_, rhs.head_);
+        swap(size_, rhs.size_);
+    }
+
+    size_type
+    size() const
+    { return size_; }
+    bool
+    empty() const
+    { return size_ == 0; }
+    /**
+     * Number of elements the queue can hold without allocation
+     */
+    size_type
+    capacity() const
+    { return capacity_; }
+
+    value_type&
+    front()
+    { return buffer_[head_]; }
+    value_type const&
+    front() const
+    { return buffer_[head_]; }
+
+    /**
+     * Element at the position from the front of the queue
+     */
+    value_type&
+    operator[](size_type pos)
+    { return buffer_[index(pos)]; }
+    value_type const&
+    operator[](size_type pos) const
+    { return buffer_[index(pos)]; }
+
+    template < typename ... Args >
+    void
+    emplace_back(Args&& ... args)
+    {
+        if (size_ == capacity_)
+            grow();
+        new (buffer_ + index(size_)) value_type(::std::forward<Args>(args)...);
+        ++size_;
+    }
+    void
+    pop_front()
+    {
+        buffer_[head_].~value_type();
+        head_ = index(1);
+        --size_;
+    }
+    /**
+     * Destroy all elements, keeping the buffer
+     */
+    void
+    clear() noexcept
+    {
+        while (size_ > 0) {
+            pop_front();
+        }
+        head_ = 0;
+    }
+private:
+    size_type
+    index(size_type offset) const
+    { return (head_ + offset) & (capacity_ - 1); }
+
+    void
+    grow()
+    {
+        static_assert(::std::is_nothrow_move_constructible<value_type>::value,
+                "Queue elements must be nothrow move constructible");
+        size_type new_capacity = capacity_ ? capacity_ * 2 : min_capacity;
+        value_type* new_buffer = allocator_type{}.allocate(new_capacity);
+        for (size_type i = 0; i < size_; ++i) {
+            value_type& item = buffer_[index(i)];
+            new (new_buffer + i) value_type(::std::move(item));
+            item.~value_type();
+        }
+        if (buffer_)
+            allocator_type{}.deallocate(buffer_, capacity_);
+        buffer_     = new_buffer;
+        capacity_   = new_capacity;
+        head_       = 0;
+    }
+private:
+    value_type* buffer_;
+    /** Always a power of 2 */
+    size_type   capacity_;
+    size_type   head_;
+    size_type   size_;
+};
+
+template < typename T >
+constexpr typename ring_queue<T>::size_type ring_queue<T>::min_capacity;
+
+}  /* namespace detail */
+}  /* namespace afsm */
+
+#endif /* AFSM_DETAIL_EVENT_QUEUE_HPP_ */
@@ -421,20 +421,23 @@ public:
     using event_set         = ::afsm::detail::event_set;
 
     template < typename Event >
-    using transition_table_type = ::std::array<
-            ::std::function< actions::event_process_result(this_type&, Event&&) >, size >;
+    using transition_function = actions::event_process_result(this_type&, Event&&);
+    template < typename Event >
+    using transition_table_type = ::std::array< transition_function<Event>*, size >;
 
     template < typename Event >
-    using exit_table_type = ::std::array<
-            ::std::function< void(inner_states_tuple&, Event&&, fsm_type&) >, size >;
+    using exit_function = void(inner_states_tuple&, Event&&, fsm_type&);
+    template < typename Event >
+    using exit_table_type = ::std::array< exit_function<Event>*, size >;
 
-    using current_events_table = ::std::array<
-            ::std::function< event_set(inner_states_tuple const&) >, size >;
+    using current_events_function = event_set(inner_states_tuple const&);
+    using current_events_table = ::std::array< current_events_function*, size >;
     using available_transtions_table = ::std::array< event_set, size >;
 
     template < typename CommonBase, typename StatesTuple >
-    using cast_table_type = ::std::array< ::std::function<
-            CommonBase&( StatesTuple& ) >, size >;
+    using cast_function = CommonBase&( StatesTuple& );
+    template < typename CommonBase, typename StatesTuple >
+    using cast_table_type = ::std::array< cast_function<CommonBase, StatesTuple>*, size >;
 public:
     state_transition_table(fsm_type& fsm)
         : fsm_{&fsm},
@@ -695,14 +698,16 @@ private:
         using event_type = typename ::std::decay<Event>::type;
         using event_transitions = typename ::psst::meta::find_if<
                 def::handles_event< event_type >::template type, transitions_tuple >::type;
-        static transition_table_type< Event > _table {{
-            typename detail::transition_action_selector< fsm_type, this_type,
-                typename ::psst::meta::find_if<
-                    def::originates_from<
-                        typename inner_states_def::template type< Indexes >
-                    >::template type,
-                    event_transitions
-                >::type >::type{} ...
+        static constexpr transition_table_type< Event > _table {{
+            &::afsm::detail::functor_invocation<
+                typename detail::transition_action_selector< fsm_type, this_type,
+                    typename ::psst::meta::find_if<
+                        def::originates_from<
+                            typename inner_states_def::template type< Indexes >
+                        >::template type,
+                        event_transitions
+                    >::type >::type,
+                transition_function<Event> >::invoke ...
         }};
         return _table;
     }
@@ -710,8 +715,10 @@ private:
     static exit_table_type<Event> const&
     exit_table( ::psst::meta::indexes_tuple< Indexes... > const& )
     {
-        static exit_table_type<Event> _table {{
-            detail::final_state_exit_func<Indexes>{} ...
+        static constexpr exit_table_type<Event> _table {{
+            &::afsm::detail::functor_invocation<
+                detail::final_state_exit_func<Indexes>,
+                exit_function<Event> >::invoke ...
         }};
         return _table;
     }
@@ -719,8 +726,10 @@ private:
     static current_events_table const&
     get_current_events_table( ::psst::meta::indexes_tuple< Indexes ... > const& )
     {
-        static current_events_table _table{{
-            detail::get_current_events_func<Indexes>{} ...
+        static constexpr current_events_table _table{{
+            &::afsm::detail::functor_invocation<
+                detail::get_current_events_func<Indexes>,
+                current_events_function >::invoke ...
         }};
 
         return _table;
@@ -729,8 +738,10 @@ private:
     static current_events_table const&
     get_current_deferred_events_table( ::psst::meta::indexes_tuple< Indexes ... > const& )
     {
-        static current_events_table _table{{
-            detail::get_current_deferred_events_func<Indexes>{} ...
+        static constexpr current_events_table _table{{
+            &::afsm::detail::functor_invocation<
+                detail::get_current_deferred_events_func<Indexes>,
+                current_events_function >::invoke ...
         }};
 
         return _table;
@@ -759,8 +770,10 @@ private:
     static cast_table_type<T, StateTuple> const&
     get_cast_table( ::psst::meta::indexes_tuple< Indexes... > const& )
     {
-        static cast_table_type<T, StateTuple> _table {{
-            detail::common_base_cast_func<T, Indexes>{}...
+        static constexpr cast_table_type<T, StateTuple> _table {{
+            &::afsm::detail::functor_invocation<
+                detail::common_base_cast_func<T, Indexes>,
+                cast_function<T, StateTuple> >::invoke ...
         }};
         return _table;
     }
@@ -12,6 +12,7 @@
 #include <afsm/detail/observer.hpp>
 #include <afsm/detail/reject_policies.hpp>
 #include <afsm/detail/event_identity.hpp>
+#include <afsm/detail/event_queue.hpp>
 #include <deque>
 #include <queue>
 #include <list>
@@ -198,10 +199,9 @@ public:
     using mutex_type        = Mutex;
     using lock_guard        = typename detail::lock_guard_type<mutex_type>::type;
     using observer_wrapper  = ObserverWrapper<Observer>;
-    using event_invokation  = ::std::function< actions::event_process_result() >;
-    using event_queue_item  = ::std::pair< event_invokation, detail::event_base::id_type const* >;
-    using event_queue       = ::std::deque< event_queue_item >;
-    using deferred_queue    = ::std::list< event_queue_item >;
+    using event_invokation  = detail::queued_event< this_type, actions::event_process_result >;
+    using event_queue       = detail::ring_queue< event_invokation >;
+    using deferred_queue    = detail::ring_queue< event_invokation >;
 public:
     state_machine()
         : base_machine_type{this},
@@ -211,8 +211,10 @@ public:
           mutex_{},
           queued_events_{},
           queue_size_{0},
+          processing_{},
           deferred_top_{},
           deferred_events_{},
+          deferred_processing_{},
           deferred_event_ids_{}
       {}
     template<typename ... Args>
@@ -225,8 +227,10 @@ public:
           mutex_{},
           queued_events_{},
           queue_size_{0},
+          processing_{},
           deferred_top_{},
           deferred_events_{},
+          deferred_processing_{},
           deferred_event_ids_{}
     {}
 
@@ -261,8 +265,8 @@ public:
     clear_deferred_events()
     {
         lock_guard lock{mutex_};
-        deferred_queue{}.swap(deferred_events_);
-        detail::event_set{}.swap(deferred_event_ids_);
+        deferred_events_.clear();
+        deferred_event_ids_.clear();
     }
 private:
     template < typename Event >
@@ -275,6 +279,13 @@ private:
                         typename state_machine::handled_events>{} );
     }
 
+    template < typename Event >
+    static actions::event_process_result
+    invoke_queued_event(this_type& fsm, void* event)
+    {
+        return fsm.process_event_dispatch(::std::move(*static_cast<Event*>(event)));
+    }
+
     template < typename Event >
     actions::event_process_result
     process_event_impl(Event&& event,
@@ -345,10 +356,9 @@ private:
             lock_guard lock{mutex_};
             ++queue_size_;
             observer_wrapper::enqueue_event(*this, ::std::forward<Event>(event));
-            Event evt{::std::forward<Event>(event)};
-            queued_events_.emplace_back([&, evt]() mutable {
-                return process_event_dispatch(::std::move(evt));
-            }, &evt_identity::id);
+            queued_events_.emplace_back(::std::forward<Event>(event),
+                &invoke_queued_event<typename ::std::decay<Event>::type>,
+                &evt_identity::id);
         }
         // Process enqueued events in case we've been waiting for queue
         // mutex release
@@ -358,8 +368,10 @@ private:
     void
     lock_and_swap_queue(event_queue& queue)
     {
+        // Events left after an exception in a handler are dropped
+        queue.clear();
         lock_guard lock{mutex_};
-        ::std::swap(queued_events_, queue);
+        queued_events_.swap(queue);
         queue_size_ -= queue.size();
     }
 
@@ -369,10 +381,11 @@ private:
         while (queue_size_ > 0 && !is_top_.test_and_set()) {
             observer_wrapper::start_process_events_queue(*this);
             while (queue_size_ > 0) {
-                event_queue postponed;
-                lock_and_swap_queue(postponed);
-                for (auto const& event : postponed) {
-                    event.first();
+                // The buffers of both queues are reused, no allocations
+                // after the queues have grown to the working size
+                lock_and_swap_queue(processing_);
+                for (; !processing_.empty(); processing_.pop_front()) {
+                    processing_.front()(*this);
                 }
             }
             observer_wrapper::end_process_events_queue(*this);
@@ -387,10 +400,9 @@ private:
         using evt_identity = typename detail::event_identity<Event>::type;
 
         observer_wrapper::defer_event(*this, ::std::forward<Event>(event));
-        Event evt{::std::forward<Event>(event)};
-        deferred_events_.emplace_back([&, evt]() mutable {
-            return process_event_dispatch(::std::move(evt));
-        }, &evt_identity::id);
+        deferred_events_.emplace_back(::std::forward<Event>(event),
+            &invoke_queued_event<typename ::std::decay<Event>::type>,
+            &evt_identity::id);
         deferred_event_ids_.insert(&evt_identity::id);
     }
     void
@@ -398,61 +410,40 @@ private:
     {
         if (!deferred_top_.test_and_set()) {
             using actions::event_process_result;
-            deferred_queue deferred;
+            deferred_queue& deferred = deferred_processing_;
             detail::event_set event_ids;
+            // Events left after an exception in a handler are dropped
+            deferred.clear();
             if (skip_deferred_queue()) {
                 observer_wrapper::skip_processing_deferred_queue(*this);
             } else {
-                ::std::swap(deferred_events_, deferred);
+                deferred_events_.swap(deferred);
                 ::std::swap(deferred_event_ids_, event_ids);
             }
             while (!deferred.empty()) {
                 observer_wrapper::start_process_deferred_queue(*this, deferred.size());
                 auto res = event_process_result::refuse;
-                for (auto event = deferred.begin(); event != deferred.end();) {
-                    if (handled_.count(event->second)) {
-                        res = event->first();
-                        deferred.erase(event++);
-                    } else if (deferred_.count(event->second)) {
+                while (!deferred.empty() && res != event_process_result::process) {
+                    auto const* id = deferred.front().id();
+                    if (handled_.count(id)) {
+                        res = deferred.front()(*this);
+                        deferred.pop_front();
+                    } else if (deferred_.count(id)) {
                         // Move directly to the deferred queue
-                        ::std::size_t count{0};
-                        auto next = event;
-                        while (next != deferred.end() && next->second == event->second) {
-                            ++next;
-                            ++count;
-                        }
-                        deferred_events_.splice(deferred_events_.end(),
-                            deferred, event, next);
-                        deferred_event_ids_.insert(event->second);
-                        event = next;
-                        observer_wrapper::postpone_deferred_events(*this, count);
+                        postpone_deferred_events(deferred);
                     } else {
-                        deferred.erase(event++);
+                        deferred.pop_front();
                         observer_wrapper::drop_deferred_event(*this);
                     }
-                    if (res == event_process_result::process)
-                        break;
-                }
-                for (auto event = deferred.begin(); event != deferred.end();) {
-                    ::std::size_t count{0};
-                    auto next = event;
-                    while (next != deferred.end() && next->second == event->second) {
-                        ++count;
-                        ++next;
-                    }
-                    deferred_events_.splice(deferred_events_.end(),
-                        deferred, event, next);
-                    deferred_event_ids_.insert(event->second);
-                    event = next;
-                    observer_wrapper::postpone_deferred_events(*this, count);
                 }
+                postpone_deferred_queue(deferred);
                 event_ids.clear();
                 observer_wrapper::end_process_deferred_queue(*this, deferred_events_.size());
                 if (res == event_process_result::process) {
                     if (skip_deferred_queue()) {
                         observer_wrapper::skip_processing_deferred_queue(*this);
                     } else {
-                        ::std::swap(deferred_events_, deferred);
+                        deferred_events_.swap(deferred);
                         ::std::swap(deferred_event_ids_, event_ids);
                     }
                 }
@@ -460,15 +451,57 @@ private:
             deferred_top_.clear();
         }
     }
+    /**
+     * Move events with the same id from the head of the queue to
+     * the deferred queue
+     */
+    void
+    postpone_deferred_events(deferred_queue& deferred)
+    {
+        auto const* id = deferred.front().id();
+        ::std::size_t count{0};
+        while (!deferred.empty() && deferred.front().id() == id) {
+            deferred_events_.emplace_back(::std::move(deferred.front()));
+            deferred.pop_front();
+            ++count;
+        }
+        deferred_event_ids_.insert(id);
+        observer_wrapper::postpone_deferred_events(*this, count);
+    }
+    /**
+     * Move the rest of the queue to the deferred queue. Swaps the queues
+     * when no events were deferred meanwhile, instead of moving every event.
+     */
+    void
+    postpone_deferred_queue(deferred_queue& deferred)
+    {
+        if (deferred.empty())
+            return;
+        if (!deferred_events_.empty()) {
+            while (!deferred.empty()) {
+                postpone_deferred_events(deferred);
+            }
+            return;
+        }
+        deferred_events_.swap(deferred);
+        auto const size = deferred_events_.size();
+        ::std::size_t start{0};
+        while (start < size) {
+            auto const* id = deferred_events_[start].id();
+            ::std::size_t next = start + 1;
+            while (next < size && deferred_events_[next].id() == id) {
+                ++next;
+            }
+            deferred_event_ids_.insert(id);
+            observer_wrapper::postpone_deferred_events(*this, next - start);
+            start = next;
+        }
+    }
 
     bool
     skip_deferred_queue() const
     {
-        detail::event_set st;
-        ::std::set_intersection(handled_.begin(), handled_.end(),
-            deferred_event_ids_.begin(), deferred_event_ids_.end(),
-            ::std::inserter(st, st.end()));
-        return st.empty();
+        return !detail::intersects(handled_, deferred_event_ids_);
     }
 private:
     using atomic_counter    = ::std::atomic< ::std::size_t >;
@@ -481,9 +514,13 @@ private:
     mutex_type              mutex_;
     event_queue             queued_events_;
     atomic_counter          queue_size_;
+    /** Events being processed, guarded by is_top_ */
+    event_queue             processing_;
 
     ::std::atomic_flag      deferred_top_;
     deferred_queue          deferred_events_;
+    /** Deferred events being processed, guarded by deferred_top_ */
+    deferred_queue          deferred_processing_;
     detail::event_set       deferred_event_ids_;
 };
 
@@ -0,0 +1,130 @@
+/*
+ * event_queue_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <afsm/detail/event_queue.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+
+namespace afsm {
+namespace test {
+
+namespace {
+
+struct event_sink {
+    event_sink() : log{} {}
+
+    ::std::string   log;
+
+    template < typename Event >
+    static int
+    invoke(event_sink& sink, void* event)
+    {
+        Event evt{ ::std::move(*static_cast<Event*>(event)) };
+        sink.log += evt.name;
+        return static_cast<int>(sink.log.size());
+    }
+};
+
+struct small_event {
+    ::std::string   name;
+};
+
+struct large_event {
+    ::std::string               name;
+    ::std::array< char, 256 >   payload;
+};
+
+struct counted_event {
+    ::std::shared_ptr<int>      counter;
+};
+
+using queued = detail::queued_event< event_sink, int >;
+
+}  /* namespace  */
+
+TEST(EventQueue, QueuedEvent)
+{
+    event_sink sink{};
+    queued small{ small_event{"a"}, &event_sink::invoke<small_event>,
+            &detail::event_identity<small_event>::type::id };
+    EXPECT_TRUE(small.is_inline());
+    EXPECT_EQ(&detail::event_identity<small_event>::type::id, small.id());
+
+    queued large{ large_event{"b", {}}, &event_sink::invoke<large_event>,
+            &detail::event_identity<large_event>::type::id };
+    EXPECT_FALSE(large.is_inline());
+
+    queued moved{ ::std::move(small) };
+    EXPECT_TRUE(small.empty());
+    EXPECT_TRUE(moved.is_inline());
+    EXPECT_EQ(1, moved(sink));
+
+    moved = ::std::move(large);
+    EXPECT_TRUE(large.empty());
+    EXPECT_EQ(2, moved(sink));
+    EXPECT_EQ("ab", sink.log);
+}
+
+TEST(EventQueue, RingQueue)
+{
+    auto counter = ::std::make_shared<int>(0);
+    detail::ring_queue< queued > queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(0, queue.capacity());
+
+    // Wrap around the buffer end before growing
+    for (int i = 0; i < 6; ++i) {
+        queue.emplace_back(counted_event{counter}, nullptr,
+                &detail::event_identity<counted_event>::type::id);
+    }
+    auto capacity = queue.capacity();
+    for (int i = 0; i < 4; ++i) {
+        queue.pop_front();
+    }
+    for (int i = 0; i < 6; ++i) {
+        queue.emplace_back(small_event{ ::std::to_string(i) },
+                &event_sink::invoke<small_event>,
+                &detail::event_identity<small_event>::type::id);
+    }
+    EXPECT_EQ(capacity, queue.capacity());
+    EXPECT_EQ(8, queue.size());
+    EXPECT_EQ(3, counter.use_count());
+
+    // Grow, the order is kept
+    for (int i = 6; i < 10; ++i) {
+        queue.emplace_back(small_event{ ::std::to_string(i) },
+                &event_sink::invoke<small_event>,
+                &detail::event_identity<small_event>::type::id);
+    }
+    EXPECT_LT(capacity, queue.capacity());
+    EXPECT_EQ(3, counter.use_count());
+    queue.pop_front();
+    queue.pop_front();
+    EXPECT_EQ(1, counter.use_count());
+
+    event_sink sink;
+    for (; !queue.empty(); queue.pop_front()) {
+        queue.front()(sink);
+    }
+    EXPECT_EQ("0123456789", sink.log);
+
+    // Clear keeps the buffer
+    capacity = queue.capacity();
+    queue.emplace_back(counted_event{counter}, nullptr,
+            &detail::event_identity<counted_event>::type::id);
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(capacity, queue.capacity());
+    EXPECT_EQ(1, counter.use_count());
+}
+
+}  /* namespace test */
+}  /* namespace afsm */
@@ -0,0 +1,126 @@
+/*
+ * scheduler_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <pushkin/asio/fiber/shared_work.hpp>
+#include <pushkin/asio/fiber/work_stealing.hpp>
+
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/operations.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace fiber = ::psst::asio::fiber;
+
+struct shared_work {
+    static fiber::runner_ptr
+    use(::psst::asio::io_service_ptr svc)
+    {
+        return fiber::use_shared_work_algorithm(svc);
+    }
+};
+
+struct work_stealing {
+    static fiber::stealing_runner_ptr
+    use(::psst::asio::io_service_ptr svc)
+    {
+        return fiber::use_work_stealing_algorithm(svc);
+    }
+};
+
+const int yields_per_fiber = 100;
+
+/**
+ * Run fibers in threads sharing an io_service, every fiber yields a number
+ * of times. The fibers are started either by each of the threads or by
+ * the first thread only.
+ */
+template < typename Algorithm >
+void
+run_fibers(int threads, int fibers, bool skewed)
+{
+    auto svc = ::std::make_shared< ::psst::asio::io_service >();
+    ::std::atomic<int> remaining{ threads * fibers };
+
+    auto fiber_fn = [&]()
+    {
+        for (int i = 0; i < yields_per_fiber; ++i) {
+            ::boost::this_fiber::yield();
+        }
+        if (--remaining == 0) {
+            svc->stop();
+        }
+    };
+
+    ::std::vector< ::std::thread > workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]()
+        {
+            auto runner = Algorithm::use(svc);
+            int count = skewed ? (t == 0 ? threads * fibers : 0) : fibers;
+            for (int i = 0; i < count; ++i) {
+                ::boost::fibers::fiber{ fiber_fn }.detach();
+            }
+            runner->run();
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+/**
+ * Fibers per thread x threads, each thread starts its own fibers
+ */
+template < typename Algorithm >
+void
+FiberYield(benchmark::State& state)
+{
+    int threads = state.range(0);
+    int fibers = state.range(1);
+    while (state.KeepRunning()) {
+        run_fibers< Algorithm >(threads, fibers, false);
+    }
+    state.counters["switches"] = benchmark::Counter(
+            state.iterations() * threads * fibers * yields_per_fiber,
+            benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(FiberYield, shared_work)
+    ->RangeMultiplier(4)->Ranges({{1, 4}, {16, 1024}})->UseRealTime();
+BENCHMARK_TEMPLATE(FiberYield, work_stealing)
+    ->RangeMultiplier(4)->Ranges({{1, 4}, {16, 1024}})->UseRealTime();
+
+/**
+ * Fibers per thread x threads, all fibers are started by the first thread
+ */
+template < typename Algorithm >
+void
+FiberYieldSkewed(benchmark::State& state)
+{
+    int threads = state.range(0);
+    int fibers = state.range(1);
+    while (state.KeepRunning()) {
+        run_fibers< Algorithm >(threads, fibers, true);
+    }
+    state.counters["switches"] = benchmark::Counter(
+            state.iterations() * threads * fibers * yields_per_fiber,
+            benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(FiberYieldSkewed, shared_work)
+    ->RangeMultiplier(4)->Ranges({{2, 4}, {64, 1024}})->UseRealTime();
+BENCHMARK_TEMPLATE(FiberYieldSkewed, work_stealing)
+    ->RangeMultiplier(4)->Ranges({{2, 4}, {64, 1024}})->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
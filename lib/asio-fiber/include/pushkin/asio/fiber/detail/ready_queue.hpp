@@ -0,0 +1,33 @@
+/*
+ * ready_queue.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_ASIO_FIBER_DETAIL_READY_QUEUE_HPP_
+#define PUSHKIN_ASIO_FIBER_DETAIL_READY_QUEUE_HPP_
+
+#include <boost/version.hpp>
+#include <boost/fiber/scheduler.hpp>
+
+namespace psst {
+namespace asio {
+namespace fiber {
+namespace detail {
+
+/**
+ * Intrusive queue of fiber contexts linked by their ready hooks
+ */
+#if BOOST_VERSION >= 106500
+using ready_queue_t = ::boost::fibers::scheduler::ready_queue_type;
+#else
+using ready_queue_t = ::boost::fibers::scheduler::ready_queue_t;
+#endif
+
+} /* namespace detail */
+} /* namespace fiber */
+} /* namespace asio */
+} /* namespace psst */
+
+#endif /* PUSHKIN_ASIO_FIBER_DETAIL_READY_QUEUE_HPP_ */
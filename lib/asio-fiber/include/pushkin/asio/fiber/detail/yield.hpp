@@ -10,9 +10,12 @@
 
 #include <pushkin/asio/fiber/yield.hpp>
 
+#include <boost/version.hpp>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/detail/config.hpp>
+#if BOOST_VERSION < 106600
 #include <boost/asio/handler_type.hpp>
+#endif
 
 #include <boost/fiber/all.hpp>
 #include <mutex>
@@ -35,6 +38,9 @@ struct yield_completion {
         lock_type lock{mtx_};
         if (! completed_ ) {
             ::boost::fibers::context::active()->suspend(lock);
+            // The completion can be on the stack of the fiber, wait until
+            // the handler releases the lock before the fiber goes on
+            lock.lock();
         }
     }
 };
@@ -61,7 +67,11 @@ struct yield_handler_base {
         *yld_.ec_ = ec;
 
         if (context::active() != ctx_) {
+#if BOOST_VERSION >= 106500
+            context::active()->schedule(ctx_);
+#else
             context::active()->set_ready(ctx_);
+#endif
         }
     }
 
@@ -137,23 +147,19 @@ private:
     yield_completion    ycomp_{};
 };
 
-} /* namespace detail */
-} /* namespace fiber */
-} /* namespace asio */
-} /* namespace psst */
-
-namespace boost {
-namespace asio {
-
+/**
+ * Result of an asynchronous operation completed by a yield_handler<T>
+ */
 template < typename T >
-class async_result< ::psst::asio::fiber::detail::yield_handler<T> >
-        : public ::psst::asio::fiber::detail::async_result_base {
+class async_result_value : public async_result_base {
 public:
-    using type          = T;
-    using handler_type  = ::psst::asio::fiber::detail::yield_handler<T>;
+    using type                      = T;
+    using return_type               = T;
+    using handler_type              = yield_handler<T>;
+    using completion_handler_type   = yield_handler<T>;
 
     explicit
-    async_result(handler_type& h)
+    async_result_value(handler_type& h)
         : async_result_base{h}
     {
         // Inject value pointer
@@ -170,17 +176,34 @@ private:
 };
 
 template <>
-class async_result< ::psst::asio::fiber::detail::yield_handler<void> >
-        : public ::psst::asio::fiber::detail::async_result_base {
+class async_result_value<void> : public async_result_base {
 public:
-    using type          = void;
-    using handler_type  = ::psst::asio::fiber::detail::yield_handler<void>;
+    using type                      = void;
+    using return_type               = void;
+    using handler_type              = yield_handler<void>;
+    using completion_handler_type   = yield_handler<void>;
 
     explicit
-    async_result(handler_type& h)
+    async_result_value(handler_type& h)
         : async_result_base{h} {}
 };
 
+} /* namespace detail */
+} /* namespace fiber */
+} /* namespace asio */
+} /* namespace psst */
+
+namespace boost {
+namespace asio {
+
+#if BOOST_VERSION < 106600
+template < typename T >
+class async_result< ::psst::asio::fiber::detail::yield_handler<T> >
+        : public ::psst::asio::fiber::detail::async_result_value<T> {
+public:
+    using ::psst::asio::fiber::detail::async_result_value<T>::async_result_value;
+};
+
 //@{
 /** Handler specializations for yield_t */
 template < typename ReturnType >
@@ -199,6 +222,38 @@ template < typename ReturnType, typename Arg >
 struct handler_type< ::psst::asio::fiber::yield_t, ReturnType(system::error_code, Arg) >
 {  using type = ::psst::asio::fiber::detail::yield_handler<Arg>;  };
 //@}
+#else
+//@{
+/** Result specializations for yield_t, handler_type is gone since 1.66 */
+template < typename ReturnType >
+class async_result< ::psst::asio::fiber::yield_t, ReturnType() >
+        : public ::psst::asio::fiber::detail::async_result_value<void> {
+public:
+    using async_result_value::async_result_value;
+};
+
+template < typename ReturnType >
+class async_result< ::psst::asio::fiber::yield_t, ReturnType( system::error_code ) >
+        : public ::psst::asio::fiber::detail::async_result_value<void> {
+public:
+    using async_result_value::async_result_value;
+};
+
+template < typename ReturnType, typename Arg >
+class async_result< ::psst::asio::fiber::yield_t, ReturnType(Arg) >
+        : public ::psst::asio::fiber::detail::async_result_value<Arg> {
+public:
+    using ::psst::asio::fiber::detail::async_result_value<Arg>::async_result_value;
+};
+
+template < typename ReturnType, typename Arg >
+class async_result< ::psst::asio::fiber::yield_t, ReturnType(system::error_code, Arg) >
+        : public ::psst::asio::fiber::detail::async_result_value<Arg> {
+public:
+    using ::psst::asio::fiber::detail::async_result_value<Arg>::async_result_value;
+};
+//@}
+#endif
 
 } /* namespace asio */
 } /* namespace boost */
@@ -9,6 +9,7 @@
 #define PUSHKIN_ASIO_FIBER_ROUND_ROBIN_HPP_
 
 #include <pushkin/asio/asio_config.hpp>
+#include <pushkin/asio/fiber/detail/ready_queue.hpp>
 
 #include <boost/asio/steady_timer.hpp>
 
@@ -26,7 +27,7 @@ class round_robin : public ::boost::fibers::algo::algorithm {
     using time_point            = ::std::chrono::steady_clock::time_point;
 
     using context               = ::boost::fibers::context;
-    using ready_queue_t         = ::boost::fibers::scheduler::ready_queue_t;
+    using ready_queue_t         = detail::ready_queue_t;
     using mutex_type            = ::boost::fibers::mutex;
     using condition_variable    = ::boost::fibers::condition_variable;
 
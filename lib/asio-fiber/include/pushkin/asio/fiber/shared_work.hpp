@@ -9,6 +9,7 @@
 #define PUSHKIN_ASIO_FIBER_SHARED_WORK_HPP_
 
 #include <pushkin/asio/asio_config.hpp>
+#include <pushkin/asio/fiber/detail/ready_queue.hpp>
 
 #include <boost/asio/steady_timer.hpp>
 
@@ -44,7 +45,7 @@ public:
 
     using context               = ::boost::fibers::context;
     using context_type          = ::boost::fibers::type;
-    using ready_queue_t         = ::boost::fibers::scheduler::ready_queue_t;
+    using ready_queue_t         = detail::ready_queue_t;
 
     using mutex_type            = ::boost::fibers::mutex;
     using condition_variable    = ::boost::fibers::condition_variable;
@@ -58,7 +59,7 @@ private:
         ::std::unique_ptr< io_service::work >   work_;
 
         mutex_type                              mtx_{};
-        ready_queue_t                           queue_{};
+        detail::ready_queue_t                   queue_{};
 
         service(io_service& io_svc)
             : io_service::service(io_svc),
@@ -124,14 +125,14 @@ public:
     }
 
     bool
-    has_ready_fibers() const noexcept override
+    has_ready_fibers() const noexcept
     {
         service::lock_type lock{ shared_->mtx_ };
         return !shared_->queue_.empty() || !local_queue_.empty();
     }
 
     void
-    awakened(context* ctx) noexcept override
+    awakened(context* ctx) noexcept
     {
         if (ctx->is_context( context_type::pinned_context )) {
             ctx->ready_link(local_queue_);
@@ -142,7 +143,7 @@ public:
         }
     }
     context*
-    pick_next() noexcept override
+    pick_next() noexcept
     {
         context* ctx{ nullptr };
         service::lock_type lock{ shared_->mtx_ };
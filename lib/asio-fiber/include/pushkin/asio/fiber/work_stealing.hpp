@@ -0,0 +1,469 @@
+/*
+ * work_stealing.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_ASIO_FIBER_WORK_STEALING_HPP_
+#define PUSHKIN_ASIO_FIBER_WORK_STEALING_HPP_
+
+#include <pushkin/asio/asio_config.hpp>
+#include <pushkin/asio/fiber/detail/ready_queue.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/fiber/scheduler.hpp>
+#include <boost/fiber/context.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/operations.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace asio {
+namespace fiber {
+
+namespace detail {
+
+/**
+ * Ready queue of a work stealing runner. The owner thread pushes and pops
+ * fibers, other runners of the same io_service steal from it when they
+ * run out of work.
+ */
+class stealing_queue {
+public:
+    using context               = ::boost::fibers::context;
+    using mutex_type            = ::std::mutex;
+    using lock_type             = ::std::unique_lock<mutex_type>;
+public:
+    stealing_queue() = default;
+    stealing_queue(stealing_queue const&) = delete;
+    stealing_queue&
+    operator = (stealing_queue const&) = delete;
+
+    void
+    push(context* ctx) noexcept
+    {
+        lock_type lock{mtx_};
+        ctx->ready_link(queue_);
+        size_.fetch_add(1, ::std::memory_order_release);
+    }
+
+    context*
+    pop() noexcept
+    {
+        if (empty())
+            return nullptr;
+        lock_type lock{mtx_};
+        if (queue_.empty())
+            return nullptr;
+        context* ctx = &queue_.front();
+        queue_.pop_front();
+        size_.fetch_sub(1, ::std::memory_order_relaxed);
+        return ctx;
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return size_.load(::std::memory_order_acquire) == 0;
+    }
+    ::std::size_t
+    size() const noexcept
+    {
+        return size_.load(::std::memory_order_acquire);
+    }
+private:
+    mutex_type                  mtx_{};
+    ready_queue_t               queue_{};
+    ::std::atomic<::std::size_t> size_{0};
+};
+
+using stealing_queue_ptr    = ::std::shared_ptr<stealing_queue>;
+using stealing_queue_list   = ::std::vector<stealing_queue_ptr>;
+
+} /* namespace detail */
+
+/**
+ * Work stealing scheduling algorithm for fiber dispatcher for use with one
+ * ::boost::asio::io_service in multiple threads.
+ *
+ * Every thread keeps the fibers it has awakened in its own queue, a thread
+ * that has no ready fibers steals them from the queues of other threads
+ * running the same io_service. Pinned fibers (main and dispatcher
+ * contexts) are never stolen. Ready fibers left in the queue of a runner
+ * that is destroyed are run by the other runners.
+ *
+ * Usage synopsis:
+ *
+ * In each thread that should be running io_service loop together with
+ * fiber dispatcher:
+ *
+ * @code
+ * auto runner = ::psst::asio::fiber::use_work_stealing_algorithm( io_svc );
+ * runner->run();
+ * @endcode
+ *
+ */
+class stealing_runner : public ::std::enable_shared_from_this<stealing_runner> {
+public:
+    using time_point            = ::std::chrono::steady_clock::time_point;
+
+    using context               = ::boost::fibers::context;
+    using context_type          = ::boost::fibers::type;
+    using ready_queue_t         = detail::ready_queue_t;
+
+    using mutex_type            = ::boost::fibers::mutex;
+    using condition_variable    = ::boost::fibers::condition_variable;
+    using lock_type             = ::std::unique_lock<mutex_type>;
+private:
+    struct service : io_service::service {
+        using mutex_type        = ::std::mutex;
+        using lock_type         = ::std::unique_lock<mutex_type>;
+        using queue_list_ptr    = ::std::shared_ptr<detail::stealing_queue_list const>;
+
+        static io_service::id                   id;
+        io_service&                             io_svc_;
+        ::std::unique_ptr< io_service::work >   work_;
+
+        mutex_type                              mtx_{};
+        /** Fibers left by destroyed runners, stolen as any other queue */
+        detail::stealing_queue_ptr              orphans_{
+                ::std::make_shared<detail::stealing_queue>() };
+        /** Copied on write, read by the stealing threads without locking */
+        queue_list_ptr                          queues_{
+                ::std::make_shared<detail::stealing_queue_list>(1, orphans_) };
+        /** Number of runners waiting for io events */
+        ::std::atomic<::std::size_t>            idle_{0};
+        ::std::atomic_flag                      wake_pending_ = ATOMIC_FLAG_INIT;
+
+        service(io_service& io_svc)
+            : io_service::service(io_svc),
+              io_svc_(io_svc),
+              work_{ new io_service::work{ io_svc } }
+        {}
+
+        virtual ~service() = default;
+        service(service const&) = delete;
+        service(service&&) = delete;
+        service&
+        operator =(service const&) = delete;
+        service&
+        operator =(service&&) = delete;
+
+        void
+        shutdown_service() override final
+        {
+            work_.reset();
+        }
+
+        queue_list_ptr
+        queues() const
+        {
+            return ::std::atomic_load(&queues_);
+        }
+
+        void
+        add_queue(detail::stealing_queue_ptr q)
+        {
+            lock_type lock{mtx_};
+            auto queues = ::std::make_shared<detail::stealing_queue_list>(*queues_);
+            queues->push_back(q);
+            ::std::atomic_store(&queues_, queue_list_ptr{queues});
+        }
+
+        void
+        remove_queue(detail::stealing_queue_ptr const& q)
+        {
+            lock_type lock{mtx_};
+            auto queues = ::std::make_shared<detail::stealing_queue_list>();
+            for (auto const& e : *queues_) {
+                if (e != q)
+                    queues->push_back(e);
+            }
+            ::std::atomic_store(&queues_, queue_list_ptr{queues});
+        }
+
+        /**
+         * Wake a runner blocked in io_service::run_one so that it can steal
+         * the fibers. Only one wakeup is in flight at a time.
+         */
+        void
+        wake_idle() noexcept
+        {
+            if (idle_.load(::std::memory_order_acquire) > 0
+                    && !wake_pending_.test_and_set(::std::memory_order_acq_rel)) {
+                try {
+                    io_svc_.post(
+                        [this]()
+                        {
+                            wake_pending_.clear(::std::memory_order_release);
+                        });
+                } catch (...) {
+                    wake_pending_.clear(::std::memory_order_release);
+                }
+            }
+        }
+    };
+public:
+    stealing_runner(io_service_ptr io_svc)
+        : io_svc_{io_svc},
+          suspend_timer_{ *io_svc },
+          queue_{ ::std::make_shared<detail::stealing_queue>() },
+          owner_{ ::std::this_thread::get_id() }
+    {
+        try {
+            ::std::unique_ptr< service > svc{new service(*io_svc_)};
+            ::asio_ns::add_service(*io_svc_, svc.get());
+            svc.release();
+        } catch (::asio_ns::service_already_exists const& e) {
+            // Ignore it here
+        }
+        shared_ = &::asio_ns::use_service< service >(*io_svc_);
+        shared_->add_queue(queue_);
+    }
+
+    ~stealing_runner()
+    {
+        shared_->remove_queue(queue_);
+        // Hand the fibers nobody has stolen yet to the other runners
+        bool orphaned{ false };
+        while (context* ctx = queue_->pop()) {
+            shared_->orphans_->push(ctx);
+            orphaned = true;
+        }
+        if (orphaned)
+            shared_->wake_idle();
+    }
+
+    void
+    run()
+    {
+        while (!io_svc_->stopped()) {
+            if (has_ready_fibers()) {
+                while (io_svc_->poll());
+
+                lock_type lock{mtx_};
+                cnd_.wait(lock);
+            } else {
+                shared_->idle_.fetch_add(1, ::std::memory_order_acq_rel);
+                blocked_.store(true, ::std::memory_order_seq_cst);
+                // Recheck after announcing the runner idle, a fiber could
+                // be queued or notified before the announcement without
+                // waking anyone
+                bool ready = has_ready_fibers() ||
+                        notified_.load(::std::memory_order_seq_cst);
+                ::std::size_t handlers = ready ? 1 : io_svc_->run_one();
+                blocked_.store(false, ::std::memory_order_seq_cst);
+                shared_->idle_.fetch_sub(1, ::std::memory_order_acq_rel);
+                if (!handlers) {
+                    break;
+                }
+            }
+            if (notified_.exchange(false, ::std::memory_order_acq_rel)) {
+                // Let the dispatcher take the fibers made ready by other
+                // threads, they are not visible to has_ready_fibers
+                ::boost::this_fiber::yield();
+            }
+        }
+    }
+
+    void
+    stop()
+    {
+        io_svc_->stop();
+        cnd_.notify_one();
+    }
+
+    bool
+    has_ready_fibers() const noexcept
+    {
+        if (!local_queue_.empty() || !queue_->empty())
+            return true;
+        auto queues = shared_->queues();
+        for (auto const& q : *queues) {
+            if (!q->empty())
+                return true;
+        }
+        return false;
+    }
+
+    void
+    awakened(context* ctx) noexcept
+    {
+        if (ctx->is_context( context_type::pinned_context )) {
+            ctx->ready_link(local_queue_);
+        } else {
+            ctx->detach();
+            queue_->push(ctx);
+            shared_->wake_idle();
+        }
+    }
+    context*
+    pick_next() noexcept
+    {
+        context* ctx = queue_->pop();
+        if (!ctx)
+            ctx = steal();
+        if (ctx) {
+            context::active()->attach(ctx);
+        } else if (!local_queue_.empty()) {
+            ctx = &local_queue_.front();
+            local_queue_.pop_front();
+        }
+        return ctx;
+    }
+
+    void
+    suspend_until(time_point const& abs_time) noexcept
+    {
+        if (abs_time != time_point::max()) {
+            suspend_timer_.expires_at(abs_time);
+            suspend_timer_.async_wait(
+                []( error_code const& )
+                {
+                    ::boost::this_fiber::yield();
+                });
+        }
+        cnd_.notify_one();
+    }
+
+    /**
+     * Called from a thread that has made one of the runner's fibers ready.
+     * Any runner may take a handler from the io_service, so the wakeup is
+     * posted again until the owner thread runs it or stops waiting.
+     */
+    void
+    notify() noexcept
+    {
+        notified_.store(true, ::std::memory_order_seq_cst);
+        if (blocked_.load(::std::memory_order_seq_cst)) {
+            try {
+                post_wakeup(shared_from_this());
+            } catch (...) {}
+        }
+    }
+private:
+    static void
+    post_wakeup(::std::weak_ptr<stealing_runner> target)
+    {
+        auto r = target.lock();
+        if (!r)
+            return;
+        r->io_svc_->post(
+            [target]()
+            {
+                auto r = target.lock();
+                if (r && r->owner_ != ::std::this_thread::get_id()
+                        && r->blocked_.load(::std::memory_order_seq_cst)
+                        && r->notified_.load(::std::memory_order_seq_cst)) {
+                    ::std::this_thread::yield();
+                    post_wakeup(target);
+                }
+            });
+    }
+    /**
+     * Take a fiber from the most loaded queue of other runners
+     */
+    context*
+    steal() noexcept
+    {
+        auto queues = shared_->queues();
+        detail::stealing_queue* victim{ nullptr };
+        ::std::size_t max_size{ 0 };
+        for (auto const& q : *queues) {
+            if (q == queue_)
+                continue;
+            auto sz = q->size();
+            if (sz > max_size) {
+                max_size = sz;
+                victim = q.get();
+            }
+        }
+        return victim ? victim->pop() : nullptr;
+    }
+private:
+    io_service_ptr                          io_svc_;
+    ::asio_ns::steady_timer                 suspend_timer_;
+
+    mutex_type                              mtx_{};
+    condition_variable                      cnd_{};
+    ready_queue_t                           local_queue_{};
+    detail::stealing_queue_ptr              queue_;
+    ::std::thread::id                       owner_;
+    /** The owner thread waits in io_service::run_one */
+    ::std::atomic<bool>                     blocked_{false};
+    /** Fibers were made ready by other threads */
+    ::std::atomic<bool>                     notified_{false};
+
+    service*                                shared_{nullptr};
+};
+using stealing_runner_ptr = ::std::shared_ptr<stealing_runner>;
+
+
+class work_stealing : public ::boost::fibers::algo::algorithm {
+public:
+    using time_point            = ::std::chrono::steady_clock::time_point;
+    using context               = ::boost::fibers::context;
+public:
+    work_stealing(stealing_runner_ptr r)
+        : pimpl_{ r } {}
+    ~work_stealing()
+    {
+    }
+
+    void
+    awakened(context* ctx) noexcept override
+    {
+        pimpl_->awakened(ctx);
+    }
+
+    context*
+    pick_next() noexcept override
+    {
+        return pimpl_->pick_next();
+    }
+
+    bool
+    has_ready_fibers() const noexcept override
+    {
+        return pimpl_->has_ready_fibers();
+    }
+
+    void
+    suspend_until(time_point const& abs_time) noexcept override
+    {
+        pimpl_->suspend_until(abs_time);
+    }
+
+    void
+    notify() noexcept override
+    {
+        pimpl_->notify();
+    }
+private:
+    stealing_runner_ptr                         pimpl_;
+};
+
+io_service::id stealing_runner::service::id;
+
+inline stealing_runner_ptr
+use_work_stealing_algorithm(io_service_ptr io_svc)
+{
+    auto r = ::std::make_shared< stealing_runner >(io_svc);
+    ::boost::fibers::use_scheduling_algorithm< work_stealing >( r );
+    return r;
+}
+
+} /* namespace fiber */
+} /* namespace asio */
+} /* namespace psst */
+
+
+#endif /* PUSHKIN_ASIO_FIBER_WORK_STEALING_HPP_ */
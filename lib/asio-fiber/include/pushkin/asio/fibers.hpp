@@ -11,5 +11,6 @@
 #include <pushkin/asio/fiber/yield.hpp>
 #include <pushkin/asio/fiber/round_robin.hpp>
 #include <pushkin/asio/fiber/shared_work.hpp>
+#include <pushkin/asio/fiber/work_stealing.hpp>
 
 #endif /* PUSHKIN_ASIO_FIBERS_HPP_ */
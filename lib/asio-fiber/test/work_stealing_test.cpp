@@ -0,0 +1,218 @@
+/*
+ * work_stealing_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <pushkin/asio/fiber/work_stealing.hpp>
+
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/future.hpp>
+#include <boost/fiber/operations.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace asio {
+namespace fiber {
+namespace test {
+
+namespace {
+
+using clock_type = ::std::chrono::steady_clock;
+
+/**
+ * Threads running work stealing runners on one io_service
+ */
+class runner_threads {
+public:
+    using init_function = ::std::function< void() >;
+
+    runner_threads(io_service_ptr svc) : svc_{svc} {}
+    ~runner_threads()
+    {
+        stop();
+    }
+
+    /**
+     * Start a runner thread, the init function is called in the thread
+     * before the runner is started
+     */
+    void
+    start(init_function init = init_function{})
+    {
+        auto svc = svc_;
+        threads_.emplace_back(
+            [svc, init]()
+            {
+                auto runner = use_work_stealing_algorithm(svc);
+                if (init)
+                    init();
+                runner->run();
+            });
+    }
+
+    void
+    stop()
+    {
+        svc_->stop();
+        for (auto& t : threads_) {
+            if (t.joinable())
+                t.join();
+        }
+    }
+private:
+    io_service_ptr              svc_;
+    ::std::vector<::std::thread> threads_;
+};
+
+/**
+ * Thread ids of the fibers' threads
+ */
+class thread_log {
+public:
+    void
+    add()
+    {
+        ::std::lock_guard<::std::mutex> lock{mtx_};
+        ids_.insert(::std::this_thread::get_id());
+    }
+    ::std::set<::std::thread::id>
+    ids()
+    {
+        ::std::lock_guard<::std::mutex> lock{mtx_};
+        return ids_;
+    }
+private:
+    ::std::mutex                    mtx_;
+    ::std::set<::std::thread::id>   ids_;
+};
+
+bool
+wait_for(::std::atomic<int> const& counter, int value)
+{
+    auto deadline = clock_type::now() + ::std::chrono::seconds(10);
+    while (counter < value && clock_type::now() < deadline) {
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+    }
+    return counter == value;
+}
+
+}  // namespace
+
+TEST(WorkStealing, SkewedSpawn)
+{
+    const int fiber_count = 64;
+    auto svc = ::std::make_shared<io_service>();
+    ::std::atomic<int> done{0};
+    thread_log threads;
+
+    runner_threads runners{svc};
+    // All fibers are started by the first thread
+    runners.start(
+        [&]()
+        {
+            for (int i = 0; i < fiber_count; ++i) {
+                ::boost::fibers::fiber(
+                    [&]()
+                    {
+                        // Keep the first thread busy until another one
+                        // takes a fiber
+                        auto until = clock_type::now() + ::std::chrono::seconds(5);
+                        do {
+                            threads.add();
+                            ::boost::this_fiber::yield();
+                        } while (threads.ids().size() < 2 && clock_type::now() < until);
+                        ++done;
+                    }).detach();
+            }
+        });
+    for (int i = 0; i < 3; ++i)
+        runners.start();
+
+    EXPECT_TRUE(wait_for(done, fiber_count));
+    runners.stop();
+    // Idle threads took fibers from the first one
+    EXPECT_LT(1u, threads.ids().size());
+}
+
+TEST(WorkStealing, RunnerShutdownWithPendingFibers)
+{
+    const int fiber_count = 32;
+    auto svc = ::std::make_shared<io_service>();
+    ::std::atomic<int> done{0};
+
+    runner_threads runners{svc};
+    runners.start();
+    runners.start();
+
+    // The thread exits without running the io_service, the fibers are
+    // still waiting in the queue of its runner
+    ::std::thread spawner{
+        [&]()
+        {
+            auto runner = use_work_stealing_algorithm(svc);
+            for (int i = 0; i < fiber_count; ++i) {
+                ::boost::fibers::fiber(
+                    [&]()
+                    {
+                        ++done;
+                    }).detach();
+            }
+        }};
+    spawner.join();
+
+    EXPECT_TRUE(wait_for(done, fiber_count));
+}
+
+TEST(WorkStealing, RemoteNotify)
+{
+    auto svc = ::std::make_shared<io_service>();
+    ::std::atomic<int> done{0};
+    ::std::atomic<int> waiting{0};
+    ::boost::fibers::promise<void> ready;
+    ::boost::fibers::future<void> future = ready.get_future();
+    ::std::atomic<bool> timed_out{false};
+    clock_type::duration elapsed{};
+
+    runner_threads runners{svc};
+    runners.start(
+        [&]()
+        {
+            ::boost::fibers::fiber(
+                [&]()
+                {
+                    ++waiting;
+                    auto start = clock_type::now();
+                    timed_out = future.wait_for(::std::chrono::seconds(5))
+                            != ::boost::fibers::future_status::ready;
+                    elapsed = clock_type::now() - start;
+                    ++done;
+                }).detach();
+        });
+    runners.start();
+
+    ASSERT_TRUE(wait_for(waiting, 1));
+    // Let the runners block in the io_service
+    ::std::this_thread::sleep_for(::std::chrono::milliseconds(50));
+    ready.set_value();
+
+    EXPECT_TRUE(wait_for(done, 1));
+    EXPECT_FALSE(timed_out);
+    // The waiting runner was woken up, not the timer
+    EXPECT_GT(::std::chrono::seconds(1), elapsed);
+}
+
+}  // namespace test
+}  // namespace fiber
+}  // namespace asio
+}  // namespace psst
@@ -0,0 +1,111 @@
+/*
+ * log_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <pushkin/log.hpp>
+
+#include <ostream>
+#include <streambuf>
+
+LOCAL_LOGGING_FACILITY(BENCH, TRACE);
+
+namespace {
+
+/**
+ * Stream buffer discarding the output
+ */
+class null_buffer : public std::streambuf {
+protected:
+    int_type
+    overflow(int_type c) override
+    {
+        return traits_type::not_eof(c);
+    }
+    std::streamsize
+    xsputn(char const*, std::streamsize n) override
+    {
+        return n;
+    }
+};
+
+struct null_log {
+    null_buffer     buffer;
+    std::ostream    stream;
+
+    null_log() : buffer{}, stream{&buffer}
+    {
+        logger::set_stream(stream);
+        logger::min_severity(logger::TRACE);
+    }
+} null_log_output;
+
+/**
+ * A log line as written by the connection code, every thread writes to
+ * the logger concurrently.
+ */
+void
+LogCall(benchmark::State& state)
+{
+    std::size_t dropped = logger::instance().dropped_events();
+    int n = 0;
+    while (state.KeepRunning()) {
+        local_log() << "Conn# " << state.thread_index() << ": Row data message size "
+                << ++n;
+    }
+    state.counters["calls"] = benchmark::Counter(state.iterations(),
+            benchmark::Counter::kIsRate);
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] = benchmark::Counter(
+                logger::instance().dropped_events() - dropped,
+                benchmark::Counter::kIsRate);
+    }
+}
+BENCHMARK(LogCall)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * Work done by a thread between two log calls, about a microsecond
+ */
+unsigned
+do_work(unsigned seed)
+{
+    for (int i = 0; i < 256; ++i) {
+        seed = seed * 1103515245 + 12345;
+        benchmark::DoNotOptimize(seed);
+    }
+    return seed;
+}
+
+/**
+ * Threads doing work and logging an event per unit of work. The threads
+ * don't share a queue, so the rate of calls grows with the number of
+ * threads while the writer keeps up.
+ */
+void
+LogCallWithWork(benchmark::State& state)
+{
+    std::size_t dropped = logger::instance().dropped_events();
+    unsigned seed = state.thread_index();
+    int n = 0;
+    while (state.KeepRunning()) {
+        seed = do_work(seed);
+        local_log() << "Conn# " << state.thread_index() << ": Row data message size "
+                << ++n;
+    }
+    state.counters["calls"] = benchmark::Counter(state.iterations(),
+            benchmark::Counter::kIsRate);
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] = benchmark::Counter(
+                logger::instance().dropped_events() - dropped,
+                benchmark::Counter::kIsRate);
+    }
+}
+BENCHMARK(LogCallWithWork)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -79,6 +79,20 @@ public:
     void
     rotate();
 
+    /**
+     * Number of threads the writer collects events from. The queue of an
+     * exited thread is released after its events are written.
+     */
+    std::size_t
+    thread_rings();
+
+    /**
+     * Number of events dropped because the queue of the logging thread was
+     * full, since the output stream was set.
+     */
+    std::size_t
+    dropped_events();
+
     /**
      * Singleton instance of the logger
      * @return
@@ -188,9 +202,12 @@ public:
     local(std::string const& category, logger::event_severity severity =
                 logger::TRACE)
             :
-                do_flush_(true)
+                enabled_(logger::OFF < severity
+                        && logger::min_severity() <= severity),
+                do_flush_(enabled_)
     {
-        logger::instance().category(category).severity(severity);
+        if (enabled_)
+            logger::instance().category(category).severity(severity);
     }
     ~local()
     {
@@ -198,7 +215,7 @@ public:
             logger::instance().flush();
     }
 
-    local(local const& rhs) : do_flush_(true)
+    local(local const& rhs) : enabled_(rhs.enabled_), do_flush_(rhs.enabled_)
     {
         rhs.do_flush_ = false;
     }
@@ -206,11 +223,23 @@ public:
     local&
     operator = (local const& rhs)
     {
-        do_flush_ = true;
+        enabled_ = rhs.enabled_;
+        do_flush_ = rhs.enabled_;
         rhs.do_flush_ = false;
         return *this;
     }
 
+    /**
+     * The event will be written to the log. The severity of an event that
+     * is not written is checked once, so the output operators don't touch
+     * the logger.
+     */
+    bool
+    enabled() const
+    {
+        return enabled_;
+    }
+
     logger*
     operator->()
     {
@@ -232,9 +261,40 @@ public:
         return logger::instance();
     }
 private:
+    bool enabled_;
     mutable bool do_flush_;
 };
 
+/**
+ * Local logger for a facility turned off at compile time. The output
+ * operators are empty, so a log statement is compiled out.
+ */
+class null_local {
+public:
+    null_local(std::string const&, logger::event_severity = logger::OFF)
+    {
+    }
+
+    bool
+    enabled() const
+    {
+        return false;
+    }
+};
+
+/**
+ * Local logger type for a facility's default severity
+ */
+template < logger::event_severity S >
+struct local_type {
+    using type = local;
+};
+
+template <>
+struct local_type< logger::OFF > {
+    using type = null_local;
+};
+
 inline logger&
 endl(logger& out)
 {
@@ -255,7 +315,15 @@ template < typename T >
 local
 operator << (local out, T const& v)
 {
-    logger::instance() << v;
+    if (out.enabled())
+        logger::instance() << v;
+    return out;
+}
+
+template < typename T >
+inline null_local
+operator << (null_local out, T const&)
+{
     return out;
 }
 
@@ -324,8 +392,12 @@ operator << (log::logger&, ANSI_COLOR);
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = logger::s; \
-        local \
-        local_log(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        local_log() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        local_log(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -335,8 +407,12 @@ operator << (log::logger&, ANSI_COLOR);
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = s; \
-        local \
-        local_log(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        local_log() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        local_log(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -346,8 +422,12 @@ operator << (log::logger&, ANSI_COLOR);
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = logger::s; \
-        local \
-        f(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        f() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        f(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -357,8 +437,12 @@ operator << (log::logger&, ANSI_COLOR);
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = s; \
-        local \
-        f(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        f() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        f(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -15,7 +15,10 @@
 #include <iterator>
 #include <unistd.h>
 #include <thread>
-#include <queue>
+#include <vector>
+#include <atomic>
+#include <sstream>
+#include <cstdio>
 #include <map>
 #include <mutex>
 #include <condition_variable>
@@ -163,35 +166,178 @@ struct event_data {
 	logger::event_severity		severity_;
 	std::string					category_;
 	buffer_type					buffer_;
+	/** The event is being written, the timestamp is set */
+	bool						started_;
 
 	event_data(size_t t_no) :
-		thread_no_(t_no), timestamp_(timestamp()), severity_(logger::TRACE),
-		category_(UNKNOW_CATEGORY)
+		thread_no_(t_no), timestamp_(), severity_(logger::TRACE),
+		category_(UNKNOW_CATEGORY), buffer_(), started_(false)
 	{
 	}
+
+	/**
+	 * Prepare for the next event, the buffer keeps its memory
+	 */
+	void
+	reset()
+	{
+		buffer_.consume(buffer_.size());
+		severity_ = logger::TRACE;
+		category_ = UNKNOW_CATEGORY;
+		started_ = false;
+	}
 };
 
+/**
+ * Event waiting to be written. The message is formatted by the thread that
+ * logged it, the header is formatted by the writer thread.
+ */
+struct event_record {
+	size_t						thread_no_;
+	timestamp_type				timestamp_;
+	logger::event_severity		severity_;
+	std::string					category_;
+	std::string					message_;
+};
+
+/**
+ * Single producer single consumer queue of the events logged by a thread.
+ * Records are reused, a thread doesn't allocate memory for logging once
+ * the record buffers have grown to the size of its messages.
+ * Events that don't fit in the ring are counted and reported by the writer.
+ */
+class event_ring {
+public:
+	static constexpr std::size_t capacity = 1024;
+
+	event_ring(std::size_t t_no)
+		: head_{0}, head_pad_{}, tail_{0}, tail_pad_{}, dropped_{0},
+		  thread_no_{t_no}, records_(capacity) {}
+
+	/**
+	 * Producer side. Record for the next event or nullptr if the ring is full
+	 */
+	event_record*
+	back()
+	{
+		std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - head_.load(std::memory_order_acquire) == capacity)
+			return nullptr;
+		return &records_[tail & (capacity - 1)];
+	}
+	/**
+	 * Producer side. Make the record returned by back() visible to the writer
+	 */
+	void
+	push()
+	{
+		tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+				std::memory_order_release);
+	}
+
+	/**
+	 * Consumer side. The oldest record or nullptr if the ring is empty
+	 */
+	event_record*
+	front()
+	{
+		std::size_t head = head_.load(std::memory_order_relaxed);
+		if (head == tail_.load(std::memory_order_acquire))
+			return nullptr;
+		return &records_[head & (capacity - 1)];
+	}
+	void
+	pop()
+	{
+		head_.store(head_.load(std::memory_order_relaxed) + 1,
+				std::memory_order_release);
+	}
+
+	bool
+	empty() const
+	{
+		return head_.load(std::memory_order_acquire) ==
+				tail_.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Producer side. Count an event that didn't fit in the ring
+	 */
+	void
+	drop()
+	{
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+	}
+	/**
+	 * Consumer side. Number of events dropped since the previous call
+	 */
+	std::size_t
+	take_dropped()
+	{
+		return dropped_.exchange(0, std::memory_order_relaxed);
+	}
+	bool
+	has_dropped() const
+	{
+		return dropped_.load(std::memory_order_relaxed) > 0;
+	}
+
+	std::size_t
+	thread_no() const
+	{
+		return thread_no_;
+	}
+private:
+	static constexpr std::size_t cache_line = 64;
+	using atomic_index = std::atomic<std::size_t>;
+
+	atomic_index				head_;
+	char						head_pad_[cache_line - sizeof(atomic_index)];
+	atomic_index				tail_;
+	char						tail_pad_[cache_line - sizeof(atomic_index)];
+	atomic_index				dropped_;
+	std::size_t					thread_no_;
+	std::vector<event_record>	records_;
+};
+
+constexpr std::size_t event_ring::capacity;
+
 struct log_writer {
-    using event_ptr     = ::std::shared_ptr<event_data>;
-    using event_queue   = ::std::queue<event_ptr>;
+    using ring_ptr      = ::std::shared_ptr<event_ring>;
+    using ring_list     = ::std::vector<ring_ptr>;
     using mutex_type    = ::std::mutex;
     using lock_guard    = ::std::lock_guard<mutex_type>;
     using unique_lock   = ::std::unique_lock<mutex_type>;
     using redirect_ptr  = ::std::shared_ptr< stream_redirect >;
 
+    /** Max number of events written before looking for new threads */
+    static constexpr ::std::size_t max_batch = 4096;
+
     ::std::ostream&                     out_;
     redirect_ptr                        redirect_;
 	pid_t pid_;
 
-	event_queue events_;
+	/** Rings of the logging threads, guarded by the mutex */
+	ring_list							rings_;
 	std::condition_variable cond_;
     mutex_type                          mtx_;
+	/** The writer waits for events on the condition variable */
+	std::atomic<bool>					sleeping_;
+	/** A thread registered a ring since the writer copied the list */
+	bool								rings_added_;
 
-	bool finished_;
+	std::atomic<bool>					finished_;
+	/** Events dropped by all threads as their rings were full */
+	std::atomic<std::size_t>			dropped_;
 
+	/** Timestamp text up to seconds, formatted once a second */
+	timestamp_type						second_;
+	std::string							second_text_;
 
 	log_writer(std::ostream& s)
-			: out_(s), pid_(::getpid()), finished_(false)
+			: out_(s), pid_(::getpid()), rings_(), sleeping_(false), rings_added_(false),
+			  finished_(false), dropped_(0),
+			  second_(), second_text_()
 	{
 		using boost::gregorian::date_facet;
 		date_facet* f = new date_facet(date_format.c_str());
@@ -209,6 +355,7 @@ struct log_writer {
 		using boost::gregorian::date_facet;
 		date_facet* f = new date_facet(date_format.c_str());
 		out_.imbue(std::locale(std::locale::classic(), f));
+		second_text_.clear();
 	}
 
 	void
@@ -238,55 +385,40 @@ struct log_writer {
         #elif defined MACOSX
         pthread_setname_np("logger");
         #endif
-		while (!finished_) {
+		ring_list rings;
+		while (true) {
 			try {
-                event_queue events;
+				bool finished = finished_;
+				// Drop the references of the previous pass, a ring is used only
+				// by the list and its thread
+				rings.clear();
 				{
-                    unique_lock lock{mtx_};
-					while (events_.empty() && !finished_) cond_.wait(lock);
-                    events.swap(events_);
-				}
-
-                while (!events.empty()) {
-                    while (!events.empty()) {
-					event_ptr e;
-                        e = events.front();
-                        events.pop();
-						if (!e) break;
-
-					event_data& evt = *e;
-					std::ostream::sentry s(out_);
-					if (s) {
-						bool use_colors = logger_use_colors;
-						if (use_colors)
-							out_ << severity_colors[ evt.severity_ ];
-						// process name
-						out_ << std::setw(PROC_NAME_MAX_LEN + 1) << std::left << proc_name() << ' ';
-						// pid
-						out_ << std::setw(6) << std::left << pid_ << ' ';
-						// thread no
-						out_ << std::setw(4) << std::left << evt.thread_no_ << ' ';
-						// category
-						out_ << std::setw(CATEGORY_MAX_LEN + 1) << evt.category_;
-						// timestamp
-						out_ << evt.timestamp_.date() << ' ' << evt.timestamp_.time_of_day() << ' ';
-						out_ << std::setw(8) << std::left << evt.severity_;
-
-						std::istreambuf_iterator<char> eob;
-						std::istreambuf_iterator<char> bi(&evt.buffer_);
-						std::ostream_iterator<char> out(out_);
-						std::copy(bi, eob, out);
-						if (use_colors)
-							out_ << util::CLEAR;
-						*out++ = '\n';
-						if (flush_stream_)
-							out_.flush();
-					}
-					}
-                    unique_lock lock{mtx_};
-                    events.swap(events_);
+					unique_lock lock{mtx_};
+					// Forget the rings of exited threads
+					rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+						[](ring_ptr const& r)
+						{
+							return r.use_count() == 1 && r->empty()
+									&& !r->has_dropped();
+						}), rings_.end());
+					rings = rings_;
+					rings_added_ = false;
 				}
-                out_.flush();
+				if (write_events(rings) > 0)
+					continue;
+				if (finished)
+					break;
+
+				unique_lock lock{mtx_};
+				sleeping_ = true;
+				// Pairs with the fence in notify: either the writer sees the
+				// event or the thread sees the writer sleeping
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				cond_.wait(lock, [&]()
+					{
+						return finished_ || rings_added_ || has_events(rings);
+					});
+				sleeping_ = false;
 			} catch (::std::exception const& e) {
                 auto time = boost::posix_time::microsec_clock::universal_time();
 				out_ << time.time_of_day() << " Exception in logging thread: " << e.what() << ::std::endl;
@@ -295,14 +427,171 @@ struct log_writer {
 				out_ << time.time_of_day() << " Unknown exception in logging thread"<< ::std::endl;
 			}
 		}
+		out_.flush();
 	}
 
+	/**
+	 * Write the events from all rings in the order of their timestamps
+	 * @return Number of events written
+	 */
+	std::size_t
+	write_events(ring_list const& rings)
+	{
+		std::size_t written = 0;
+		for (; written < max_batch; ++written) {
+			event_ring* ring = nullptr;
+			event_record* next = nullptr;
+			for (auto const& r : rings) {
+				event_record* e = r->front();
+				if (e && (!next || e->timestamp_ < next->timestamp_)) {
+					ring = r.get();
+					next = e;
+				}
+			}
+			if (!next)
+				break;
+			write(*next);
+			ring->pop();
+		}
+		for (auto const& r : rings) {
+			if (std::size_t dropped = r->take_dropped()) {
+				write_dropped(r->thread_no(), dropped);
+				++written;
+			}
+		}
+		if (written > 0)
+			out_.flush();
+		return written;
+	}
+
+	static bool
+	has_events(ring_list const& rings)
+	{
+		for (auto const& r : rings) {
+			if (!r->empty() || r->has_dropped())
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Report the events a thread dropped
+	 */
 	void
-	push(event_ptr e)
+	write_dropped(std::size_t thread_no, std::size_t count)
 	{
-        unique_lock lock{mtx_};
-		events_.push(e);
+		event_record evt{ thread_no, timestamp(), logger::WARNING, "LOG",
+			std::to_string(count) + " events dropped, the log queue of the thread is full" };
+		write(evt);
+	}
+
+	void
+	write(event_record const& evt)
+	{
+		std::ostream::sentry s(out_);
+		if (s) {
+			bool use_colors = logger_use_colors;
+			if (use_colors)
+				out_ << severity_colors[ evt.severity_ ];
+			// process name
+			out_ << std::setw(PROC_NAME_MAX_LEN + 1) << std::left << proc_name() << ' ';
+			// pid
+			out_ << std::setw(6) << std::left << pid_ << ' ';
+			// thread no
+			out_ << std::setw(4) << std::left << evt.thread_no_ << ' ';
+			// category
+			out_ << std::setw(CATEGORY_MAX_LEN + 1) << evt.category_;
+			// timestamp
+			write_timestamp(evt.timestamp_);
+			out_ << ' ';
+			out_ << std::setw(8) << std::left << evt.severity_;
+
+			out_.write(evt.message_.data(), evt.message_.size());
+			if (use_colors)
+				out_ << util::CLEAR;
+			out_.put('\n');
+			if (flush_stream_)
+				out_.flush();
+		}
+	}
+
+	/**
+	 * Same output as the date and time of day of the timestamp written to
+	 * the stream, the text up to seconds is cached.
+	 */
+	void
+	write_timestamp(timestamp_type const& ts)
+	{
+		using boost::posix_time::time_duration;
+		time_duration tod = ts.time_of_day();
+		timestamp_type second{ ts.date(),
+			time_duration{ tod.hours(), tod.minutes(), tod.seconds() } };
+		if (second != second_ || second_text_.empty()) {
+			std::ostringstream os;
+			os.imbue(out_.getloc());
+			os << second.date() << ' ' << second.time_of_day();
+			second_text_ = os.str();
+			second_ = second;
+		}
+		out_ << second_text_;
+		if (auto frac = tod.fractional_seconds()) {
+			char buffer[32];
+			std::snprintf(buffer, sizeof(buffer), ".%0*lld",
+					static_cast<int>(time_duration::num_fractional_digits()),
+					static_cast<long long>(frac));
+			out_ << buffer;
+		}
+	}
+
+	/**
+	 * Create a ring for a logging thread
+	 */
+	ring_ptr
+	add_ring(std::size_t t_no)
+	{
+		auto ring = std::make_shared<event_ring>(t_no);
+		lock_guard lock{mtx_};
+		rings_.push_back(ring);
+		rings_added_ = true;
 		cond_.notify_all();
+		return ring;
+	}
+
+	std::size_t
+	ring_count()
+	{
+		lock_guard lock{mtx_};
+		return rings_.size();
+	}
+
+	/**
+	 * Count an event of a thread that didn't fit in its ring
+	 */
+	void
+	drop(event_ring& ring)
+	{
+		ring.drop();
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+		notify();
+	}
+
+	std::size_t
+	dropped_events() const
+	{
+		return dropped_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Wake up the writer if it waits for events
+	 */
+	void
+	notify()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeping_) {
+			lock_guard lock{mtx_};
+			cond_.notify_all();
+		}
 	}
 
 	void
@@ -314,21 +603,29 @@ struct log_writer {
 	}
 };
 
+constexpr std::size_t log_writer::max_batch;
+
 struct logger::impl {
-	struct thread_number {
-		size_t no;
+	struct thread_data {
+		event_data				event;
+		log_writer::ring_ptr	ring;
+
+		thread_data(size_t t_no, log_writer::ring_ptr r)
+			: event(t_no), ring(r)
+		{
+		}
 	};
-    using thread_event_ptr = boost::thread_specific_ptr<event_data>;
-    using thread_number_ptr = boost::thread_specific_ptr<thread_number>;
-    using event_ptr = std::shared_ptr<event_data>;
+    using thread_data_ptr = boost::thread_specific_ptr<thread_data>;
+
+	/** Times a thread waits for the writer to free a record of a full ring */
+	static constexpr std::size_t max_push_retries = 64;
 
 	log_writer writer_;
 	std::thread writer_thread_;
 
-	thread_event_ptr event_;
-	thread_number_ptr thread_no_;
+	thread_data_ptr thread_;
 
-	bool finished_;
+	std::atomic<bool> finished_;
 
     impl(std::ostream& out)
 			: writer_(out), writer_thread_(), finished_(false)
@@ -351,23 +648,40 @@ struct logger::impl {
 		}
 	}
 
-	size_t
+	static size_t
 	thread_no()
 	{
-		static size_t t_no = 0;
-		if (!thread_no_.get()) {
-			thread_no_.reset(new thread_number{ t_no++ });
+		static std::atomic<size_t> t_no{0};
+		return t_no++;
+	}
+
+	thread_data&
+	current_thread()
+	{
+		if (!thread_.get()) {
+			size_t t_no = thread_no();
+			thread_.reset(new thread_data( t_no, writer_.add_ring(t_no) ));
 		}
-		return thread_no_->no;
+		return *thread_;
 	}
 
+	/**
+	 * Current event of the thread, doesn't start it
+	 */
+	event_data&
+	current_event()
+	{
+		return current_thread().event;
+	}
 	event_data&
 	event()
 	{
-		if (!event_.get()) {
-			event_.reset(new event_data( thread_no() ));
+		event_data& evt = current_event();
+		if (!evt.started_) {
+			evt.timestamp_ = timestamp();
+			evt.started_ = true;
 		}
-		return *event_;
+		return evt;
 	}
 	std::streambuf&
 	buffer()
@@ -386,7 +700,7 @@ struct logger::impl {
 	{
 		event_data& evt = event();
 		if (c.size() > CATEGORY_MAX_LEN) {
-			evt.category_ = c.substr(0, CATEGORY_MAX_LEN);
+			evt.category_.assign(c, 0, CATEGORY_MAX_LEN);
 		} else {
 			evt.category_ = c;
 		}
@@ -395,13 +709,44 @@ struct logger::impl {
 	void
 	flush()
 	{
-        if (!finished_ && event_.get()) {
-            event_ptr e(event_.release());
-            if (logger::min_severity() <= e->severity_
-                && logger::OFF < e->severity_) {
-                writer_.push(e);
+		if (!finished_ && thread_.get() && thread_->event.started_) {
+			thread_data& td = *thread_;
+			event_data& evt = td.event;
+			if (logger::min_severity() <= evt.severity_
+				&& logger::OFF < evt.severity_) {
+				push(td);
+			}
+			evt.reset();
 		}
+	}
+
+	/**
+	 * Copy the event to the thread ring. If the ring is full, wait a bit for
+	 * the writer, then drop the event so that a thread is never blocked by
+	 * a slow output.
+	 */
+	void
+	push(thread_data& td)
+	{
+		event_data& evt = td.event;
+		event_record* rec = td.ring->back();
+		for (std::size_t retry = 0; !rec && retry < max_push_retries; ++retry) {
+			writer_.notify();
+			std::this_thread::yield();
+			rec = td.ring->back();
 		}
+		if (!rec) {
+			writer_.drop(*td.ring);
+			return;
+		}
+		rec->thread_no_ = evt.thread_no_;
+		rec->timestamp_ = evt.timestamp_;
+		rec->severity_ = evt.severity_;
+		rec->category_ = evt.category_;
+		rec->message_.resize(evt.buffer_.size());
+		evt.buffer_.sgetn(&rec->message_[0], rec->message_.size());
+		td.ring->push();
+		writer_.notify();
 	}
 
 	void
@@ -421,8 +766,22 @@ struct logger::impl {
     {
         writer_.reopen();
     }
+
+    std::size_t
+    thread_rings()
+    {
+        return writer_.ring_count();
+    }
+
+    std::size_t
+    dropped_events()
+    {
+        return writer_.dropped_events();
+    }
 };
 
+constexpr std::size_t logger::impl::max_push_retries;
+
 logger&
 logger::instance()
 {
@@ -522,7 +881,7 @@ logger::severity(event_severity s)
 logger::event_severity
 logger::severity() const
 {
-	return pimpl_->event().severity_;
+	return pimpl_->current_event().severity_;
 }
 
 logger&
@@ -545,6 +904,18 @@ logger::rotate()
     pimpl_->rotate();
 }
 
+std::size_t
+logger::thread_rings()
+{
+    return pimpl_->thread_rings();
+}
+
+std::size_t
+logger::dropped_events()
+{
+    return pimpl_->dropped_events();
+}
+
 }  // namespace log
 namespace util {
 
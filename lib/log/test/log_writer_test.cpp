@@ -0,0 +1,138 @@
+/*
+ * log_writer_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <pushkin/log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+LOCAL_LOGGING_FACILITY(LOGTEST, TRACE);
+
+TEST(LogWriter, ExitedThreadRingsReleased)
+{
+    const std::size_t thread_count = 8;
+    const int event_count = 100;
+
+    std::ostringstream out;
+    logger::set_stream(out);
+    logger::min_severity(logger::TRACE);
+    logger& log = logger::instance();
+
+    std::atomic<std::size_t> logged{0};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&, i]()
+        {
+            for (int n = 0; n < event_count; ++n) {
+                local_log() << "Thread " << i << " event " << n;
+            }
+            ++logged;
+            released.wait();
+        });
+    }
+    while (logged < thread_count)
+        std::this_thread::yield();
+    EXPECT_EQ(thread_count, log.thread_rings());
+
+    release.set_value();
+    for (auto& t : threads)
+        t.join();
+
+    // Wake up the writer
+    local_log() << "Threads finished";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (log.thread_rings() > 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // Only the ring of this thread is left
+    EXPECT_EQ(1u, log.thread_rings());
+
+    // Replacing the stream writes the pending events
+    logger::set_stream(std::clog);
+    std::string text = out.str();
+    EXPECT_EQ(thread_count * event_count + 1,
+            static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')));
+}
+
+namespace {
+
+/**
+ * Stream buffer that blocks the writer until the gate is opened
+ */
+class gated_buffer : public std::stringbuf {
+public:
+    gated_buffer(std::shared_future<void> gate) : gate_{gate} {}
+protected:
+    int_type
+    overflow(int_type c) override
+    {
+        gate_.wait();
+        return std::stringbuf::overflow(c);
+    }
+    std::streamsize
+    xsputn(char const* s, std::streamsize n) override
+    {
+        gate_.wait();
+        return std::stringbuf::xsputn(s, n);
+    }
+private:
+    std::shared_future<void> gate_;
+};
+
+}  // namespace
+
+TEST(LogWriter, FullRingDropsEvents)
+{
+    const int event_count = 10000;
+
+    std::promise<void> open;
+    gated_buffer buffer{ open.get_future().share() };
+    std::ostream out{&buffer};
+    logger::set_stream(out);
+    logger::min_severity(logger::TRACE);
+    logger& log = logger::instance();
+
+    // The writer is stuck on the first event, the thread is not
+    auto logged = std::async(std::launch::async, [&]()
+    {
+        for (int n = 0; n < event_count; ++n) {
+            local_log() << "Event " << n;
+        }
+    });
+    ASSERT_EQ(std::future_status::ready, logged.wait_for(std::chrono::seconds(10)))
+        << "Logging thread is blocked by the writer";
+    std::size_t dropped = log.dropped_events();
+    EXPECT_LT(0u, dropped);
+
+    open.set_value();
+    logger::set_stream(std::clog);
+
+    // Every event is either written or reported as dropped
+    std::istringstream text{buffer.str()};
+    std::size_t written = 0, reported = 0;
+    std::string line;
+    while (std::getline(text, line)) {
+        auto pos = line.find(" events dropped");
+        if (pos == std::string::npos) {
+            ++written;
+        } else {
+            auto start = line.rfind(' ', pos - 1) + 1;
+            reported += std::stoul(line.substr(start, pos - start));
+        }
+    }
+    EXPECT_EQ(dropped, reported);
+    EXPECT_EQ(static_cast<std::size_t>(event_count), written + reported);
+}
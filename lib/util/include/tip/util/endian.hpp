@@ -9,11 +9,17 @@
 #define LIB_PG_ASYNC_INCLUDE_TIP_UTIL_ENDIAN_HPP_
 
 #include <boost/predef/other/endian.h>
-#include <boost/predef/detail/endian_compat.h>
 #include <boost/cstdint.hpp>
 #include <boost/endian/detail/intrinsic.hpp>
 #include <type_traits>
 
+// boost/predef/detail/endian_compat.h is gone since Boost 1.73
+#if BOOST_ENDIAN_BIG_BYTE && !defined(BOOST_BIG_ENDIAN)
+#define BOOST_BIG_ENDIAN
+#elif BOOST_ENDIAN_LITTLE_BYTE && !defined(BOOST_LITTLE_ENDIAN)
+#define BOOST_LITTLE_ENDIAN
+#endif
+
 namespace tip {
 namespace util {
 namespace endian {
@@ -13,13 +13,6 @@
 #include <tip/db/pg/asio_config.hpp>
 #include <tip/db/pg/detail/protocol.hpp>
 
-namespace boost {
-namespace asio {
-// forward declaration
-class io_service;
-}  // namespace asio
-}  // namespace boost
-
 namespace tip {
 namespace db {
 namespace pg {
@@ -60,9 +53,13 @@ struct execute {
 struct execute_prepared {
     std::string                 expression;
     type_oid_sequence           param_types;
-    std::vector< byte >         params;
+    /** Encoded parameters, shared with the query that encoded them */
+    params_buffer_ptr           params;
     query_internal_callback     result;
     query_error_callback        error;
+    /** Statement shared by runs of a prepared query, if set the expression
+     * and parameter types are taken from it */
+    prepared_statement_ptr      statement;
 };
 
 }
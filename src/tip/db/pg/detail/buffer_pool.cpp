@@ -0,0 +1,95 @@
+/*
+ * buffer_pool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <tip/db/pg/detail/buffer_pool.hpp>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace detail {
+
+constexpr std::size_t buffer_pool::default_max_bytes;
+constexpr std::size_t buffer_pool::max_arenas;
+
+buffer_pool::buffer_pool(std::size_t max_bytes)
+	: max_bytes_(max_bytes), pooled_bytes_(0)
+{
+	arenas_.reserve(max_arenas);
+}
+
+message_ptr
+buffer_pool::acquire_message()
+{
+	if (spare_message_) {
+		message_ptr m;
+		m.swap(spare_message_);
+		return m;
+	}
+	return std::make_shared<message>();
+}
+
+void
+buffer_pool::release_message(message_ptr&& msg)
+{
+	if (msg && msg.use_count() == 1) {
+		msg->clear();
+		spare_message_ = std::move(msg);
+	}
+	msg.reset();
+}
+
+row_arena
+buffer_pool::acquire_arena()
+{
+	row_arena arena;
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!arenas_.empty()) {
+		arena = std::move(arenas_.back());
+		arenas_.pop_back();
+		pooled_bytes_ -= arena.capacity();
+	}
+	return arena;
+}
+
+void
+buffer_pool::release_arena(row_arena&& arena)
+{
+	row_arena tmp(std::move(arena));
+	tmp.clear();
+	tmp.shrink(max_bytes_);
+	std::size_t bytes = tmp.capacity();
+	if (bytes == 0)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (arenas_.size() < max_arenas && pooled_bytes_ + bytes <= max_bytes_) {
+			pooled_bytes_ += bytes;
+			arenas_.push_back(std::move(tmp));
+			return;
+		}
+	}
+	// The pool is full, the arena is freed outside of the lock
+}
+
+std::size_t
+buffer_pool::pooled_arenas() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return arenas_.size();
+}
+
+std::size_t
+buffer_pool::pooled_bytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return pooled_bytes_;
+}
+
+} /* namespace detail */
+} /* namespace pg */
+} /* namespace db */
+} /* namespace tip */
@@ -0,0 +1,96 @@
+/*
+ * buffer_pool.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_SRC_TIP_DB_PG_DETAIL_BUFFER_POOL_HPP_
+#define LIB_PG_ASYNC_SRC_TIP_DB_PG_DETAIL_BUFFER_POOL_HPP_
+
+#include <tip/db/pg/detail/protocol.hpp>
+#include <tip/db/pg/detail/row_arena.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace detail {
+
+/**
+ * Per-connection pool of message buffers and row arenas.
+ *
+ * Messages are reused as soon as nobody holds them. The row arena of a result
+ * is returned to the pool when the last resultset referencing it is released
+ * and is handed out again, with its memory, to the next result of the
+ * connection. Messages are used only by the connection, arenas can be
+ * returned from any thread.
+ */
+class buffer_pool {
+public:
+	/** Default maximum memory kept in pooled arenas */
+	static constexpr std::size_t default_max_bytes = 16 * 1024 * 1024;
+	/** Maximum number of released arenas waiting for reuse */
+	static constexpr std::size_t max_arenas = 8;
+public:
+	explicit
+	buffer_pool(std::size_t max_bytes = default_max_bytes);
+
+	buffer_pool(buffer_pool const&) = delete;
+	buffer_pool&
+	operator = (buffer_pool const&) = delete;
+
+	/**
+	 * Get an empty message for reading from the stream.
+	 */
+	message_ptr
+	acquire_message();
+	/**
+	 * Return a message to the pool. The message is reused only if the
+	 * pointer passed is the only reference to it.
+	 */
+	void
+	release_message(message_ptr&& msg);
+
+	/**
+	 * Get an empty arena with memory left from a released result, if any.
+	 * Thread safe.
+	 */
+	row_arena
+	acquire_arena();
+	/**
+	 * Return the arena of a result to the pool. Thread safe.
+	 */
+	void
+	release_arena(row_arena&& arena);
+
+	/**
+	 * Number of arenas available for reuse
+	 */
+	std::size_t
+	pooled_arenas() const;
+	/**
+	 * Memory held by the arenas available for reuse
+	 */
+	std::size_t
+	pooled_bytes() const;
+private:
+	std::size_t					max_bytes_;
+	message_ptr					spare_message_;
+
+	mutable std::mutex			mutex_;
+	std::vector<row_arena>		arenas_;
+	std::size_t					pooled_bytes_;
+};
+
+typedef std::shared_ptr<buffer_pool> buffer_pool_ptr;
+
+} /* namespace detail */
+} /* namespace pg */
+} /* namespace db */
+} /* namespace tip */
+
+#endif /* LIB_PG_ASYNC_SRC_TIP_DB_PG_DETAIL_BUFFER_POOL_HPP_ */
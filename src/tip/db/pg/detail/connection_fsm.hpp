@@ -13,6 +13,8 @@
 #include <stack>
 #include <set>
 #include <memory>
+#include <mutex>
+#include <type_traits>
 
 #include <afsm/fsm.hpp>
 
@@ -26,6 +28,7 @@
 #include <tip/db/pg/detail/protocol.hpp>
 #include <tip/db/pg/detail/md5.hpp>
 #include <tip/db/pg/detail/result_impl.hpp>
+#include <tip/db/pg/detail/buffer_pool.hpp>
 #include <tip/db/pg/detail/connection_observer.hpp>
 
 #include <tip/db/pg/log.hpp>
@@ -51,6 +54,8 @@ struct ready_for_query {
 
 struct row_description {
     mutable std::vector<field_description> fields;
+    /** Column name index, cached for prepared statements */
+    mutable detail::result_impl::name_index_ptr name_index;
 };
 
 struct row_event {
@@ -60,6 +65,8 @@ struct row_event {
 
     detail::row_data&
     row() { return *data; }
+    detail::row_data const&
+    row() const { return *data; }
 
     detail::row_data
     move_row() const
@@ -82,6 +89,21 @@ struct terminate {};
 namespace detail {
 
 LOCAL_LOGGING_FACILITY_CFG_FUNC(PGFSM, config::INTERNALS_LOG, fsm_log);
+/**
+ * Logger returned by the FSM log functions with the default severity,
+ * log statements are compiled out when the default severity is OFF
+ */
+using fsm_log_type = ::psst::log::local_type< PGFSM_DEFAULT_SEVERITY >::type;
+
+#ifdef PGASYNC_SINGLE_STRAND
+/**
+ * Connection events are processed in the connection strand, the state
+ * machine doesn't lock
+ */
+using connection_mutex_type = ::afsm::none;
+#else
+using connection_mutex_type = ::std::mutex;
+#endif
 
 template < typename Mutex, typename TransportType, typename SharedType >
 struct connection_fsm_def : ::afsm::def::state_machine<
@@ -100,6 +122,13 @@ struct connection_fsm_def : ::afsm::def::state_machine<
 
     using connection_fsm_type = ::afsm::state_machine<this_type, Mutex, connection_observer>;
     using none = ::afsm::none;
+    /**
+     * Without a mutex all events are processed in the connection strand:
+     * calls from other threads are posted to it and the IO handlers are
+     * wrapped by it.
+     */
+    static constexpr bool single_strand = ::std::is_same< Mutex, none >::value;
+    using single_strand_type = ::std::integral_constant< bool, single_strand >;
 
     template < typename StateDef, typename ... Tags >
     using state = ::afsm::def::state<StateDef, Tags...>;
@@ -358,6 +387,58 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                 }
             }
         };
+        /**
+         * Commit or rollback arriving when the transaction is already
+         * rolled back or closing. A commit is reported as an error, a
+         * rollback as done.
+         */
+        struct tran_closing {
+            template < typename SourceState, typename TargetState >
+            void
+            operator() (events::commit const& evt, transaction_fsm_type& fsm,
+                    SourceState&, TargetState&)
+            {
+                fsm.log(logger::WARNING)
+                        << "Commit event queued after transaction rollback";
+                if (evt.error) {
+                    auto error_cb = evt.error;
+                    fsm.connection().async_notify(
+                        [error_cb](){
+                            try {
+                                error_cb(error::query_error("Transaction rolled back"));
+                            } catch (::std::exception const& e) {
+                                fsm_log(logger::WARNING) << "Exception in commit error handler " << e.what();
+                            } catch (...) {
+                                // Ignore handler error
+                                fsm_log(logger::WARNING) << "Exception in commit error handler";
+                            }
+                        }
+                    );
+                }
+            }
+            template < typename SourceState, typename TargetState >
+            void
+            operator() (events::rollback const& evt, transaction_fsm_type& fsm,
+                    SourceState&, TargetState&)
+            {
+                fsm.log() << "Rollback event queued after transaction rollback";
+                if (evt.callback) {
+                    auto cb = evt.callback;
+                    fsm.connection().async_notify(
+                        [cb](){
+                            try {
+                                cb();
+                            } catch (::std::exception const& e) {
+                                fsm_log(logger::WARNING) << "Exception in rollback handler " << e.what();
+                            } catch (...) {
+                                // Ignore handler error
+                                fsm_log(logger::WARNING) << "Exception in rollback handler";
+                            }
+                        }
+                    );
+                }
+            }
+        };
         //@}
         //@{
         /** @name Transaction sub-states */
@@ -400,11 +481,16 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             tran() const
             { return fsm().enclosing_fsm(); }
 
-            ::psst::log::local
-            log(logger::event_severity s = PGFSM_DEFAULT_SEVERITY) const
+            fsm_log_type
+            log() const
             {
                 return tran().log();
             }
+            ::psst::log::local
+            log(logger::event_severity s) const
+            {
+                return tran().log(s);
+            }
 
             void
             on_exit(error::query_error const& err, transaction_fsm_type& fsm)
@@ -429,8 +515,8 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             using internal_transitions = transition_table<
             /*                Event              Action                    Guard     */
             /*            +---------------------+-----------------------+---------+*/
-                in< events::commit,        none,                    none    >,
-                in< events::rollback,      none,                    none    >
+                in< events::commit,        tran_closing,            none    >,
+                in< events::rollback,      tran_closing,            none    >
             >;
         };
         struct exiting : state< exiting > {
@@ -475,8 +561,8 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             /*                Event               Action          Guard    */
             /*    +-----------------------------+---------------+---------+*/
                 in< command_complete            , none          , none    >,
-                in< events::commit              , none          , none    >,
-                in< events::rollback            , none          , none    >,
+                in< events::commit              , tran_closing  , none    >,
+                in< events::rollback            , tran_closing  , none    >,
                 in< events::execute             , tran_finished , none    >,
                 in< events::execute_prepared    , tran_finished , none    >
             >;
@@ -516,8 +602,13 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             connection() const
             { return tran().connection(); }
 
+            fsm_log_type
+            log() const
+            {
+                return tran().log();
+            }
             ::psst::log::local
-            log(logger::event_severity s = PGFSM_DEFAULT_SEVERITY) const
+            log(logger::event_severity s) const
             {
                 return tran().log(s);
             }
@@ -589,14 +680,16 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                         simple_query_fsm_type& fsm)
                 {
                     // TODO Don't reset the resultset
-                    result_.reset(new result_impl); // TODO Number of resultset
+                    result_.reset(new result_impl(fsm.connection().buffers())); // TODO Number of resultset
                     result_->row_description().swap(rd.fields);
+                    fsm.connection().open_row_sink(*result_);
                 }
 
                 template < typename Event >
                 void
                 on_exit(Event const&, simple_query_fsm_type& fsm)
                 {
+                    fsm.connection().close_row_sink();
                     fsm.tran().notify_result(fsm, resultset(result_), true);
                 }
 
@@ -607,7 +700,7 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                             fetch_data& fetch, TargetState&)
                     {
                         // TODO Move the data from event
-                        fetch.result_->rows().push_back(row.move_row());
+                        fetch.result_->add_row(row.row());
                     }
                 };
 
@@ -666,8 +759,13 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             connection() const
             { return tran().connection(); }
 
+            fsm_log_type
+            log() const
+            {
+                return tran().log();
+            }
             ::psst::log::local
-            log(logger::event_severity s = PGFSM_DEFAULT_SEVERITY) const
+            log(logger::event_severity s) const
             {
                 return tran().log(s);
             }
@@ -675,17 +773,15 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             void
             on_enter(events::execute_prepared const& q, transaction_fsm_type&)
             {
-                query_ = q;
-                std::ostringstream os;
-                os << query_.expression;
-                if (!query_.param_types.empty()) {
-                    os << "{";
-                    std::ostream_iterator< oids::type::oid_type > out(os, ",");
-                    std::copy( query_.param_types.begin(), query_.param_types.end() - 1, out );
-                    os << query_.param_types.back() << "}";
+                if (q.statement) {
+                    statement_ = q.statement;
+                } else {
+                    statement_ = ::std::make_shared< prepared_statement const >(
+                            q.expression, q.param_types);
                 }
-                query_name_ = "q_" +
-                    std::string( boost::md5( os.str().c_str() ).digest().hex_str_value() );
+                query_.params = q.params;
+                query_.result = q.result;
+                query_.error = q.error;
             }
             template < typename Event, typename FSM >
             void
@@ -711,24 +807,24 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             bool
             is_query_prepared() const
             {
-                return connection().is_prepared(query_name_);
+                return connection().is_prepared(statement_->name);
             }
 
             void
             send_parse()
             {
-                tran().log() << "Parse query " << query_.expression;
+                tran().log() << "Parse query " << statement_->expression;
                 message cmd(parse_tag);
-                cmd.write(query_name_);
-                cmd.write(query_.expression);
-                cmd.write( (smallint)query_.param_types.size() );
-                for (oids::type::oid_type oid : query_.param_types) {
+                cmd.write(statement_->name);
+                cmd.write(statement_->expression);
+                cmd.write( (smallint)statement_->param_types.size() );
+                for (oids::type::oid_type oid : statement_->param_types) {
                     cmd.write( (integer)oid );
                 }
 
                 message describe(describe_tag);
                 describe.write('S');
-                describe.write(query_name_);
+                describe.write(statement_->name);
                 cmd.pack(describe);
                 cmd.pack(message(sync_tag));
 
@@ -738,19 +834,28 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             void
             send_bind_exec()
             {
+                std::size_t field_count = is_query_prepared() ?
+                        connection().get_prepared(statement_->name).fields.size() : 0;
+                bool has_params = query_.params && !query_.params->empty();
                 message cmd(bind_tag);
+                // Bind, Execute and Sync messages are sent in a single buffer
+                cmd.reserve(
+                    5 + portal_name_.size() + 1 + statement_->name.size() + 1 +
+                    (has_params ? query_.params->size() : sizeof(smallint) * 2) +
+                    sizeof(smallint) * (1 + field_count) +
+                    5 + portal_name_.size() + 1 + sizeof(integer) +
+                    5);
                 cmd.write(portal_name_);
-                cmd.write(query_name_);
-                if (!query_.params.empty()) {
-                    auto out = cmd.output();
-                    std::copy(query_.params.begin(), query_.params.end(), out);
+                cmd.write(statement_->name);
+                if (has_params) {
+                    cmd.write(query_.params->data(), query_.params->size());
                 } else {
                     cmd.write((smallint)0); // parameter format codes
                     cmd.write((smallint)0); // number of parameters
                 }
                 if (is_query_prepared()) {
                     events::row_description const& row =
-                            connection().get_prepared(query_name_);
+                            connection().get_prepared(statement_->name);
                     cmd.write((smallint)row.fields.size());
                     tran().log() << "Write " << row.fields.size() << " field formats";
                     for (auto const& fd : row.fields) {
@@ -760,7 +865,7 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                     cmd.write((smallint)0); // no row description
                 }
 
-                tran().log() << "Execute prepared query: " << query_.expression;
+                tran().log() << "Execute prepared query: " << statement_->expression;
 
                 message execute(execute_tag);
                 execute.write(portal_name_);
@@ -789,9 +894,11 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                         if (io::traits::has_binary_parser(fd.type_oid))
                             fd.format_code = BINARY_DATA_FORMAT;
                     }
-                    fsm.result_.reset(new result_impl);
+                    row.name_index = result_impl::build_name_index(row.fields);
+                    fsm.result_.reset(new result_impl(fsm.connection().buffers()));
                     fsm.result_->row_description() = row.fields; // copy!
-                    fsm.connection().set_prepared(fsm.query_name_, row);
+                    fsm.result_->set_name_index(row.name_index);
+                    fsm.connection().set_prepared(fsm.statement_->name, row);
                 }
                 template < typename SourceState, typename TargetState >
                 void
@@ -800,7 +907,7 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                 {
                     fsm.result_.reset(new result_impl);
                     events::row_description row;
-                    fsm.connection().set_prepared(fsm.query_name_, row);
+                    fsm.connection().set_prepared(fsm.statement_->name, row);
                 }
             };
             struct skip_parsing {
@@ -810,9 +917,11 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                 operator()(Event const&, extended_query& fsm,
                         SourceState&, TargetState&)
                 {
-                    fsm.result_.reset(new result_impl);
-                    fsm.result_->row_description() =
-                            fsm.connection().get_prepared(fsm.query_name_).fields;
+                    events::row_description const& prepared =
+                            fsm.connection().get_prepared(fsm.statement_->name);
+                    fsm.result_.reset(new result_impl(fsm.connection().buffers()));
+                    fsm.result_->row_description() = prepared.fields;
+                    fsm.result_->set_name_index(prepared.name_index);
                 }
             };
             struct parse_data_row {
@@ -821,7 +930,7 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                 operator() (events::row_event const& row, extended_query& fsm,
                         SourceState&, TargetState&)
                 {
-                    fsm.result_->rows().push_back(row.move_row());
+                    fsm.result_->add_row(row.row());
                 }
             };
             struct complete_execution {
@@ -867,10 +976,18 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             };
 
             struct exec : state< exec > {
+                template < typename Event >
+                void
+                on_enter(Event const&, extended_query_fsm_type& fsm)
+                {
+                    fsm.connection().open_row_sink(*fsm.result_);
+                }
+
                 template < typename Event >
                 void
                 on_exit(Event const&, extended_query_fsm_type& fsm)
                 {
+                    fsm.connection().close_row_sink();
                     fsm.tran().log() << "Exit exec state resultset columns "
                             << fsm.result_->row_description().size()
                             << " rows " << fsm.result_->size();
@@ -880,11 +997,13 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                 void
                 on_exit(error::query_error const& err, extended_query_fsm_type& fsm)
                 {
+                    fsm.connection().close_row_sink();
                     fsm.tran().notify_error(fsm, err);
                 }
                 void
                 on_exit(error::db_error const& err, extended_query_fsm_type& fsm)
                 {
+                    fsm.connection().close_row_sink();
                     fsm.tran().notify_error(err);
                 }
 
@@ -903,13 +1022,13 @@ struct connection_fsm_def : ::afsm::def::state_machine<
                 bool
                 operator()(FSM& fsm, State&) const
                 {
-                    return fsm.connection().is_prepared(fsm.query_name_);
+                    return fsm.connection().is_prepared(fsm.statement_->name);
                 }
                 template < class EVT, class SourceState, class TargetState>
                 bool
                 operator()(EVT const&, extended_query_fsm_type& fsm, SourceState&,TargetState&)
                 {
-                    return fsm.connection().is_prepared(fsm.query_name_);
+                    return fsm.connection().is_prepared(fsm.statement_->name);
                 }
             };
             //@{
@@ -929,7 +1048,7 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             //@}
 
             events::execute_prepared query_;
-            std::string query_name_;
+            prepared_statement_ptr statement_;
             std::string portal_name_;
             integer row_limit_;
 
@@ -1118,8 +1237,13 @@ struct connection_fsm_def : ::afsm::def::state_machine<
         }
         //@}
 
+        fsm_log_type
+        log() const
+        {
+            return connection().log();
+        }
         ::psst::log::local
-        log(logger::event_severity s = PGFSM_DEFAULT_SEVERITY) const
+        log(logger::event_severity s) const
         {
             return connection().log(s);
         }
@@ -1175,7 +1299,9 @@ struct connection_fsm_def : ::afsm::def::state_machine<
         : shared_base(), io_service_{svc}, strand_{*svc}, transport_{svc},
           client_opts_{co},
           serverPid_{0}, serverSecret_{0}, in_transaction_{false},
-          connection_number_{ next_connection_number() }
+          connection_number_{ next_connection_number() },
+          buffers_{ ::std::make_shared< detail::buffer_pool >() },
+          row_event_{}, row_sink_{nullptr}, rows_direct_{false}
     {
         incoming_.prepare(8192); // FIXME Magic number, move to configuration
     }
@@ -1188,8 +1314,8 @@ struct connection_fsm_def : ::afsm::def::state_machine<
         return connection_number_;
     }
 
-    void
-    connect_transport(connection_options const& opts)
+    static void
+    check_options(connection_options const& opts)
     {
         if (opts.uri.empty()) {
             throw error::connection_error("No connection uri!");
@@ -1200,13 +1326,19 @@ struct connection_fsm_def : ::afsm::def::state_machine<
         if (opts.user.empty()) {
             throw error::connection_error("User not specified!");
         }
+    }
+
+    void
+    connect_transport(connection_options const& opts)
+    {
+        check_options(opts);
         conn_opts_ = opts;
         auto _this = shared_base::shared_from_this();
-        transport_.connect_async(conn_opts_,
+        transport_.connect_async(conn_opts_, io_handler(
             [_this](asio_config::error_code const& ec)
             {
                 _this->handle_connect(ec);
-            });
+            }, single_strand_type{}));
     }
     void
     close_transport()
@@ -1218,11 +1350,11 @@ struct connection_fsm_def : ::afsm::def::state_machine<
     start_read()
     {
         auto _this = shared_base::shared_from_this();
-        transport_.async_read(incoming_,
+        transport_.async_read(incoming_, io_handler(
             [_this](asio_config::error_code const& ec, size_t bytes_transferred)
             {
                 _this->handle_read(ec, bytes_transferred);
-            });
+            }, single_strand_type{}));
     }
 
     void
@@ -1276,7 +1408,7 @@ struct connection_fsm_def : ::afsm::def::state_machine<
             transport_.async_write(
                 ASIO_NAMESPACE::buffer(&*data_range.first,
                         data_range.second - data_range.first),
-                write_handler
+                io_handler(write_handler, single_strand_type{})
             );
         }
     }
@@ -1285,6 +1417,11 @@ struct connection_fsm_def : ::afsm::def::state_machine<
     options() const
     { return conn_opts_; }
 
+    /** Message buffers and row arenas of the connection */
+    detail::buffer_pool_ptr const&
+    buffers() const
+    { return buffers_; }
+
     //@{
     /** @name Prepared queries */
     bool
@@ -1316,6 +1453,34 @@ struct connection_fsm_def : ::afsm::def::state_machine<
         return in_transaction_;
     }
     //@}
+
+    //@{
+    /** @name Data row fast path */
+    /**
+     * Called by a state that collects data rows on entry. After the FSM has
+     * processed a data row in the reading thread, the following rows are
+     * added to the result directly, until a message other than DataRow
+     * arrives or the state closes the sink.
+     * The sink is published with release semantics and read by the reading
+     * thread with acquire semantics, so no lock is taken per row.
+     */
+    void
+    open_row_sink(result_impl& res)
+    {
+        row_sink_.store(&res, std::memory_order_release);
+    }
+    void
+    close_row_sink()
+    {
+        row_sink_.store(nullptr, std::memory_order_release);
+    }
+    /** Data rows are added to the result bypassing the FSM */
+    bool
+    rows_bypass_fsm() const
+    {
+        return rows_direct_;
+    }
+    //@}
     //@{
     /** @connection events notifications */
     void
@@ -1353,12 +1518,70 @@ struct connection_fsm_def : ::afsm::def::state_machine<
     }
     //@}
 
+    /**
+     * Process an event coming from outside of the state machine. With the
+     * single strand model the event is dispatched to the connection strand,
+     * otherwise it is processed in the calling thread.
+     */
+    template < typename Event >
+    void
+    post_event(Event&& evt)
+    {
+        post_event(::std::forward<Event>(evt), single_strand_type{});
+    }
+
+    fsm_log_type
+    log() const
+    {
+        return fsm_log() << "Conn# " << connection_number_ << ": ";
+    }
     ::psst::log::local
-    log(logger::event_severity s = PGFSM_DEFAULT_SEVERITY) const
+    log(logger::event_severity s) const
     {
         return fsm_log(s) << "Conn# " << connection_number_ << ": ";
     }
 private:
+    template < typename Event >
+    struct strand_event {
+        ::std::shared_ptr< shared_type >    conn;
+        Event                               event;
+
+        void
+        operator()()
+        {
+            static_cast< this_type& >(*conn).fsm().process_event(::std::move(event));
+        }
+    };
+
+    template < typename Event >
+    void
+    post_event(Event&& evt, ::std::false_type const&)
+    {
+        fsm().process_event(::std::forward<Event>(evt));
+    }
+    template < typename Event >
+    void
+    post_event(Event&& evt, ::std::true_type const&)
+    {
+        strand_.dispatch(strand_event< typename ::std::decay<Event>::type >{
+            shared_base::shared_from_this(), ::std::forward<Event>(evt) });
+    }
+
+    template < typename Handler >
+    static typename ::std::decay<Handler>::type
+    io_handler(Handler&& h, ::std::false_type const&)
+    {
+        return ::std::forward<Handler>(h);
+    }
+    template < typename Handler >
+    auto
+    io_handler(Handler&& h, ::std::true_type const&)
+        -> decltype(::std::declval< asio_config::io_service::strand& >()
+                .wrap(::std::forward<Handler>(h)))
+    {
+        return strand_.wrap(::std::forward<Handler>(h));
+    }
+
     virtual void do_notify_idle() {};
     virtual void do_notify_terminated() {};
     virtual void do_notify_error(error::connection_error const&) {};
@@ -1422,7 +1645,7 @@ private:
         const size_t header_size = sizeof(integer) + sizeof(byte);
         while (max_bytes > 0) {
             if (!message_) {
-                message_.reset(new detail::message);
+                message_ = buffers_->acquire_message();
             }
             auto out = message_->output();
 
@@ -1443,9 +1666,10 @@ private:
             }
             if (message_->size() >= 4 && message_->length() == message_->size()) {
                 message_ptr m = message_;
+                message_.reset();
                 m->reset_read();
                 handle_message(m);
-                message_.reset();
+                buffers_->release_message(::std::move(m));
             }
         }
     }
@@ -1473,6 +1697,11 @@ private:
     {
         namespace util = ::psst::util;
         message_tag tag = m->tag();
+        if (tag == data_row_tag) {
+            handle_data_row(*m);
+            return;
+        }
+        rows_direct_ = false;
         if (message::backend_tags().count(tag)) {
             switch (tag) {
                 case authentication_tag: {
@@ -1552,16 +1781,6 @@ private:
                     fsm().process_event(rd);
                     break;
                 }
-                case data_row_tag: {
-                    events::row_event r;
-                    if (m->read(r.row())) {
-                        fsm().process_event(r);
-                    } else {
-                        // FIXME Process error
-                        log(logger::ERROR) << "Failed to read data row";
-                    }
-                    break;
-                }
                 case parse_complete_tag: {
                     log() << "Parse complete";
                     fsm().process_event(events::parse_complete{});
@@ -1599,6 +1818,35 @@ private:
         }
     }
 
+    void
+    handle_data_row(message& m)
+    {
+        using ::afsm::actions::event_process_result;
+        // Reuse the event unless a copy of it is still queued
+        if (row_event_.data.use_count() > 1)
+            row_event_ = events::row_event{};
+        row_event_.row().clear();
+        if (!m.read(row_event_.row())) {
+            // FIXME Process error
+            log(logger::ERROR) << "Failed to read data row";
+            return;
+        }
+        if (rows_direct_) {
+            if (result_impl* sink = row_sink_.load(std::memory_order_acquire)) {
+                sink->add_row(row_event_.row());
+                return;
+            }
+            rows_direct_ = false;
+        }
+        auto res = fsm().process_event(row_event_);
+        // The row wasn't queued or deferred, so no earlier rows are waiting
+        // in the FSM and the next ones can go to the sink
+        if (res == event_process_result::process ||
+                res == event_process_result::process_in_state) {
+            rows_direct_ = row_sink_.load(std::memory_order_acquire) != nullptr;
+        }
+    }
+
     static size_t
     next_connection_number()
     {
@@ -1625,6 +1873,13 @@ private:
     ::std::atomic<bool>             in_transaction_;
 
     size_t                          connection_number_;
+
+    detail::buffer_pool_ptr         buffers_;
+    events::row_event               row_event_;
+    /** Result that receives data rows directly, set by the FSM */
+    ::std::atomic< result_impl* >   row_sink_;
+    /** Rows bypass the FSM, accessed only by the reading thread */
+    bool                            rows_direct_;
 protected:
     connection_options              conn_opts_;
 };
@@ -1632,17 +1887,18 @@ protected:
 //----------------------------------------------------------------------------
 // Concrete connection
 //----------------------------------------------------------------------------
-template < typename TransportType >
+template < typename TransportType, typename Mutex = connection_mutex_type >
 class concrete_connection : public basic_connection,
-    public ::afsm::state_machine< connection_fsm_def< ::std::mutex, TransportType,
-        concrete_connection< TransportType > >, ::std::mutex, connection_observer > {
+    public ::afsm::state_machine< connection_fsm_def< Mutex, TransportType,
+        concrete_connection< TransportType, Mutex > >, Mutex, connection_observer > {
 public:
     using transport_type = TransportType;
-    using this_type = concrete_connection< transport_type >;
+    using mutex_type = Mutex;
+    using this_type = concrete_connection< transport_type, mutex_type >;
     using fsm_type =
             ::afsm::state_machine<
-                 connection_fsm_def< ::std::mutex, transport_type, this_type >,
-                 ::std::mutex, connection_observer >;
+                 connection_fsm_def< mutex_type, transport_type, this_type >,
+                 mutex_type, connection_observer >;
 public:
     concrete_connection(io_service_ptr svc,
             client_options_type const& co,
@@ -1692,7 +1948,8 @@ private:
     virtual void
     do_connect(connection_options const& co) override
     {
-        fsm_type::process_event(co);
+        fsm_type::check_options(co);
+        fsm_type::post_event(co);
     }
 
     virtual dbalias const&
@@ -1713,7 +1970,7 @@ private:
             log(logger::ERROR) << "Cannot begin transaction: already in transaction";
             throw error::db_error("Already in transaction");
         }
-        fsm_type::process_event(::std::move(evt));
+        fsm_type::post_event(::std::move(evt));
     }
 
     virtual void
@@ -1724,8 +1981,9 @@ private:
             if (ecb) {
                 ecb(error::db_error("Not in transaction"));
             }
+            return;
         }
-        fsm_type::process_event(events::commit{cb, ecb});
+        fsm_type::post_event(events::commit{cb, ecb});
     }
 
     virtual void
@@ -1736,26 +1994,27 @@ private:
             if (ecb) {
                 ecb(error::db_error("Not in transaction"));
             }
+            return;
         }
-        fsm_type::process_event(events::rollback{cb, ecb});
+        fsm_type::post_event(events::rollback{cb, ecb});
     }
 
     virtual void
     do_execute(events::execute&& query) override
     {
-        fsm_type::process_event(::std::move(query));
+        fsm_type::post_event(::std::move(query));
     }
 
     virtual void
     do_execute(events::execute_prepared&& query) override
     {
-        fsm_type::process_event(::std::move(query));
+        fsm_type::post_event(::std::move(query));
     }
 
     virtual void
     do_terminate() override
     {
-        fsm_type::process_event(events::terminate{});
+        fsm_type::post_event(events::terminate{});
     }
 private:
     connection_callbacks            callbacks_;
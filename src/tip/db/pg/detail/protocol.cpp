@@ -171,6 +171,14 @@ message::output()
     return std::back_inserter(payload);
 }
 
+void
+message::clear()
+{
+    payload.clear();
+    curr_ = payload.end();
+    packed_ = false;
+}
+
 void
 message::reset_read()
 {
@@ -275,27 +283,24 @@ message::read(row_data& row)
     }
     smallint col_count(0);
     if (read(col_count)) {
-        row_data tmp;
-        tmp.offsets.reserve(col_count);
+        row.clear();
+        row.offsets.reserve(col_count);
         size_t expected_sz = len - sizeof(integer)*(col_count + 1) - sizeof(int16_t);
-        tmp.data.reserve( expected_sz );
+        row.data.reserve( expected_sz );
         for (int16_t i = 0; i < col_count; ++i) {
-            tmp.offsets.push_back(tmp.data.size());
+            row.offsets.push_back(row.data.size());
             integer col_size(0);
             if (!read(col_size))
                 return false;
             if (col_size == -1) {
-                tmp.null_map.insert(i);
+                row.null_map.push_back(i);
             } else if (col_size > 0) {
-                const_iterator in = curr_;
-                auto out = std::back_inserter(tmp.data);
-                for (; in != curr_ + col_size; ++in) {
-                    *out++ = *in;
-                }
-                curr_ = in;
+                if (payload.cend() - curr_ < col_size)
+                    return false;
+                row.data.insert(row.data.end(), curr_, curr_ + col_size);
+                curr_ += col_size;
             }
         }
-        row.swap(tmp);
         return true;
     }
     return false;
@@ -345,6 +350,18 @@ message::write(std::string const& s)
     payload.push_back(0);
 }
 
+void
+message::write(byte const* data, std::size_t size)
+{
+    payload.insert(payload.end(), data, data + size);
+}
+
+void
+message::reserve(std::size_t size)
+{
+    payload.reserve(size);
+}
+
 void
 message::pack(message const& m)
 {
@@ -385,7 +402,7 @@ bool
 row_data::is_null(size_type index) const
 {
     check_index(index);
-    return null_map.count(index);
+    return std::binary_search(null_map.begin(), null_map.end(), index);
 }
 
 row_data::data_buffer_bounds
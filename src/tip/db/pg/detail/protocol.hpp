@@ -166,6 +166,13 @@ public:
     output_iterator
     output();
 
+    /**
+     * Clear the message for reading it again from the stream, keeping
+     * the allocated memory.
+     */
+    void
+    clear();
+
     //@{
     /** @name Stream read interface */
     /**
@@ -223,7 +230,8 @@ public:
     read(field_description& fd);
 
     /**
-     * Read data row from the message buffer
+     * Read data row from the message buffer. The row is filled in place,
+     * memory already allocated by the row is reused.
      * @param row data row
      * @return true if the operation was successful
      */
@@ -265,8 +273,22 @@ public:
      */
     void
     write(std::string const&);
+    /**
+     * Write raw bytes to the message buffer
+     * @param data
+     * @param size number of bytes
+     */
+    void
+    write(byte const* data, std::size_t size);
     //@}
 
+    /**
+     * Reserve memory for the message payload
+     * @param size the expected size of the message with all packed messages
+     */
+    void
+    reserve(std::size_t size);
+
     /**
      * Append a message to send in a single network package
      * @param
@@ -304,7 +326,8 @@ struct row_data {
 
     typedef uint16_t size_type;
     typedef std::vector< integer > offsets_type;
-    typedef std::set< size_type > null_map_type;
+    /** Sorted indexes of null fields */
+    typedef std::vector< size_type > null_map_type;
 
     offsets_type offsets;
     data_buffer data;
@@ -350,6 +373,16 @@ struct row_data {
         data.swap(rhs.data);
         null_map.swap(rhs.null_map);
     }
+    /**
+     * Clear the row, keeping the allocated memory for reuse
+     */
+    void
+    clear()
+    {
+        offsets.clear();
+        data.clear();
+        null_map.clear();
+    }
 private:
     void
     check_index(size_type index) const;
@@ -7,6 +7,38 @@
 
 #include <tip/db/pg/detail/protocol_parsers.hpp>
 
+#include <tip/util/endian.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+#define PGASYNC_HAVE_STRTOD_L
+#include <locale.h>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+#else
+#include <limits>
+#include <locale>
+#include <sstream>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Byte swaps with SSSE3 and AVX2 are selected at run time, the library
+// needn't be built with -mssse3 or -mavx2
+#if defined(__GNUC__) && defined(__SSE2__) && defined(BOOST_LITTLE_ENDIAN) && \
+		(defined(__x86_64__) || defined(__i386__))
+#define PGASYNC_X86_DISPATCH
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace tip {
 namespace db {
 namespace pg {
@@ -16,18 +48,368 @@ namespace detail {
 char
 bytea_parser::hex_to_byte(char input)
 {
-	if (std::isxdigit(input)) {
-		if ('0' <= input && input <= '0') {
-			return input - '0';
-		} else if ('a' <= input && input <= 'f') {
-			return input - 'a' + 10;
-		} else if ('A' <= input && input <= 'F') {
-			return input - 'A' + 10;
-		}
+	if ('0' <= input && input <= '9') {
+		return input - '0';
+	} else if ('a' <= input && input <= 'f') {
+		return input - 'a' + 10;
+	} else if ('A' <= input && input <= 'F') {
+		return input - 'A' + 10;
 	}
 	return 0;
 }
 
+namespace {
+
+struct hex_table {
+	std::int8_t values[256];
+
+	hex_table()
+	{
+		for (int c = 0; c < 256; ++c) {
+			if ('0' <= c && c <= '9') {
+				values[c] = c - '0';
+			} else if ('a' <= c && c <= 'f') {
+				values[c] = c - 'a' + 10;
+			} else if ('A' <= c && c <= 'F') {
+				values[c] = c - 'A' + 10;
+			} else {
+				values[c] = -1;
+			}
+		}
+	}
+};
+
+hex_table const HEX_TABLE;
+
+bool
+hex_decode_scalar(unsigned char const* hex, std::size_t size, char* out)
+{
+	for (unsigned char const* e = hex + size; hex != e; hex += 2) {
+		int hi = HEX_TABLE.values[hex[0]];
+		int lo = HEX_TABLE.values[hex[1]];
+		if ((hi | lo) < 0)
+			return false;
+		*out++ = static_cast< char >((hi << 4) | lo);
+	}
+	return true;
+}
+
+#ifdef __SSE2__
+/**
+ * Convert 16 hex digits to nibble values, one per byte.
+ * Characters above 0x7f are negative for signed comparisons and fail
+ * both range checks.
+ */
+inline bool
+hex_nibbles(__m128i chars, __m128i& nibbles)
+{
+	__m128i const lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+	__m128i const digit = _mm_and_si128(
+			_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+			_mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+	__m128i const alpha = _mm_and_si128(
+			_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+			_mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+	if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xffff)
+		return false;
+	nibbles = _mm_or_si128(
+			_mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+			_mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+	return true;
+}
+
+/**
+ * Combine pairs of nibbles into bytes in 16 bit lanes:
+ * first (lower) byte is the most significant nibble.
+ */
+inline __m128i
+hex_combine(__m128i nibbles)
+{
+	return _mm_or_si128(
+			_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4),
+			_mm_srli_epi16(nibbles, 8));
+}
+#endif
+
+}  // namespace
+
+bool
+hex_decode(char const* hex, std::size_t size, char* out)
+{
+	if (size % 2)
+		return false;
+	unsigned char const* p = reinterpret_cast< unsigned char const* >(hex);
+	unsigned char const* e = p + size;
+#ifdef __AVX2__
+	for (; e - p >= 64; p += 64, out += 32) {
+		__m128i n[4];
+		for (int i = 0; i < 4; ++i) {
+			if (!hex_nibbles(_mm_loadu_si128(
+					reinterpret_cast< __m128i const* >(p + i * 16)), n[i]))
+				return false;
+		}
+		__m256i lo = _mm256_setr_m128i(hex_combine(n[0]), hex_combine(n[2]));
+		__m256i hi = _mm256_setr_m128i(hex_combine(n[1]), hex_combine(n[3]));
+		// packus works within 128 bit lanes
+		_mm256_storeu_si256(reinterpret_cast< __m256i* >(out),
+				_mm256_packus_epi16(lo, hi));
+	}
+#endif
+#ifdef __SSE2__
+	for (; e - p >= 32; p += 32, out += 16) {
+		__m128i lo, hi;
+		if (!hex_nibbles(_mm_loadu_si128(reinterpret_cast< __m128i const* >(p)), lo)
+			|| !hex_nibbles(_mm_loadu_si128(reinterpret_cast< __m128i const* >(p + 16)), hi))
+			return false;
+		_mm_storeu_si128(reinterpret_cast< __m128i* >(out),
+				_mm_packus_epi16(hex_combine(lo), hex_combine(hi)));
+	}
+#endif
+	return hex_decode_scalar(p, e - p, out);
+}
+
+bool
+decode_bytea_hex(char const* data, std::size_t size, std::vector<char>& out)
+{
+	if (size < 2 || data[0] != '\\' || data[1] != 'x' || size % 2)
+		return false;
+	std::vector<char> tmp((size - 2) / 2);
+	if (!hex_decode(data + 2, size - 2, tmp.data()))
+		return false;
+	out.swap(tmp);
+	return true;
+}
+
+namespace {
+
+#ifdef PGASYNC_HAVE_STRTOD_L
+/**
+ * "C" locale for number conversions, created once and never freed
+ */
+locale_t
+c_locale()
+{
+	static locale_t const loc = ::newlocale(LC_ALL_MASK, "C", (locale_t)0);
+	return loc;
+}
+#else
+template < typename T >
+T
+classic_string_to_floating(char const* str, char** end)
+{
+	// Streams don't read the special values PostgreSQL sends
+	char const* p = str;
+	bool negative = *p == '-';
+	if (negative || *p == '+')
+		++p;
+	if (std::strncmp(p, "Infinity", 8) == 0) {
+		*end = const_cast< char* >(p + 8);
+		return negative ? -std::numeric_limits< T >::infinity() :
+				std::numeric_limits< T >::infinity();
+	}
+	if (p == str && std::strncmp(p, "NaN", 3) == 0) {
+		*end = const_cast< char* >(p + 3);
+		return std::numeric_limits< T >::quiet_NaN();
+	}
+	std::istringstream is(str);
+	is.imbue(std::locale::classic());
+	T val{0};
+	if (!(is >> val)) {
+		*end = const_cast< char* >(str);
+		return T{0};
+	}
+	if (is.eof()) {
+		*end = const_cast< char* >(str) + std::strlen(str);
+	} else {
+		*end = const_cast< char* >(str) + is.tellg();
+	}
+	return val;
+}
+#endif
+
+}  // namespace
+
+float
+string_to_floating(char const* str, char** end, float)
+{
+#ifdef PGASYNC_HAVE_STRTOD_L
+	return ::strtof_l(str, end, c_locale());
+#else
+	return classic_string_to_floating< float >(str, end);
+#endif
+}
+
+double
+string_to_floating(char const* str, char** end, double)
+{
+#ifdef PGASYNC_HAVE_STRTOD_L
+	return ::strtod_l(str, end, c_locale());
+#else
+	return classic_string_to_floating< double >(str, end);
+#endif
+}
+
+long double
+string_to_floating(char const* str, char** end, long double)
+{
+#ifdef PGASYNC_HAVE_STRTOD_L
+	return ::strtold_l(str, end, c_locale());
+#else
+	return classic_string_to_floating< long double >(str, end);
+#endif
+}
+
+namespace {
+
+template < typename T >
+void
+big_to_native_scalar(char* data, std::size_t count)
+{
+	for (char* e = data + count * sizeof(T); data != e; data += sizeof(T)) {
+		T tmp;
+		std::memcpy(&tmp, data, sizeof(T));
+		tmp = util::endian::big_to_native(tmp);
+		std::memcpy(data, &tmp, sizeof(T));
+	}
+}
+
+#if defined(BOOST_LITTLE_ENDIAN) && defined(__SSE2__)
+/**
+ * Reverse bytes within each value of 16 bytes with SSE2 shifts and word
+ * shuffles, SSE2 is always available on x86-64.
+ */
+template < std::size_t Width >
+inline __m128i
+byte_swap_sse2(__m128i v)
+{
+	// Swap bytes in 16 bit words
+	v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+	switch (Width) {
+		case 4:
+			v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+			return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		case 8:
+			v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+			return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+		default:
+			return v;
+	}
+}
+
+template < typename T >
+char*
+big_to_native_sse2(char* p, char* e)
+{
+	for (; e - p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast< __m128i const* >(p));
+		_mm_storeu_si128(reinterpret_cast< __m128i* >(p),
+				byte_swap_sse2< sizeof(T) >(v));
+	}
+	return p;
+}
+#endif
+
+#ifdef PGASYNC_X86_DISPATCH
+/**
+ * Shuffle mask reversing bytes within each value of the width
+ */
+template < std::size_t Width >
+__attribute__((target("ssse3"))) inline __m128i
+swap_mask()
+{
+	switch (Width) {
+		case 2:
+			return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+		case 4:
+			return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+		default:
+			return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	}
+}
+
+template < typename T >
+__attribute__((target("ssse3"))) char*
+big_to_native_ssse3(char* p, char* e)
+{
+	__m128i const mask = swap_mask< sizeof(T) >();
+	for (; e - p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast< __m128i const* >(p));
+		_mm_storeu_si128(reinterpret_cast< __m128i* >(p), _mm_shuffle_epi8(v, mask));
+	}
+	return p;
+}
+
+template < typename T >
+__attribute__((target("avx2"))) char*
+big_to_native_avx2(char* p, char* e)
+{
+	__m256i const mask = _mm256_broadcastsi128_si256(swap_mask< sizeof(T) >());
+	for (; e - p >= 32; p += 32) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast< __m256i const* >(p));
+		_mm256_storeu_si256(reinterpret_cast< __m256i* >(p),
+				_mm256_shuffle_epi8(v, mask));
+	}
+	return big_to_native_ssse3< T >(p, e);
+}
+#endif
+
+/**
+ * Swap as many values as the best instruction set available allows,
+ * return pointer to the values left for the scalar loop.
+ */
+template < typename T >
+char*
+big_to_native_vector(char* p, char* e)
+{
+#ifdef PGASYNC_X86_DISPATCH
+	typedef char* (*swap_function)(char*, char*);
+	static swap_function const swap = []() -> swap_function {
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return &big_to_native_avx2< T >;
+		if (__builtin_cpu_supports("ssse3"))
+			return &big_to_native_ssse3< T >;
+		return &big_to_native_sse2< T >;
+	}();
+	return swap(p, e);
+#elif defined(BOOST_LITTLE_ENDIAN) && defined(__SSE2__)
+	return big_to_native_sse2< T >(p, e);
+#else
+	return p;
+#endif
+}
+
+template < typename T >
+void
+big_to_native_values(char* data, std::size_t count)
+{
+	char* e = data + count * sizeof(T);
+	char* p = big_to_native_vector< T >(data, e);
+	big_to_native_scalar< T >(p, (e - p) / sizeof(T));
+}
+
+}  // namespace
+
+void
+big_to_native(char* data, std::size_t count, std::size_t width)
+{
+#if defined(BOOST_LITTLE_ENDIAN)
+	switch (width) {
+		case 2:
+			big_to_native_values< std::uint16_t >(data, count);
+			break;
+		case 4:
+			big_to_native_values< std::uint32_t >(data, count);
+			break;
+		case 8:
+			big_to_native_values< std::uint64_t >(data, count);
+			break;
+		default:
+			break;
+	}
+#endif
+}
+
 }  // namespace detail
 }  // namespace io
 }  // namespace pg
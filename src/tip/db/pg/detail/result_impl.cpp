@@ -16,10 +16,22 @@ namespace db {
 namespace pg {
 namespace detail {
 
-result_impl::result_impl()
+result_impl::result_impl() : name_index_raw_(nullptr)
 {
 }
 
+result_impl::result_impl(buffer_pool_ptr const& pool)
+	: rows_(pool->acquire_arena()), pool_(pool), name_index_raw_(nullptr)
+{
+}
+
+result_impl::~result_impl()
+{
+	if (buffer_pool_ptr pool = pool_.lock()) {
+		pool->release_arena(std::move(rows_));
+	}
+}
+
 size_t
 result_impl::size() const
 {
@@ -33,38 +45,80 @@ result_impl::empty() const
 }
 
 void
-result_impl::check_row_index(uinteger row) const
+result_impl::add_row(row_data const& row)
 {
-	if (row >= rows_.size()) {
-		std::ostringstream out;
-		out << "Row index " << row << " is out of bounds [0.."
-				<< rows_.size() << ")";
-		throw std::out_of_range(out.str().c_str());
-	}
+	rows_.push_back(row);
 }
 
 field_buffer
 result_impl::at(uinteger row, usmallint col) const
 {
-	check_row_index(row);
-	row_data const& rd = rows_[row];
-	return rd.field_data(col);
+	row_data::data_buffer_bounds bounds = rows_.field_buffer_bounds(row, col);
+	return field_buffer(bounds.first, bounds.second);
 }
 
 bool
 result_impl::is_null(uinteger row, usmallint col) const
 {
-	check_row_index(row);
-	row_data const& rd = rows_[row];
-	return rd.is_null(col);
+	return rows_.is_null(row, col);
 }
 
 row_data::data_buffer_bounds
 result_impl::buffer_bounds(uinteger row, usmallint col) const
 {
-	check_row_index(row);
-	row_data const& rd = rows_[row];
-	return rd.field_buffer_bounds(col);
+	return rows_.field_buffer_bounds(row, col);
+}
+
+size_t
+result_impl::index_of_name(std::string const& name) const
+{
+	name_index_type const* idx = name_index_raw_.load(std::memory_order_acquire);
+	if (!idx)
+		idx = name_index().get();
+	auto f = idx->find(name);
+	if (f != idx->end())
+		return f->second;
+	return npos;
+}
+
+result_impl::name_index_ptr
+result_impl::name_index() const
+{
+	std::lock_guard<std::mutex> lock(index_mutex_);
+	if (!name_index_) {
+		name_index_ = build_name_index(row_description_);
+		name_index_raw_.store(name_index_.get(), std::memory_order_release);
+	}
+	return name_index_;
+}
+
+void
+result_impl::set_name_index(name_index_ptr idx)
+{
+	std::lock_guard<std::mutex> lock(index_mutex_);
+	name_index_ = idx;
+	name_index_raw_.store(name_index_.get(), std::memory_order_release);
+}
+
+void
+result_impl::reset_name_index()
+{
+	if (name_index_raw_.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(index_mutex_);
+		name_index_raw_.store(nullptr, std::memory_order_release);
+		name_index_.reset();
+	}
+}
+
+result_impl::name_index_ptr
+result_impl::build_name_index(row_description_type const& desc)
+{
+	std::shared_ptr<name_index_type> idx = std::make_shared<name_index_type>();
+	idx->reserve(desc.size());
+	for (size_t i = 0; i < desc.size(); ++i) {
+		idx->insert(std::make_pair(desc[i].name, i));
+	}
+	return idx;
 }
 
 } /* namespace detail */
@@ -10,7 +10,13 @@
 
 #include <tip/db/pg/common.hpp>
 #include <tip/db/pg/detail/protocol.hpp>
+#include <tip/db/pg/detail/row_arena.hpp>
+#include <tip/db/pg/detail/buffer_pool.hpp>
 #include <vector>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <mutex>
 
 namespace tip {
 namespace db {
@@ -19,20 +25,44 @@ namespace detail {
 
 class result_impl {
 public:
-	typedef std::vector<row_data> row_set_type;
+	/** Column name to column index */
+	typedef std::unordered_map<std::string, size_t> name_index_type;
+	typedef std::shared_ptr<name_index_type const> name_index_ptr;
+
+	static constexpr size_t npos = static_cast<size_t>(-1);
 public:
 	result_impl();
+	/**
+	 * Construct a result that takes the row arena from the pool and returns
+	 * it to the pool when destroyed.
+	 */
+	explicit
+	result_impl(buffer_pool_ptr const& pool);
+	~result_impl();
+
+	result_impl(result_impl const&) = delete;
+	result_impl&
+	operator = (result_impl const&) = delete;
 
+	/**
+	 * Mutable access to the row description. Drops the column name index,
+	 * must not be used after the result is passed to the client.
+	 */
 	row_description_type&
 	row_description()
-	{ return row_description_; }
+	{
+		reset_name_index();
+		return row_description_;
+	}
 	row_description_type const&
 	row_description() const
 	{ return row_description_; }
 
-	row_set_type&
-	rows()
-	{ return rows_; }
+	/**
+	 * Copy the row data to the result's arena
+	 */
+	void
+	add_row(row_data const& row);
 
 	size_t
 	size() const;
@@ -48,11 +78,43 @@ public:
 
 	bool
 	is_null(uinteger row, usmallint col) const;
+
+	/**
+	 * Get the index of field with name. The name index is built on the
+	 * first call and is shared by all rows and iterators of the result.
+	 * @param name the field name
+	 * @return if found, index in the range of [0..columns_size). If not found - npos
+	 */
+	size_t
+	index_of_name(std::string const& name) const;
+	/**
+	 * Column name index, built on first access
+	 */
+	name_index_ptr
+	name_index() const;
+	/**
+	 * Use a column name index built beforehand for the same row description,
+	 * e.g. cached for a prepared statement.
+	 */
+	void
+	set_name_index(name_index_ptr idx);
+
+	/**
+	 * Build a column name index for a row description.
+	 * For duplicate column names the first one wins.
+	 */
+	static name_index_ptr
+	build_name_index(row_description_type const&);
 private:
 	void
-	check_row_index(uinteger row) const;
+	reset_name_index();
 	row_description_type row_description_;
-	row_set_type rows_;
+	row_arena rows_;
+	std::weak_ptr<buffer_pool> pool_;
+
+	mutable std::mutex							index_mutex_;
+	mutable name_index_ptr						name_index_;
+	mutable std::atomic<name_index_type const*>	name_index_raw_;
 };
 
 } /* namespace detail */
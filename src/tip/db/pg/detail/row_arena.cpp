@@ -0,0 +1,163 @@
+/*
+ * row_arena.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <tip/db/pg/detail/row_arena.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace detail {
+
+constexpr std::size_t row_arena::min_chunk_size;
+constexpr std::size_t row_arena::max_chunk_size;
+
+row_arena::row_arena() : current_(0)
+{
+}
+
+row_arena::chunk_type&
+row_arena::chunk_for(std::size_t size)
+{
+	if (!chunks_.empty()) {
+		chunk_type& curr = chunks_[current_];
+		if (curr.capacity() - curr.size() >= size)
+			return curr;
+		if (current_ + 1 < chunks_.size()) {
+			// A chunk left from previous use, it is empty
+			chunk_type& next = chunks_[++current_];
+			if (next.capacity() < size)
+				next.reserve(size);
+			return next;
+		}
+	}
+	std::size_t chunk_size = chunks_.empty() ? min_chunk_size :
+			std::min(chunks_.back().capacity() * 2, max_chunk_size);
+	chunks_.emplace_back();
+	current_ = chunks_.size() - 1;
+	chunks_.back().reserve(std::max(chunk_size, size));
+	return chunks_.back();
+}
+
+void
+row_arena::push_back(row_data const& row)
+{
+	chunk_type& chunk = chunk_for(row.data.size());
+	integer start = chunk.size();
+	// Doesn't reallocate, the chunk has enough capacity
+	chunk.insert(chunk.end(), row.data.begin(), row.data.end());
+
+	row_entry entry{ static_cast<uinteger>(current_),
+		static_cast<uinteger>(fields_.size()), row.size() };
+	auto null = row.null_map.begin();
+	integer data_size = row.data.size();
+	for (size_type i = 0; i < entry.size; ++i) {
+		integer offset = row.offsets[i];
+		if (null != row.null_map.end() && *null == i) {
+			++null;
+			fields_.push_back(field_entry{ start + offset, -1 });
+		} else {
+			integer end = i + 1 < entry.size ? row.offsets[i + 1] : data_size;
+			fields_.push_back(field_entry{ start + offset, end - offset });
+		}
+	}
+	rows_.push_back(entry);
+}
+
+row_arena::size_type
+row_arena::row_size(std::size_t row) const
+{
+	if (row >= rows_.size()) {
+		std::ostringstream out;
+		out << "Row index " << row << " is out of bounds [0.."
+				<< rows_.size() << ")";
+		throw std::out_of_range(out.str().c_str());
+	}
+	return rows_[row].size;
+}
+
+row_arena::field_entry const&
+row_arena::field(std::size_t row, size_type col) const
+{
+	size_type sz = row_size(row);
+	if (col >= sz) {
+		std::ostringstream out;
+		out << "Field index " << col << " is out of range [0.."
+				<< sz << ")";
+		throw std::out_of_range(out.str().c_str());
+	}
+	return fields_[rows_[row].first_field + col];
+}
+
+bool
+row_arena::is_null(std::size_t row, size_type col) const
+{
+	return field(row, col).length < 0;
+}
+
+row_arena::data_buffer_bounds
+row_arena::field_buffer_bounds(std::size_t row, size_type col) const
+{
+	field_entry const& f = field(row, col);
+	chunk_type const& chunk = chunks_[rows_[row].chunk];
+	row_data::const_data_iterator s = chunk.begin() + f.offset;
+	return std::make_pair(s, f.length < 0 ? s : s + f.length);
+}
+
+void
+row_arena::clear()
+{
+	for (auto& chunk : chunks_) {
+		chunk.clear();
+	}
+	current_ = 0;
+	rows_.clear();
+	fields_.clear();
+}
+
+void
+row_arena::shrink(std::size_t max_bytes)
+{
+	std::size_t index_size = rows_.capacity() * sizeof(row_entry) +
+			fields_.capacity() * sizeof(field_entry);
+	if (index_size > max_bytes) {
+		row_list{}.swap(rows_);
+		field_list{}.swap(fields_);
+		index_size = 0;
+	}
+	std::size_t total = index_size;
+	std::size_t keep = 0;
+	for (; keep < chunks_.size(); ++keep) {
+		total += chunks_[keep].capacity();
+		if (total > max_bytes)
+			break;
+	}
+	if (keep < chunks_.size()) {
+		chunks_.erase(chunks_.begin() + keep, chunks_.end());
+		if (current_ >= keep)
+			current_ = keep ? keep - 1 : 0;
+	}
+}
+
+std::size_t
+row_arena::capacity() const
+{
+	std::size_t total = rows_.capacity() * sizeof(row_entry) +
+			fields_.capacity() * sizeof(field_entry);
+	for (auto const& chunk : chunks_) {
+		total += chunk.capacity();
+	}
+	return total;
+}
+
+} /* namespace detail */
+} /* namespace pg */
+} /* namespace db */
+} /* namespace tip */
@@ -0,0 +1,131 @@
+/*
+ * row_arena.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_SRC_TIP_DB_PG_DETAIL_ROW_ARENA_HPP_
+#define LIB_PG_ASYNC_SRC_TIP_DB_PG_DETAIL_ROW_ARENA_HPP_
+
+#include <tip/db/pg/detail/protocol.hpp>
+
+#include <vector>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace detail {
+
+/**
+ * Storage for rows of a result.
+ *
+ * Field data of all rows is copied into large chunks, field bounds are kept
+ * in a single index, so releasing a result frees a handful of blocks
+ * regardless of the number of rows. A chunk never grows past its initial
+ * capacity, iterators to the stored data stay valid while the arena lives.
+ * A cleared arena keeps its memory and can be reused for the next result.
+ */
+class row_arena {
+public:
+	typedef row_data::data_buffer				chunk_type;
+	typedef row_data::data_buffer_bounds		data_buffer_bounds;
+	typedef row_data::size_type					size_type;
+	/** Size of the first data chunk, each next one is twice as large */
+	static constexpr std::size_t min_chunk_size = 4 * 1024;
+	/** Size limit for doubling of chunks */
+	static constexpr std::size_t max_chunk_size = 256 * 1024;
+public:
+	row_arena();
+	row_arena(row_arena&&) = default;
+	row_arena&
+	operator = (row_arena&&) = default;
+
+	/**
+	 * Copy the row to the arena. Doesn't allocate when the arena has enough
+	 * memory left from a previous use.
+	 */
+	void
+	push_back(row_data const& row);
+
+	/** Number of rows */
+	std::size_t
+	size() const
+	{ return rows_.size(); }
+	bool
+	empty() const
+	{ return rows_.empty(); }
+
+	/**
+	 * Number of fields in a row
+	 * @throw out_of_range if the row index is out of range
+	 */
+	size_type
+	row_size(std::size_t row) const;
+	/**
+	 * @throw out_of_range if the row or field index is out of range
+	 */
+	bool
+	is_null(std::size_t row, size_type col) const;
+	/**
+	 * Buffer bounds for a field, an empty range for a null field.
+	 * @throw out_of_range if the row or field index is out of range
+	 */
+	data_buffer_bounds
+	field_buffer_bounds(std::size_t row, size_type col) const;
+
+	/**
+	 * Remove all rows, keeping the allocated memory
+	 */
+	void
+	clear();
+	/**
+	 * Release the memory of a cleared arena over the limit, keeping the
+	 * first chunks.
+	 */
+	void
+	shrink(std::size_t max_bytes);
+	/**
+	 * Memory held by the arena, in bytes
+	 */
+	std::size_t
+	capacity() const;
+	/**
+	 * Number of data chunks allocated
+	 */
+	std::size_t
+	chunks() const
+	{ return chunks_.size(); }
+private:
+	struct row_entry {
+		uinteger	chunk;
+		uinteger	first_field;
+		size_type	size;
+	};
+	struct field_entry {
+		integer		offset;
+		/** -1 for a null field */
+		integer		length;
+	};
+	typedef std::vector<chunk_type>		chunk_list;
+	typedef std::vector<row_entry>		row_list;
+	typedef std::vector<field_entry>	field_list;
+
+	chunk_type&
+	chunk_for(std::size_t size);
+	field_entry const&
+	field(std::size_t row, size_type col) const;
+private:
+	chunk_list	chunks_;
+	/** Index of the chunk being filled */
+	std::size_t	current_;
+	row_list	rows_;
+	field_list	fields_;
+};
+
+} /* namespace detail */
+} /* namespace pg */
+} /* namespace db */
+} /* namespace tip */
+
+#endif /* LIB_PG_ASYNC_SRC_TIP_DB_PG_DETAIL_ROW_ARENA_HPP_ */
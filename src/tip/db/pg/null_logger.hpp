@@ -66,6 +66,13 @@ public:
     static void
     set_stream(std::ostream&) {}
 
+    /**
+     * Set flush stream after every logged event
+     * @param
+     */
+    static void
+    flush_stream(bool) {}
+
     /**
      * Set minimum event severity that will be written to the log.
      * @param severity
@@ -115,6 +122,17 @@ public:
     local(std::string const& category,
             logger::event_severity severity = logger::OFF)
     {}
+
+    bool
+    enabled() const
+    { return false; }
+};
+
+using null_local = local;
+
+template < logger::event_severity S >
+struct local_type {
+    using type = local;
 };
 
 template < typename T >
@@ -142,8 +160,12 @@ operator << (local out, T const& v)
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = logger::s; \
-        local \
-        local_log(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        local_log() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        local_log(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -153,8 +175,12 @@ operator << (local out, T const& v)
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = s; \
-        local \
-        local_log(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        local_log() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        local_log(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -164,8 +190,12 @@ operator << (local out, T const& v)
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = logger::s; \
-        local \
-        f(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        f() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        f(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
@@ -175,8 +205,12 @@ operator << (local out, T const& v)
         using namespace ::psst::log; \
         const std::string c##_LOG_CATEGORY = #c;    \
         const logger::event_severity c##_DEFAULT_SEVERITY = s; \
-        local \
-        f(logger::event_severity sv = c##_DEFAULT_SEVERITY) \
+        inline local_type< c##_DEFAULT_SEVERITY >::type \
+        f() \
+        { return local_type< c##_DEFAULT_SEVERITY >::type( \
+                c##_LOG_CATEGORY, c##_DEFAULT_SEVERITY); }\
+        inline local \
+        f(logger::event_severity sv) \
         { return local(c##_LOG_CATEGORY, sv); }\
     } \
     using ::psst::log::logger
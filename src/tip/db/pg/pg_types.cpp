@@ -60,6 +60,30 @@ namespace {
 		{ text_array, "text_array" },
 		{ oid_array, "oid_array" },
 		{ float4_array, "float4_array" },
+		{ bool_array, "bool_array" },
+		{ bytea_array, "bytea_array" },
+		{ char_array, "char_array" },
+		{ name_array, "name_array" },
+		{ int8_array, "int8_array" },
+		{ tid_array, "tid_array" },
+		{ xid_array, "xid_array" },
+		{ cid_array, "cid_array" },
+		{ bpchar_array, "bpchar_array" },
+		{ varchar_array, "varchar_array" },
+		{ float8_array, "float8_array" },
+		{ macaddr_array, "macaddr_array" },
+		{ inet_array, "inet_array" },
+		{ cidr_array, "cidr_array" },
+		{ timestamp_array, "timestamp_array" },
+		{ date_array, "date_array" },
+		{ time_array, "time_array" },
+		{ timestamptz_array, "timestamptz_array" },
+		{ interval_array, "interval_array" },
+		{ timetz_array, "timetz_array" },
+		{ numeric_array, "numeric_array" },
+		{ uuid_array, "uuid_array" },
+		{ json_array, "json_array" },
+		{ jsonb_array, "jsonb_array" },
 		{ acl_item, "acl_item" },
 		{ cstring_array, "cstring_array" },
 		{ bpchar, "bpchar" },
@@ -149,6 +173,30 @@ namespace {
 		{ "text_array", text_array },
 		{ "oid_array", oid_array },
 		{ "float4_array", float4_array },
+		{ "bool_array", bool_array },
+		{ "bytea_array", bytea_array },
+		{ "char_array", char_array },
+		{ "name_array", name_array },
+		{ "int8_array", int8_array },
+		{ "tid_array", tid_array },
+		{ "xid_array", xid_array },
+		{ "cid_array", cid_array },
+		{ "bpchar_array", bpchar_array },
+		{ "varchar_array", varchar_array },
+		{ "float8_array", float8_array },
+		{ "macaddr_array", macaddr_array },
+		{ "inet_array", inet_array },
+		{ "cidr_array", cidr_array },
+		{ "timestamp_array", timestamp_array },
+		{ "date_array", date_array },
+		{ "time_array", time_array },
+		{ "timestamptz_array", timestamptz_array },
+		{ "interval_array", interval_array },
+		{ "timetz_array", timetz_array },
+		{ "numeric_array", numeric_array },
+		{ "uuid_array", uuid_array },
+		{ "json_array", json_array },
+		{ "jsonb_array", jsonb_array },
 		{ "acl_item", acl_item },
 		{ "cstring_array", cstring_array },
 		{ "bpchar", bpchar },
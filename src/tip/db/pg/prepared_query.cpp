@@ -0,0 +1,105 @@
+/*
+ * prepared_query.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <tip/db/pg/prepared_query.hpp>
+#include <tip/db/pg/database.hpp>
+#include <tip/db/pg/transaction.hpp>
+#include <tip/db/pg/detail/md5.hpp>
+
+#include <tip/db/pg/log.hpp>
+
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+namespace tip {
+namespace db {
+namespace pg {
+
+LOCAL_LOGGING_FACILITY_CFG(PGQUERY, config::QUERY_LOG);
+
+namespace {
+
+std::string
+statement_name(std::string const& expression, type_oid_sequence const& param_types)
+{
+    std::ostringstream os;
+    os << expression;
+    if (!param_types.empty()) {
+        os << "{";
+        std::ostream_iterator< oids::type::oid_type > out(os, ",");
+        std::copy( param_types.begin(), param_types.end() - 1, out );
+        os << param_types.back() << "}";
+    }
+    return "q_" +
+        std::string( boost::md5( os.str().c_str() ).digest().hex_str_value() );
+}
+
+void
+execute_statement(transaction_ptr tran, prepared_statement_ptr const& statement,
+        params_buffer_ptr const& params,
+        query_result_callback const& result, error_callback const& error)
+{
+    tran->execute(statement, params, result, error);
+}
+
+}  // namespace
+
+prepared_statement::prepared_statement(std::string const& expr,
+        type_oid_sequence types)
+    : expression(expr), param_types(::std::move(types)),
+      name(statement_name(expression, param_types))
+{
+}
+
+namespace detail {
+
+prepared_query_base::prepared_query_base(dbalias const& alias,
+        transaction_mode const& mode, std::string const& expression,
+        type_oid_sequence&& param_types)
+    : alias_(alias), mode_(mode),
+      statement_(::std::make_shared< prepared_statement const >(
+              expression, ::std::move(param_types)))
+{
+}
+
+void
+prepared_query_base::run_async(std::vector<byte>&& params,
+        query_result_callback const& result, error_callback const& error) const
+{
+    {
+        local_log() << "Execute prepared query "
+                << statement_->expression;
+    }
+    db_service::begin(
+        alias_,
+        std::bind(&execute_statement, std::placeholders::_1, statement_,
+                ::std::make_shared< std::vector<byte> const >(::std::move(params)),
+                result, error),
+        error,
+        mode_
+    );
+}
+
+void
+prepared_query_base::run_async(transaction_ptr tran, std::vector<byte>&& params,
+        query_result_callback const& result, error_callback const& error) const
+{
+    {
+        local_log() << "Execute prepared query "
+                << statement_->expression;
+    }
+    tran->execute(statement_,
+            ::std::make_shared< std::vector<byte> const >(::std::move(params)),
+            result, error);
+}
+
+}  // namespace detail
+
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
@@ -8,9 +8,17 @@
 #include <tip/db/pg/protocol_io_traits.hpp>
 #include <tip/db/pg/detail/protocol_parsers.hpp>
 #include <tip/db/pg/io/boost_date_time.hpp>
+#include <tip/db/pg/io/ip_address.hpp>
 #include <tip/db/pg/log.hpp>
 
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
 #include <iterator>
+#include <limits>
 #include <set>
 
 namespace tip {
@@ -28,12 +36,17 @@ using namespace oids::type;
 
 std::set< oid_type > BINARY_PARSERS {
     boolean, oids::type::bytea, int2, int4, int8, oid, tid, xid, cid,
-    timestamp, timestamptz, uuid
+    float4, float8, numeric, date, time, timetz, timestamp, timestamptz,
+    interval, inet, cidr, macaddr, uuid, json, jsonb,
+    bool_array, bytea_array, int2_array, int4_array, int8_array, oid_array,
+    float4_array, float8_array, date_array, time_array, timetz_array,
+    timestamp_array, timestamptz_array, interval_array, inet_array, cidr_array,
+    uuid_array
 };
 }  // namespace
 
 void
-register_parser_type(oids::type::oid_type oid)
+register_binary_parser(oids::type::oid_type oid)
 {
     BINARY_PARSERS.insert(oid);
 }
@@ -48,24 +61,27 @@ has_binary_parser(oids::type::oid_type oid)
 
 namespace {
 
-const std::set< std::string > TRUE_LITERALS {
-    "TRUE",
-    "t",
-    "true",
-    "y",
-    "yes",
-    "on",
-    "1"
+struct bool_literal {
+    char const* literal;
+    std::size_t size;
+    bool        value;
 };
 
-const std::set< std::string > FALSE_LITERALS {
-    "FALSE",
-    "f",
-    "false",
-    "n",
-    "no",
-    "off",
-    "0"
+bool_literal const BOOL_LITERALS[] {
+    { "TRUE",   4, true },
+    { "t",      1, true },
+    { "true",   4, true },
+    { "y",      1, true },
+    { "yes",    3, true },
+    { "on",     2, true },
+    { "1",      1, true },
+    { "FALSE",  5, false },
+    { "f",      1, false },
+    { "false",  5, false },
+    { "n",      1, false },
+    { "no",     2, false },
+    { "off",    3, false },
+    { "0",      1, false }
 };
 
 }  // namespace
@@ -73,12 +89,17 @@ const std::set< std::string > FALSE_LITERALS {
 bool
 protocol_parser< bool, TEXT_DATA_FORMAT >::use_literal(std::string const& l)
 {
-    if (TRUE_LITERALS.count(l)) {
-        base_type::value = true;
-        return true;
-    } else if (FALSE_LITERALS.count(l)) {
-        base_type::value = false;
-        return true;
+    return use_literal(l.data(), l.size());
+}
+
+bool
+protocol_parser< bool, TEXT_DATA_FORMAT >::use_literal(char const* l, std::size_t sz)
+{
+    for (auto const& lit : BOOL_LITERALS) {
+        if (lit.size == sz && std::equal(l, l + sz, lit.literal)) {
+            base_type::value = lit.value;
+            return true;
+        }
     }
     return false;
 }
@@ -87,29 +108,16 @@ protocol_parser< bool, TEXT_DATA_FORMAT >::use_literal(std::string const& l)
 bool
 protocol_parser< bytea, TEXT_DATA_FORMAT >::operator()(std::istream& in)
 {
-    std::vector<byte> data;
-    std::istream_iterator<char> b(in);
-    std::istream_iterator<char> e;
-
-    auto result = detail::bytea_parser().parse(b, e, std::back_inserter(data));
-    if (result.first) {
-        base_type::value.swap(data);
-        return true;
-    }
-    return false;
+    std::string data;
+    in >> data;
+    return detail::decode_bytea_hex(data.data(), data.size(), base_type::value);
 }
 
 bool
 protocol_parser< bytea, TEXT_DATA_FORMAT >::operator()(buffer_type& buffer)
 {
-    std::vector<byte> data;
-    auto result = detail::bytea_parser().parse(buffer.begin(), buffer.end(),
-            std::back_inserter(data));
-    if (result.first) {
-        base_type::value.swap(data);
-        return true;
-    }
-    return false;
+    return !buffer.empty() && detail::decode_bytea_hex(&*buffer.begin(),
+            buffer.end() - buffer.begin(), base_type::value);
 }
 
 using ::boost::posix_time::ptime;
@@ -118,11 +126,23 @@ using ::boost::gregorian::date;
 ptime const
 protocol_formatter<ptime, BINARY_DATA_FORMAT>::pg_epoch{ date{2000, boost::gregorian::Jan, 1} };
 
+namespace {
+
+const bigint USECS_PER_DAY      = 86400000000LL;
+
+}  // namespace
+
 void
 protocol_parser<ptime, BINARY_DATA_FORMAT>::from_int_value(bigint val)
 {
     using fmt_type = protocol_formatter<ptime, BINARY_DATA_FORMAT>;
-    base_type::value = fmt_type::pg_epoch + ::boost::posix_time::microseconds{val};
+    if (val == ::std::numeric_limits<bigint>::max()) {
+        base_type::value = ptime{ ::boost::posix_time::pos_infin };
+    } else if (val == ::std::numeric_limits<bigint>::min()) {
+        base_type::value = ptime{ ::boost::posix_time::neg_infin };
+    } else {
+        base_type::value = fmt_type::pg_epoch + ::boost::posix_time::microseconds{val};
+    }
 }
 
 bool
@@ -132,7 +152,14 @@ protocol_formatter<ptime, BINARY_DATA_FORMAT>::operator()( ::std::vector<byte>&
         buffer.reserve(buffer.size() + size());
     }
 
-    bigint delta =(base_type::value - pg_epoch).total_microseconds();
+    bigint delta{0};
+    if (base_type::value.is_pos_infinity()) {
+        delta = ::std::numeric_limits<bigint>::max();
+    } else if (base_type::value.is_neg_infinity()) {
+        delta = ::std::numeric_limits<bigint>::min();
+    } else {
+        delta = (base_type::value - pg_epoch).total_microseconds();
+    }
     delta = util::endian::native_to_big(delta);
     char const* p = reinterpret_cast<char const*>(&delta);
     char const* e = p + size();
@@ -140,6 +167,620 @@ protocol_formatter<ptime, BINARY_DATA_FORMAT>::operator()( ::std::vector<byte>&
     return true;
 }
 
+void
+protocol_parser<date, BINARY_DATA_FORMAT>::from_int_value(integer val)
+{
+    using fmt_type = protocol_formatter<ptime, BINARY_DATA_FORMAT>;
+    if (val == ::std::numeric_limits<integer>::max()) {
+        base_type::value = date{ ::boost::gregorian::pos_infin };
+    } else if (val == ::std::numeric_limits<integer>::min()) {
+        base_type::value = date{ ::boost::gregorian::neg_infin };
+    } else {
+        base_type::value = fmt_type::pg_epoch.date() + ::boost::gregorian::days{val};
+    }
+}
+
+bool
+protocol_formatter<date, BINARY_DATA_FORMAT>::operator()( ::std::vector<byte>& buffer )
+{
+    using fmt_type = protocol_formatter<ptime, BINARY_DATA_FORMAT>;
+    integer days{0};
+    if (base_type::value.is_pos_infinity()) {
+        days = ::std::numeric_limits<integer>::max();
+    } else if (base_type::value.is_neg_infinity()) {
+        days = ::std::numeric_limits<integer>::min();
+    } else {
+        days = (base_type::value - fmt_type::pg_epoch.date()).days();
+    }
+    return protocol_write< BINARY_DATA_FORMAT >(buffer, days);
+}
+
+using ::boost::posix_time::time_duration;
+
+bool
+protocol_parser<time_duration, TEXT_DATA_FORMAT>::parse_interval(::std::string const& literal)
+{
+    // Postgres interval style:
+    // [-]N year[s] [-]N mon[s] [-]N day[s] [+|-]HH:MM:SS[.ffffff]
+    // time is the same as a sole clock part. Years and months have no fixed
+    // length and are not accepted.
+    ::std::istringstream is(literal);
+    bigint usecs{0};
+    ::std::string token;
+    bool parsed{false};
+    while (is >> token) {
+        if (token.find(':') != ::std::string::npos) {
+            char const* p = token.c_str();
+            bool negative = *p == '-';
+            if (*p == '-' || *p == '+')
+                ++p;
+            char* e{nullptr};
+            bigint hours = ::std::strtoll(p, &e, 10);
+            if (*e != ':')
+                return false;
+            bigint minutes = ::std::strtoll(e + 1, &e, 10);
+            if (*e != ':')
+                return false;
+            bigint seconds = ::std::strtoll(e + 1, &e, 10);
+            bigint fraction{0};
+            if (*e == '.') {
+                bigint scale{100000};
+                for (++e; ::std::isdigit(*e); ++e) {
+                    fraction += (*e - '0') * scale;
+                    scale /= 10;
+                }
+            }
+            if (*e)
+                return false;
+            bigint clock = ((hours * 60 + minutes) * 60 + seconds) * 1000000 + fraction;
+            usecs += negative ? -clock : clock;
+        } else {
+            char* e{nullptr};
+            bigint n = ::std::strtoll(token.c_str(), &e, 10);
+            ::std::string unit;
+            if (*e || !(is >> unit))
+                return false;
+            if (unit == "day" || unit == "days") {
+                usecs += n * USECS_PER_DAY;
+            } else {
+                return false;
+            }
+        }
+        parsed = true;
+    }
+    if (parsed)
+        base_type::value = ::boost::posix_time::microseconds{usecs};
+    return parsed;
+}
+
+void
+protocol_parser<time_duration, BINARY_DATA_FORMAT>::from_int_values(
+        bigint usecs, integer days)
+{
+    usecs += days * USECS_PER_DAY;
+    base_type::value = ::boost::posix_time::microseconds{usecs};
+}
+
+bool
+protocol_formatter<time_duration, BINARY_DATA_FORMAT>::operator()( ::std::vector<byte>& buffer )
+{
+    if (buffer.capacity() - buffer.size() < size()) {
+        buffer.reserve(buffer.size() + size());
+    }
+    protocol_write< BINARY_DATA_FORMAT >(buffer, base_type::value.total_microseconds());
+    protocol_write< BINARY_DATA_FORMAT >(buffer, integer{0});  // days
+    protocol_write< BINARY_DATA_FORMAT >(buffer, integer{0});  // months
+    return true;
+}
+
+namespace {
+
+using field_iterator = field_buffer::const_iterator;
+
+template < typename T >
+bool
+read_binary(field_iterator& begin, field_iterator end, T& val)
+{
+    if (end - begin < (decltype(end - begin))sizeof(T))
+        return false;
+    begin = protocol_read< BINARY_DATA_FORMAT >(begin, end, val);
+    return true;
+}
+
+void
+write_2digits(::std::ostream& os, bigint val)
+{
+    os << ::std::setw(2) << ::std::setfill('0') << val;
+}
+
+void
+write_clock(::std::ostream& os, bigint usecs)
+{
+    bigint secs = usecs / 1000000;
+    bigint fraction = usecs % 1000000;
+    os << ::std::setw(2) << ::std::setfill('0') << secs / 3600 << ':';
+    write_2digits(os, secs / 60 % 60);
+    os << ':';
+    write_2digits(os, secs % 60);
+    if (fraction) {
+        int width = 6;
+        while (fraction % 10 == 0) {
+            fraction /= 10;
+            --width;
+        }
+        os << '.' << ::std::setw(width) << ::std::setfill('0') << fraction;
+    }
+}
+
+void
+write_date(::std::ostream& os, integer days)
+{
+    if (days == ::std::numeric_limits<integer>::max()) {
+        os << "infinity";
+        return;
+    } else if (days == ::std::numeric_limits<integer>::min()) {
+        os << "-infinity";
+        return;
+    }
+    // Proleptic gregorian calendar date from days since 2000-01-01
+    bigint z = days + 10957 + 719468;
+    bigint era = (z >= 0 ? z : z - 146096) / 146097;
+    bigint doe = z - era * 146097;
+    bigint yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    bigint y = yoe + era * 400;
+    bigint doy = doe - (365*yoe + yoe/4 - yoe/100);
+    bigint mp = (5*doy + 2)/153;
+    bigint d = doy - (153*mp+2)/5 + 1;
+    bigint m = mp < 10 ? mp + 3 : mp - 9;
+    if (m <= 2)
+        ++y;
+    bool bc = y <= 0;
+    if (bc)
+        y = 1 - y;
+    os << ::std::setw(4) << ::std::setfill('0') << y << '-';
+    write_2digits(os, m);
+    os << '-';
+    write_2digits(os, d);
+    if (bc)
+        os << " BC";
+}
+
+bool
+write_timestamp(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    bigint usecs{0};
+    if (!read_binary(begin, end, usecs))
+        return false;
+    if (usecs == ::std::numeric_limits<bigint>::max()) {
+        os << "infinity";
+    } else if (usecs == ::std::numeric_limits<bigint>::min()) {
+        os << "-infinity";
+    } else {
+        bigint days = usecs / USECS_PER_DAY;
+        usecs %= USECS_PER_DAY;
+        if (usecs < 0) {
+            usecs += USECS_PER_DAY;
+            --days;
+        }
+        write_date(os, days);
+        os << ' ';
+        write_clock(os, usecs);
+    }
+    return true;
+}
+
+void
+write_interval_part(::std::ostream& os, bigint val, char const* unit)
+{
+    if (val) {
+        if (os.tellp() > 0)
+            os << ' ';
+        os << val << ' ' << unit;
+        if (val != 1)
+            os << 's';
+    }
+}
+
+bool
+write_interval(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    bigint usecs{0};
+    integer days{0}, months{0};
+    if (!read_binary(begin, end, usecs) || !read_binary(begin, end, days)
+            || !read_binary(begin, end, months))
+        return false;
+    write_interval_part(os, months / 12, "year");
+    write_interval_part(os, months % 12, "mon");
+    write_interval_part(os, days, "day");
+    if (usecs || os.tellp() == 0) {
+        if (os.tellp() > 0)
+            os << ' ';
+        if (usecs < 0) {
+            os << '-';
+            usecs = -usecs;
+        }
+        write_clock(os, usecs);
+    }
+    return true;
+}
+
+template < typename T >
+bool
+write_float(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    T val{0};
+    if (!read_binary(begin, end, val))
+        return false;
+    if (::std::isnan(val)) {
+        os << "NaN";
+    } else if (::std::isinf(val)) {
+        os << (val < 0 ? "-Infinity" : "Infinity");
+    } else {
+        os << ::std::setprecision(::std::numeric_limits<T>::max_digits10) << val;
+    }
+    return true;
+}
+
+void
+write_hex(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    static char const HEX_DIGITS[] = "0123456789abcdef";
+    for (; begin != end; ++begin) {
+        unsigned char c = *begin;
+        os << HEX_DIGITS[c >> 4] << HEX_DIGITS[c & 0x0f];
+    }
+}
+
+bool
+write_numeric(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    enum {
+        NUMERIC_NEG     = 0x4000,
+        NUMERIC_NAN     = 0xC000,
+        NUMERIC_PINF    = 0xD000,
+        NUMERIC_NINF    = 0xF000
+    };
+    smallint ndigits{0}, weight{0}, sign{0}, dscale{0};
+    if (!read_binary(begin, end, ndigits) || !read_binary(begin, end, weight)
+            || !read_binary(begin, end, sign) || !read_binary(begin, end, dscale))
+        return false;
+    switch ((usmallint)sign) {
+        case NUMERIC_NAN:
+            os << "NaN";
+            return true;
+        case NUMERIC_PINF:
+            os << "Infinity";
+            return true;
+        case NUMERIC_NINF:
+            os << "-Infinity";
+            return true;
+        default:
+            break;
+    }
+    ::std::vector<smallint> digits(ndigits);
+    for (auto& d : digits) {
+        if (!read_binary(begin, end, d))
+            return false;
+    }
+    if (sign == NUMERIC_NEG)
+        os << '-';
+    // Digits are base 10000, weight is the exponent of the first digit
+    if (weight < 0) {
+        os << '0';
+    } else {
+        for (int i = 0; i <= weight; ++i) {
+            smallint d = i < ndigits ? digits[i] : 0;
+            if (i == 0) {
+                os << d;
+            } else {
+                os << ::std::setw(4) << ::std::setfill('0') << d;
+            }
+        }
+    }
+    if (dscale > 0) {
+        ::std::ostringstream fraction;
+        for (int i = weight + 1; fraction.tellp() < dscale; ++i) {
+            smallint d = (i >= 0 && i < ndigits) ? digits[i] : 0;
+            fraction << ::std::setw(4) << ::std::setfill('0') << d;
+        }
+        os << '.' << fraction.str().substr(0, dscale);
+    }
+    return true;
+}
+
+bool
+write_inet(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    using address = ASIO_NAMESPACE::ip::address;
+    address addr;
+    if (protocol_read< BINARY_DATA_FORMAT >(begin, end, addr) == begin)
+        return false;
+    unsigned char bits = *(begin + 1);
+    bool is_cidr = *(begin + 2);
+    os << addr.to_string();
+    if (is_cidr || bits != (addr.is_v4() ? 32 : 128))
+        os << '/' << (int)bits;
+    return true;
+}
+
+void
+write_array_element(::std::ostream& os, ::std::string const& val)
+{
+    bool quote = val.empty() || boost::iequals(val, "NULL");
+    for (auto c = val.begin(); !quote && c != val.end(); ++c) {
+        quote = *c == '{' || *c == '}' || *c == ',' || *c == '"'
+                || *c == '\\' || ::std::isspace(*c);
+    }
+    if (!quote) {
+        os << val;
+        return;
+    }
+    os << '"';
+    for (char c : val) {
+        if (c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+
+bool
+write_array_elements(::std::ostream& os, oids::type::oid_type element_oid,
+        ::std::vector< integer > const& dims, ::std::size_t level,
+        field_iterator& begin, field_iterator end)
+{
+    os << '{';
+    for (integer i = 0; i < dims[level]; ++i) {
+        if (i > 0)
+            os << ',';
+        if (level + 1 < dims.size()) {
+            if (!write_array_elements(os, element_oid, dims, level + 1, begin, end))
+                return false;
+            continue;
+        }
+        integer len{0};
+        if (!read_binary(begin, end, len))
+            return false;
+        if (len < 0) {
+            os << "NULL";
+            continue;
+        }
+        if (end - begin < len)
+            return false;
+        ::std::string val;
+        if (!binary_to_text(element_oid, begin, begin + len, val))
+            return false;
+        write_array_element(os, val);
+        begin += len;
+    }
+    os << '}';
+    return true;
+}
+
+/**
+ * Write array in binary format as an array literal. Lower bounds are ignored.
+ */
+bool
+write_array(::std::ostream& os, field_iterator begin, field_iterator end)
+{
+    integer ndim{0}, has_nulls{0}, element_oid{0};
+    if (!read_binary(begin, end, ndim) || !read_binary(begin, end, has_nulls)
+            || !read_binary(begin, end, element_oid) || ndim < 0)
+        return false;
+    ::std::vector< integer > dims(ndim);
+    for (auto& dim : dims) {
+        integer lower_bound{0};
+        if (!read_binary(begin, end, dim) || !read_binary(begin, end, lower_bound)
+                || dim < 0)
+            return false;
+    }
+    if (dims.empty()) {
+        os << "{}";
+        return true;
+    }
+    return write_array_elements(os, (oids::type::oid_type)element_oid, dims, 0,
+            begin, end);
+}
+
+}  // namespace
+
+bool
+binary_to_text(oids::type::oid_type id, field_iterator begin, field_iterator end,
+        ::std::string& text)
+{
+    ::std::ostringstream os;
+    switch (id) {
+        case oids::type::boolean: {
+            bool val{false};
+            if (!read_binary(begin, end, val))
+                return false;
+            os << (val ? 't' : 'f');
+            break;
+        }
+        case oids::type::int2: {
+            smallint val{0};
+            if (!read_binary(begin, end, val))
+                return false;
+            os << val;
+            break;
+        }
+        case oids::type::int4: {
+            integer val{0};
+            if (!read_binary(begin, end, val))
+                return false;
+            os << val;
+            break;
+        }
+        case oids::type::int8: {
+            bigint val{0};
+            if (!read_binary(begin, end, val))
+                return false;
+            os << val;
+            break;
+        }
+        case oids::type::oid:
+        case oids::type::xid:
+        case oids::type::cid: {
+            integer val{0};
+            if (!read_binary(begin, end, val))
+                return false;
+            os << (uinteger)val;
+            break;
+        }
+        case oids::type::tid: {
+            integer block{0};
+            smallint offset{0};
+            if (!read_binary(begin, end, block) || !read_binary(begin, end, offset))
+                return false;
+            os << '(' << (uinteger)block << ',' << (usmallint)offset << ')';
+            break;
+        }
+        case oids::type::float4:
+            if (!write_float<float>(os, begin, end))
+                return false;
+            break;
+        case oids::type::float8:
+            if (!write_float<double>(os, begin, end))
+                return false;
+            break;
+        case oids::type::numeric:
+            if (!write_numeric(os, begin, end))
+                return false;
+            break;
+        case oids::type::date: {
+            integer days{0};
+            if (!read_binary(begin, end, days))
+                return false;
+            write_date(os, days);
+            break;
+        }
+        case oids::type::time: {
+            bigint usecs{0};
+            if (!read_binary(begin, end, usecs))
+                return false;
+            write_clock(os, usecs);
+            break;
+        }
+        case oids::type::timetz: {
+            bigint usecs{0};
+            integer zone{0};
+            if (!read_binary(begin, end, usecs) || !read_binary(begin, end, zone))
+                return false;
+            write_clock(os, usecs);
+            // Zone is stored as seconds west of UTC
+            zone = -zone;
+            os << (zone < 0 ? '-' : '+');
+            if (zone < 0)
+                zone = -zone;
+            write_2digits(os, zone / 3600);
+            if (zone % 3600) {
+                os << ':';
+                write_2digits(os, zone % 3600 / 60);
+                if (zone % 60) {
+                    os << ':';
+                    write_2digits(os, zone % 60);
+                }
+            }
+            break;
+        }
+        case oids::type::timestamp:
+            if (!write_timestamp(os, begin, end))
+                return false;
+            break;
+        case oids::type::timestamptz:
+            if (!write_timestamp(os, begin, end))
+                return false;
+            os << "+00";
+            break;
+        case oids::type::interval:
+            if (!write_interval(os, begin, end))
+                return false;
+            break;
+        case oids::type::bytea:
+            os << "\\x";
+            write_hex(os, begin, end);
+            break;
+        case oids::type::uuid:
+            if (end - begin != 16)
+                return false;
+            write_hex(os, begin, begin + 4);
+            os << '-';
+            write_hex(os, begin + 4, begin + 6);
+            os << '-';
+            write_hex(os, begin + 6, begin + 8);
+            os << '-';
+            write_hex(os, begin + 8, begin + 10);
+            os << '-';
+            write_hex(os, begin + 10, end);
+            break;
+        case oids::type::inet:
+        case oids::type::cidr:
+            if (!write_inet(os, begin, end))
+                return false;
+            break;
+        case oids::type::macaddr:
+            if (end - begin != 6)
+                return false;
+            for (auto c = begin; c != end; ++c) {
+                if (c != begin)
+                    os << ':';
+                write_hex(os, c, c + 1);
+            }
+            break;
+        case oids::type::bool_array:
+        case oids::type::bytea_array:
+        case oids::type::char_array:
+        case oids::type::name_array:
+        case oids::type::int2_array:
+        case oids::type::int4_array:
+        case oids::type::int8_array:
+        case oids::type::text_array:
+        case oids::type::oid_array:
+        case oids::type::tid_array:
+        case oids::type::xid_array:
+        case oids::type::cid_array:
+        case oids::type::bpchar_array:
+        case oids::type::varchar_array:
+        case oids::type::float4_array:
+        case oids::type::float8_array:
+        case oids::type::macaddr_array:
+        case oids::type::inet_array:
+        case oids::type::cidr_array:
+        case oids::type::timestamp_array:
+        case oids::type::date_array:
+        case oids::type::time_array:
+        case oids::type::timetz_array:
+        case oids::type::timestamptz_array:
+        case oids::type::interval_array:
+        case oids::type::numeric_array:
+        case oids::type::uuid_array:
+        case oids::type::json_array:
+        case oids::type::jsonb_array:
+            if (!write_array(os, begin, end))
+                return false;
+            break;
+        case oids::type::jsonb:
+            // Version byte, currently is 1
+            if (begin == end || *begin != 1)
+                return false;
+            ++begin;
+            text.assign(begin, end);
+            return true;
+        case oids::type::text:
+        case oids::type::varchar:
+        case oids::type::bpchar:
+        case oids::type::name:
+        case oids::type::json:
+        case oids::type::xml:
+            text.assign(begin, end);
+            return true;
+        default:
+            return false;
+    }
+    text = os.str();
+    return true;
+}
+
 }  // namespace io
 }  // namespace pg
 }  // namespace db
@@ -26,8 +26,10 @@ struct query::impl : std::enable_shared_from_this<query::impl> {
     transaction_ptr     tran_; // @todo make it a weak pointer
     std::string         expression_;
 
-    type_oid_sequence   param_types_;
-    params_buffer       params_;
+    /** Statement and encoded parameters, are not set for a query without
+     * parameters. Shared with the runs, replaced on bind */
+    prepared_statement_ptr  statement_;
+    params_buffer_ptr       params_;
 
     impl(dbalias const& alias, transaction_mode const& m,
             std::string const& expression)
@@ -43,66 +45,77 @@ struct query::impl : std::enable_shared_from_this<query::impl> {
     impl(dbalias const& alias, transaction_mode const& m,
             std::string const& expression,
             type_oid_sequence&& param_types, params_buffer&& params)
-        : alias_{alias}, mode_{m}, tran_{}, expression_{expression},
-          param_types_{std::move(param_types)}, params_{std::move(params)}
+        : alias_{alias}, mode_{m}, tran_{}, expression_{expression}
     {
+        set_params(std::move(param_types), std::move(params));
     }
 
     impl(transaction_ptr tran, std::string const& expression,
             type_oid_sequence&& param_types, params_buffer&& params)
-        : alias_(tran->alias()), tran_(tran), expression_(expression),
-          param_types_(std::move(param_types)), params_(std::move(params))
+        : alias_(tran->alias()), tran_(tran), expression_(expression)
     {
+        set_params(std::move(param_types), std::move(params));
     }
 
-    impl(impl const& rhs)
-        : enable_shared_from_this(rhs),
-          alias_(rhs.alias_), tran_(), expression_(rhs.expression_),
-          param_types_(rhs.param_types_), params_(rhs.params_)
+    void
+    set_params(type_oid_sequence&& param_types, params_buffer&& params)
     {
+        if (params.empty()) {
+            clear_params();
+            return;
+        }
+        if (!statement_ || statement_->param_types != param_types) {
+            statement_ = std::make_shared< prepared_statement const >(
+                    expression_, std::move(param_types));
+        }
+        params_ = std::make_shared< params_buffer const >(std::move(params));
     }
 
     void
     clear_params()
     {
-        params_buffer params;
-        io::protocol_write<BINARY_DATA_FORMAT>(params, (smallint)0); // format codes
-        io::protocol_write<BINARY_DATA_FORMAT>(params, (smallint)0); // number of parameters
+        statement_.reset();
+        params_.reset();
     }
 
     void
     run_async(query_result_callback const& res, error_callback const& err)
     {
+        // The transaction the query was created with is used for one run
+        transaction_ptr tran;
+        tran.swap(tran_);
         // TODO wrap res & err in strand
-        if (!tran_) {
+        if (!tran) {
             db_service::begin(
                 alias_,
                 std::bind(&impl::handle_get_transaction,
-                        shared_from_this(), std::placeholders::_1, res, err),
+                        shared_from_this(), std::placeholders::_1,
+                        statement_, params_, res, err),
                 std::bind(&impl::handle_get_connection_error,
                         shared_from_this(), std::placeholders::_1, err),
                 mode_
             );
         } else {
-            handle_get_transaction(tran_, res, err);
+            handle_get_transaction(tran, statement_, params_, res, err);
         }
     }
 
     void
     handle_get_transaction(transaction_ptr t,
+            prepared_statement_ptr const& statement,
+            params_buffer_ptr const& params,
             query_result_callback const& res,
             error_callback const& err)
     {
         namespace util = ::psst::util;
-        tran_ = t;
-        if (params_.empty()) {
+        if (!params) {
             {
                 local_log() << "Execute query "
                         << (util::MAGENTA | util::BRIGHT)
                         << expression_
                         << logger::severity_color();
             }
-            tran_->execute(expression_, res, err);
+            t->execute(expression_, res, err);
         } else {
             {
                 local_log() << "Execute prepared query "
@@ -110,9 +123,8 @@ struct query::impl : std::enable_shared_from_this<query::impl> {
                         << expression_
                         << logger::severity_color();
             }
-            tran_->execute(expression_, param_types_, params_, res, err);
+            t->execute(statement, params, res, err);
         }
-        tran_.reset();
     }
 
     void
@@ -148,7 +160,6 @@ void
 query::run_async(query_result_callback const& res, error_callback const& err) const
 {
     pimpl_->run_async(res, err);
-    pimpl_.reset(new impl(*pimpl_.get()));
 }
 
 void
@@ -174,16 +185,10 @@ query::create_impl(transaction_ptr t, std::string const& expression,
             std::move(param_types), std::move(params)));
 }
 
-query::params_buffer&
-query::buffer()
-{
-    return pimpl_->params_;
-}
-
-type_oid_sequence&
-query::param_types()
+void
+query::set_params(type_oid_sequence&& param_types, params_buffer&& params)
 {
-    return pimpl_->param_types_;
+    pimpl_->set_params(std::move(param_types), std::move(params));
 }
 
 }  // namespace pg
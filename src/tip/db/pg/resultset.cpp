@@ -8,10 +8,12 @@
 #include <tip/db/pg/resultset.hpp>
 #include <tip/db/pg/detail/protocol.hpp>
 #include <tip/db/pg/detail/result_impl.hpp>
+#include <tip/db/pg/detail/protocol_parsers.hpp>
 
 #include <tip/db/pg/log.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <assert.h>
 
 namespace tip {
@@ -150,6 +152,12 @@ resultset::field::input_buffer() const
 	return result_->at(row_index_, field_index_);
 }
 
+char const*
+resultset::field::raw_data(std::size_t& size) const
+{
+	return result_->raw_data(row_index_, field_index_, size);
+}
+
 //----------------------------------------------------------------------------
 // result::const_field_iterator implementation
 //----------------------------------------------------------------------------
@@ -281,14 +289,9 @@ resultset::row_description() const
 resultset::size_type
 resultset::index_of_name(std::string const& name) const
 {
-	row_description_type const& descriptions
-		= pimpl_->row_description();
-	auto f = std::find_if(descriptions.begin(), descriptions.end(),
-			[name](field_description const& fd) {
-				return fd.name == name;
-			});
-	if (f != descriptions.end()) {
-		return f - descriptions.begin();
+	size_t index = pimpl_->index_of_name(name);
+	if (index != detail::result_impl::npos) {
+		return index;
 	}
 	return npos;
 }
@@ -302,11 +305,10 @@ resultset::field(size_type col_index) const
 field_description const&
 resultset::field(std::string const& name) const
 {
-	for (field_description const& fd : pimpl_->row_description()) {
-		if (fd.name == name)
-			return fd;
-	}
-	throw std::runtime_error("No field with name");
+	size_t index = pimpl_->index_of_name(name);
+	if (index == detail::result_impl::npos)
+		throw std::runtime_error("No field with name");
+	return pimpl_->row_description()[index];
 }
 
 std::string const&
@@ -321,12 +323,37 @@ resultset::at(size_type r, row::size_type c) const
 	return pimpl_->at(r, c);
 }
 
+char const*
+resultset::raw_data(size_type r, row::size_type c, std::size_t& size) const
+{
+	detail::row_data::data_buffer_bounds b = pimpl_->buffer_bounds(r, c);
+	size = b.second - b.first;
+	return size ? &*b.first : "";
+}
+
 bool
 resultset::is_null(size_type r, row::size_type c) const
 {
 	return pimpl_->is_null(r, c);
 }
 
+bool
+resultset::read_fixed_width(row::size_type c, std::size_t width, void* out) const
+{
+	char* p = static_cast< char* >(out);
+	size_type rows = size();
+	for (size_type r = 0; r < rows; ++r, p += width) {
+		if (pimpl_->is_null(r, c))
+			return false;
+		detail::row_data::data_buffer_bounds b = pimpl_->buffer_bounds(r, c);
+		if (static_cast< std::size_t >(b.second - b.first) != width)
+			return false;
+		std::memcpy(p, &*b.first, width);
+	}
+	io::detail::big_to_native(static_cast< char* >(out), rows, width);
+	return true;
+}
+
 }  // namespace pg
 }  // namespace db
 }  // namespace tip
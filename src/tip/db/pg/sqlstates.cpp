@@ -1,5 +1,6 @@
 #include <tip/db/pg/sqlstates.hpp>
-#include <map>
+#include <algorithm>
+#include <cstdint>
 
 namespace tip {
 namespace db {
@@ -7,364 +8,412 @@ namespace pg {
 namespace sqlstate {
 
 namespace {
-const std::map<std::string, code> CODESTR_TO_STATE {
+
+/** Size of a SQLSTATE code */
+constexpr std::size_t code_size = 5;
+/** Value of a character that is not a base-36 digit */
+constexpr std::uint32_t invalid_digit = 36;
+
+constexpr std::uint32_t
+digit(char c)
+{
+	return c >= '0' && c <= '9' ? c - '0' :
+			c >= 'A' && c <= 'Z' ? c - 'A' + 10 : invalid_digit;
+}
+
+/**
+ * Pack a SQLSTATE code into an integer as a base-36 number.
+ * Order of packed values is the same as the order of code strings.
+ */
+constexpr std::uint32_t
+pack(char const* str, std::size_t n = code_size, std::uint32_t acc = 0)
+{
+	return n == 0 ? acc : pack(str + 1, n - 1, acc * 36 + digit(*str));
+}
+
+struct packed_state {
+	std::uint32_t	packed;
+	code			state;
+};
+
+/** Packed codes sorted for binary search */
+constexpr packed_state CODESTR_TO_STATE[] {
 		//@{
 		/** @name Class 00 — Successful Completion */
-		{ "00000", successful_completion },
+		{ pack("00000"), successful_completion },
 		//@}
 		//@{
 		/** @name Class 01 — Warning */
-		{ "01000", warning },
-		{ "0100C", dynamic_result_sets_returned },
-		{ "01008", implicit_zero_bit_padding },
-		{ "01003", null_value_eliminated_in_set_function },
-		{ "01007", privilege_not_granted },
-		{ "01006", privilege_not_revoked },
-		{ "01004", string_data_right_truncation },
-		{ "01P01", deprecated_feature },
+		{ pack("01000"), warning },
+		{ pack("01003"), null_value_eliminated_in_set_function },
+		{ pack("01004"), string_data_right_truncation },
+		{ pack("01006"), privilege_not_revoked },
+		{ pack("01007"), privilege_not_granted },
+		{ pack("01008"), implicit_zero_bit_padding },
+		{ pack("0100C"), dynamic_result_sets_returned },
+		{ pack("01P01"), deprecated_feature },
 		//@}
 		//@{
 		/** @name Class 02 — No Data (this is also a warning class per the SQL standard) */
-		{ "02000", no_data },
-		{ "02001", no_additional_dynamic_result_sets_returned },
+		{ pack("02000"), no_data },
+		{ pack("02001"), no_additional_dynamic_result_sets_returned },
 		//@}
 		//@{
 		/** @name Class 03 — SQL Statement Not Yet Complete */
-		{ "03000", sql_statement_not_yet_complete },
+		{ pack("03000"), sql_statement_not_yet_complete },
 		//@}
 		//@{
 		/** @name Class 08 — Connection Exception */
-		{ "08000", connection_exception },
-		{ "08003", connection_does_not_exist },
-		{ "08006", connection_failure },
-		{ "08001", sqlclient_unable_to_establish_sqlconnection },
-		{ "08004", sqlserver_rejected_establishment_of_sqlconnection },
-		{ "08007", transaction_resolution_unknown },
-		{ "08P01", protocol_violation },
+		{ pack("08000"), connection_exception },
+		{ pack("08001"), sqlclient_unable_to_establish_sqlconnection },
+		{ pack("08003"), connection_does_not_exist },
+		{ pack("08004"), sqlserver_rejected_establishment_of_sqlconnection },
+		{ pack("08006"), connection_failure },
+		{ pack("08007"), transaction_resolution_unknown },
+		{ pack("08P01"), protocol_violation },
 		//@}
 		//@{
 		/** @name Class 09 — Triggered Action Exception */
-		{ "09000", triggered_action_exception },
+		{ pack("09000"), triggered_action_exception },
 		//@}
 		//@{
 		/** @name Class 0A — Feature Not Supported */
-		{ "0A000", feature_not_supported },
+		{ pack("0A000"), feature_not_supported },
 		//@}
 		//@{
 		/** @name Class 0B — Invalid Transaction Initiation */
-		{ "0B000", invalid_transaction_initiation },
+		{ pack("0B000"), invalid_transaction_initiation },
 		//@}
 		//@{
 		/** @name Class 0F — Locator Exception */
-		{ "0F000", locator_exception },
-		{ "0F001", invalid_locator_specification },
+		{ pack("0F000"), locator_exception },
+		{ pack("0F001"), invalid_locator_specification },
 		//@}
 		//@{
 		/** @name Class 0L — Invalid Grantor */
-		{ "0L000", invalid_grantor },
-		{ "0LP01", invalid_grant_operation },
+		{ pack("0L000"), invalid_grantor },
+		{ pack("0LP01"), invalid_grant_operation },
 		//@}
 		//@{
 		/** @name Class 0P — Invalid Role Specification */
-		{ "0P000", invalid_role_specification },
+		{ pack("0P000"), invalid_role_specification },
 		//@}
 		//@{
 		/** @name Class 0Z — Diagnostics Exception */
-		{ "0Z000", diagnostics_exception },
-		{ "0Z002", stacked_diagnostics_accessed_without_active_handler },
+		{ pack("0Z000"), diagnostics_exception },
+		{ pack("0Z002"), stacked_diagnostics_accessed_without_active_handler },
 		//@}
 		//@{
 		/** @name Class 20 — Case Not Found */
-		{ "20000", case_not_found },
+		{ pack("20000"), case_not_found },
 		//@}
 		//@{
 		/** @name Class 21 — Cardinality Violation */
-		{ "21000", cardinality_violation },
+		{ pack("21000"), cardinality_violation },
 		//@}
 		//@{
 		/** @name Class 22 — Data Exception */
-		{ "22000", data_exception },
-		{ "2202E", array_subscript_error },
-		{ "22021", character_not_in_repertoire },
-		{ "22008", datetime_field_overflow },
-		{ "22012", division_by_zero },
-		{ "22005", error_in_assignment },
-		{ "2200B", escape_character_conflict },
-		{ "22022", indicator_overflow },
-		{ "22015", interval_field_overflow },
-		{ "2201E", invalid_argument_for_logarithm },
-		{ "22014", invalid_argument_for_ntile_function },
-		{ "22016", invalid_argument_for_nth_value_function },
-		{ "2201F", invalid_argument_for_power_function },
-		{ "2201G", invalid_argument_for_width_bucket_function },
-		{ "22018", invalid_character_value_for_cast },
-		{ "22007", invalid_datetime_format },
-		{ "22019", invalid_escape_character },
-		{ "2200D", invalid_escape_octet },
-		{ "22025", invalid_escape_sequence },
-		{ "22P06", nonstandard_use_of_escape_character },
-		{ "22010", invalid_indicator_parameter_value },
-		{ "22023", invalid_parameter_value },
-		{ "2201B", invalid_regular_expression },
-		{ "2201W", invalid_row_count_in_limit_clause },
-		{ "2201X", invalid_row_count_in_result_offset_clause },
-		{ "22009", invalid_time_zone_displacement_value },
-		{ "2200C", invalid_use_of_escape_character },
-		{ "2200G", most_specific_type_mismatch },
-		{ "22004", null_value_not_allowed },
-		{ "22002", null_value_no_indicator_parameter },
-		{ "22003", numeric_value_out_of_range },
-		{ "22026", string_data_length_mismatch },
-		{ "22001", string_data_right_truncation },
-		{ "22011", substring_error },
-		{ "22027", trim_error },
-		{ "22024", unterminated_c_string },
-		{ "2200F", zero_length_character_string },
-		{ "22P01", floating_point_exception },
-		{ "22P02", invalid_text_representation },
-		{ "22P03", invalid_binary_representation },
-		{ "22P04", bad_copy_file_format },
-		{ "22P05", untranslatable_character },
-		{ "2200L", not_an_xml_document },
-		{ "2200M", invalid_xml_document },
-		{ "2200N", invalid_xml_content },
-		{ "2200S", invalid_xml_comment },
-		{ "2200T", invalid_xml_processing_instruction },
+		{ pack("22000"), data_exception },
+		{ pack("22001"), string_data_right_truncation },
+		{ pack("22002"), null_value_no_indicator_parameter },
+		{ pack("22003"), numeric_value_out_of_range },
+		{ pack("22004"), null_value_not_allowed },
+		{ pack("22005"), error_in_assignment },
+		{ pack("22007"), invalid_datetime_format },
+		{ pack("22008"), datetime_field_overflow },
+		{ pack("22009"), invalid_time_zone_displacement_value },
+		{ pack("2200B"), escape_character_conflict },
+		{ pack("2200C"), invalid_use_of_escape_character },
+		{ pack("2200D"), invalid_escape_octet },
+		{ pack("2200F"), zero_length_character_string },
+		{ pack("2200G"), most_specific_type_mismatch },
+		{ pack("2200L"), not_an_xml_document },
+		{ pack("2200M"), invalid_xml_document },
+		{ pack("2200N"), invalid_xml_content },
+		{ pack("2200S"), invalid_xml_comment },
+		{ pack("2200T"), invalid_xml_processing_instruction },
+		{ pack("22010"), invalid_indicator_parameter_value },
+		{ pack("22011"), substring_error },
+		{ pack("22012"), division_by_zero },
+		{ pack("22014"), invalid_argument_for_ntile_function },
+		{ pack("22015"), interval_field_overflow },
+		{ pack("22016"), invalid_argument_for_nth_value_function },
+		{ pack("22018"), invalid_character_value_for_cast },
+		{ pack("22019"), invalid_escape_character },
+		{ pack("2201B"), invalid_regular_expression },
+		{ pack("2201E"), invalid_argument_for_logarithm },
+		{ pack("2201F"), invalid_argument_for_power_function },
+		{ pack("2201G"), invalid_argument_for_width_bucket_function },
+		{ pack("2201W"), invalid_row_count_in_limit_clause },
+		{ pack("2201X"), invalid_row_count_in_result_offset_clause },
+		{ pack("22021"), character_not_in_repertoire },
+		{ pack("22022"), indicator_overflow },
+		{ pack("22023"), invalid_parameter_value },
+		{ pack("22024"), unterminated_c_string },
+		{ pack("22025"), invalid_escape_sequence },
+		{ pack("22026"), string_data_length_mismatch },
+		{ pack("22027"), trim_error },
+		{ pack("2202E"), array_subscript_error },
+		{ pack("22P01"), floating_point_exception },
+		{ pack("22P02"), invalid_text_representation },
+		{ pack("22P03"), invalid_binary_representation },
+		{ pack("22P04"), bad_copy_file_format },
+		{ pack("22P05"), untranslatable_character },
+		{ pack("22P06"), nonstandard_use_of_escape_character },
 		//@}
 		//@{
 		/** @name Class 23 — Integrity Constraint Violation */
-		{ "23000", integrity_constraint_violation },
-		{ "23001", restrict_violation },
-		{ "23502", not_null_violation },
-		{ "23503", foreign_key_violation },
-		{ "23505", unique_violation },
-		{ "23514", check_violation },
-		{ "23P01", exclusion_violation },
+		{ pack("23000"), integrity_constraint_violation },
+		{ pack("23001"), restrict_violation },
+		{ pack("23502"), not_null_violation },
+		{ pack("23503"), foreign_key_violation },
+		{ pack("23505"), unique_violation },
+		{ pack("23514"), check_violation },
+		{ pack("23P01"), exclusion_violation },
 		//@}
 		//@{
 		/** @name Class 24 — Invalid Cursor State */
-		{ "24000", invalid_cursor_state },
+		{ pack("24000"), invalid_cursor_state },
 		//@}
 		//@{
 		/** @name Class 25 — Invalid Transaction State */
-		{ "25000", invalid_transaction_state },
-		{ "25001", active_sql_transaction },
-		{ "25002", branch_transaction_already_active },
-		{ "25008", held_cursor_requires_same_isolation_level },
-		{ "25003", inappropriate_access_mode_for_branch_transaction },
-		{ "25004", inappropriate_isolation_level_for_branch_transaction },
-		{ "25005", no_active_sql_transaction_for_branch_transaction },
-		{ "25006", read_only_sql_transaction },
-		{ "25007", schema_and_data_statement_mixing_not_supported },
-		{ "25P01", no_active_sql_transaction },
-		{ "25P02", in_failed_sql_transaction },
+		{ pack("25000"), invalid_transaction_state },
+		{ pack("25001"), active_sql_transaction },
+		{ pack("25002"), branch_transaction_already_active },
+		{ pack("25003"), inappropriate_access_mode_for_branch_transaction },
+		{ pack("25004"), inappropriate_isolation_level_for_branch_transaction },
+		{ pack("25005"), no_active_sql_transaction_for_branch_transaction },
+		{ pack("25006"), read_only_sql_transaction },
+		{ pack("25007"), schema_and_data_statement_mixing_not_supported },
+		{ pack("25008"), held_cursor_requires_same_isolation_level },
+		{ pack("25P01"), no_active_sql_transaction },
+		{ pack("25P02"), in_failed_sql_transaction },
 		//@}
 		//@{
 		/** @name Class 26 — Invalid SQL Statement Name */
-		{ "26000", invalid_sql_statement_name },
+		{ pack("26000"), invalid_sql_statement_name },
 		//@}
 		//@{
 		/** @name Class 27 — Triggered Data Change Violation */
-		{ "27000", triggered_data_change_violation },
+		{ pack("27000"), triggered_data_change_violation },
 		//@}
 		//@{
 		/** @name Class 28 — Invalid Authorization Specification */
-		{ "28000", invalid_authorization_specification },
-		{ "28P01", invalid_password },
+		{ pack("28000"), invalid_authorization_specification },
+		{ pack("28P01"), invalid_password },
 		//@}
 		//@{
 		/** @name Class 2B — Dependent Privilege Descriptors Still Exist */
-		{ "2B000", dependent_privilege_descriptors_still_exist },
-		{ "2BP01", dependent_objects_still_exist },
+		{ pack("2B000"), dependent_privilege_descriptors_still_exist },
+		{ pack("2BP01"), dependent_objects_still_exist },
 		//@}
 		//@{
 		/** @name Class 2D — Invalid Transaction Termination */
-		{ "2D000", invalid_transaction_termination },
+		{ pack("2D000"), invalid_transaction_termination },
 		//@}
 		//@{
 		/** @name Class 2F — SQL Routine Exception */
-		{ "2F000", sql_routine_exception },
-		{ "2F005", function_executed_no_return_statement },
-		{ "2F002", modifying_sql_data_not_permitted },
-		{ "2F003", prohibited_sql_statement_attempted },
-		{ "2F004", reading_sql_data_not_permitted },
+		{ pack("2F000"), sql_routine_exception },
+		{ pack("2F002"), modifying_sql_data_not_permitted },
+		{ pack("2F003"), prohibited_sql_statement_attempted },
+		{ pack("2F004"), reading_sql_data_not_permitted },
+		{ pack("2F005"), function_executed_no_return_statement },
 		//@}
 		//@{
 		/** @name Class 34 — Invalid Cursor Name */
-		{ "34000", invalid_cursor_name },
+		{ pack("34000"), invalid_cursor_name },
 		//@}
 		//@{
 		/** @name Class 38 — External Routine Exception */
-		{ "38000", external_routine_exception },
-		{ "38001", containing_sql_not_permitted },
-		{ "38002", modifying_sql_data_not_permitted },
-		{ "38003", prohibited_sql_statement_attempted },
-		{ "38004", reading_sql_data_not_permitted },
+		{ pack("38000"), external_routine_exception },
+		{ pack("38001"), containing_sql_not_permitted },
+		{ pack("38002"), modifying_sql_data_not_permitted },
+		{ pack("38003"), prohibited_sql_statement_attempted },
+		{ pack("38004"), reading_sql_data_not_permitted },
 		//@}
 		//@{
 		/** @name Class 39 — External Routine Invocation Exception */
-		{ "39000", external_routine_invocation_exception },
-		{ "39001", invalid_sqlstate_returned },
-		{ "39004", null_value_not_allowed },
-		{ "39P01", trigger_protocol_violated },
-		{ "39P02", srf_protocol_violated },
+		{ pack("39000"), external_routine_invocation_exception },
+		{ pack("39001"), invalid_sqlstate_returned },
+		{ pack("39004"), null_value_not_allowed },
+		{ pack("39P01"), trigger_protocol_violated },
+		{ pack("39P02"), srf_protocol_violated },
 		//@}
 		//@{
 		/** @name Class 3B — Savepoint Exception */
-		{ "3B000", savepoint_exception },
-		{ "3B001", invalid_savepoint_specification },
+		{ pack("3B000"), savepoint_exception },
+		{ pack("3B001"), invalid_savepoint_specification },
 		//@}
 		//@{
 		/** @name Class 3D — Invalid Catalog Name */
-		{ "3D000", invalid_catalog_name },
+		{ pack("3D000"), invalid_catalog_name },
 		//@}
 		//@{
 		/** @name Class 3F — Invalid Schema Name */
-		{ "3F000", invalid_schema_name },
+		{ pack("3F000"), invalid_schema_name },
 		//@}
 		//@{
 		/** @name Class 40 — Transaction Rollback */
-		{ "40000", transaction_rollback },
-		{ "40002", transaction_integrity_constraint_violation },
-		{ "40001", serialization_failure },
-		{ "40003", statement_completion_unknown },
-		{ "40P01", deadlock_detected },
+		{ pack("40000"), transaction_rollback },
+		{ pack("40001"), serialization_failure },
+		{ pack("40002"), transaction_integrity_constraint_violation },
+		{ pack("40003"), statement_completion_unknown },
+		{ pack("40P01"), deadlock_detected },
 		//@}
 		//@{
 		/** @name Class 42 — Syntax Error or Access Rule Violation */
-		{ "42000", syntax_error_or_access_rule_violation },
-		{ "42601", syntax_error },
-		{ "42501", insufficient_privilege },
-		{ "42846", cannot_coerce },
-		{ "42803", grouping_error },
-		{ "42P20", windowing_error },
-		{ "42P19", invalid_recursion },
-		{ "42830", invalid_foreign_key },
-		{ "42602", invalid_name },
-		{ "42622", name_too_long },
-		{ "42939", reserved_name },
-		{ "42804", datatype_mismatch },
-		{ "42P18", indeterminate_datatype },
-		{ "42P21", collation_mismatch },
-		{ "42P22", indeterminate_collation },
-		{ "42809", wrong_object_type },
-		{ "42703", undefined_column },
-		{ "42883", undefined_function },
-		{ "42P01", undefined_table },
-		{ "42P02", undefined_parameter },
-		{ "42704", undefined_object },
-		{ "42701", duplicate_column },
-		{ "42P03", duplicate_cursor },
-		{ "42P04", duplicate_database },
-		{ "42723", duplicate_function },
-		{ "42P05", duplicate_prepared_statement },
-		{ "42P06", duplicate_schema },
-		{ "42P07", duplicate_table },
-		{ "42712", duplicate_alias },
-		{ "42710", duplicate_object },
-		{ "42702", ambiguous_column },
-		{ "42725", ambiguous_function },
-		{ "42P08", ambiguous_parameter },
-		{ "42P09", ambiguous_alias },
-		{ "42P10", invalid_column_reference },
-		{ "42611", invalid_column_definition },
-		{ "42P11", invalid_cursor_definition },
-		{ "42P12", invalid_database_definition },
-		{ "42P13", invalid_function_definition },
-		{ "42P14", invalid_prepared_statement_definition },
-		{ "42P15", invalid_schema_definition },
-		{ "42P16", invalid_table_definition },
-		{ "42P17", invalid_object_definition },
+		{ pack("42000"), syntax_error_or_access_rule_violation },
+		{ pack("42501"), insufficient_privilege },
+		{ pack("42601"), syntax_error },
+		{ pack("42602"), invalid_name },
+		{ pack("42611"), invalid_column_definition },
+		{ pack("42622"), name_too_long },
+		{ pack("42701"), duplicate_column },
+		{ pack("42702"), ambiguous_column },
+		{ pack("42703"), undefined_column },
+		{ pack("42704"), undefined_object },
+		{ pack("42710"), duplicate_object },
+		{ pack("42712"), duplicate_alias },
+		{ pack("42723"), duplicate_function },
+		{ pack("42725"), ambiguous_function },
+		{ pack("42803"), grouping_error },
+		{ pack("42804"), datatype_mismatch },
+		{ pack("42809"), wrong_object_type },
+		{ pack("42830"), invalid_foreign_key },
+		{ pack("42846"), cannot_coerce },
+		{ pack("42883"), undefined_function },
+		{ pack("42939"), reserved_name },
+		{ pack("42P01"), undefined_table },
+		{ pack("42P02"), undefined_parameter },
+		{ pack("42P03"), duplicate_cursor },
+		{ pack("42P04"), duplicate_database },
+		{ pack("42P05"), duplicate_prepared_statement },
+		{ pack("42P06"), duplicate_schema },
+		{ pack("42P07"), duplicate_table },
+		{ pack("42P08"), ambiguous_parameter },
+		{ pack("42P09"), ambiguous_alias },
+		{ pack("42P10"), invalid_column_reference },
+		{ pack("42P11"), invalid_cursor_definition },
+		{ pack("42P12"), invalid_database_definition },
+		{ pack("42P13"), invalid_function_definition },
+		{ pack("42P14"), invalid_prepared_statement_definition },
+		{ pack("42P15"), invalid_schema_definition },
+		{ pack("42P16"), invalid_table_definition },
+		{ pack("42P17"), invalid_object_definition },
+		{ pack("42P18"), indeterminate_datatype },
+		{ pack("42P19"), invalid_recursion },
+		{ pack("42P20"), windowing_error },
+		{ pack("42P21"), collation_mismatch },
+		{ pack("42P22"), indeterminate_collation },
 		//@}
 		//@{
 		/** @name Class 44 — WITH CHECK OPTION Violation */
-		{ "44000", with_check_option_violation },
+		{ pack("44000"), with_check_option_violation },
 		//@}
 		//@{
 		/** @name Class 53 — Insufficient Resources */
-		{ "53000", insufficient_resources },
-		{ "53100", disk_full },
-		{ "53200", out_of_memory },
-		{ "53300", too_many_connections },
-		{ "53400", configuration_limit_exceeded },
+		{ pack("53000"), insufficient_resources },
+		{ pack("53100"), disk_full },
+		{ pack("53200"), out_of_memory },
+		{ pack("53300"), too_many_connections },
+		{ pack("53400"), configuration_limit_exceeded },
 		//@}
 		//@{
 		/** @name Class 54 — Program Limit Exceeded */
-		{ "54000", program_limit_exceeded },
-		{ "54001", statement_too_complex },
-		{ "54011", too_many_columns },
-		{ "54023", too_many_arguments },
+		{ pack("54000"), program_limit_exceeded },
+		{ pack("54001"), statement_too_complex },
+		{ pack("54011"), too_many_columns },
+		{ pack("54023"), too_many_arguments },
 		//@}
 		//@{
 		/** @name Class 55 — Object Not In Prerequisite State */
-		{ "55000", object_not_in_prerequisite_state },
-		{ "55006", object_in_use },
-		{ "55P02", cant_change_runtime_param },
-		{ "55P03", lock_not_available },
+		{ pack("55000"), object_not_in_prerequisite_state },
+		{ pack("55006"), object_in_use },
+		{ pack("55P02"), cant_change_runtime_param },
+		{ pack("55P03"), lock_not_available },
 		//@}
 		//@{
 		/** @name Class 57 — Operator Intervention */
-		{ "57000", operator_intervention },
-		{ "57014", query_canceled },
-		{ "57P01", admin_shutdown },
-		{ "57P02", crash_shutdown },
-		{ "57P03", cannot_connect_now },
-		{ "57P04", database_dropped },
-		{ "58000", system_error },
-		{ "58030", io_error },
-		{ "58P01", undefined_file },
-		{ "58P02", duplicate_file },
+		{ pack("57000"), operator_intervention },
+		{ pack("57014"), query_canceled },
+		{ pack("57P01"), admin_shutdown },
+		{ pack("57P02"), crash_shutdown },
+		{ pack("57P03"), cannot_connect_now },
+		{ pack("57P04"), database_dropped },
+		{ pack("58000"), system_error },
+		{ pack("58030"), io_error },
+		{ pack("58P01"), undefined_file },
+		{ pack("58P02"), duplicate_file },
 		//@}
 		//@{
 		/** @name Class F0 — Configuration File Error */
-		{ "F0000", config_file_error },
-		{ "F0001", lock_file_exists },
+		{ pack("F0000"), config_file_error },
+		{ pack("F0001"), lock_file_exists },
 		//@}
 		//@{
 		/** @name Class HV — Foreign Data Wrapper Error (SQL/MED) */
-		{ "HV000", fdw_error },
-		{ "HV005", fdw_column_name_not_found },
-		{ "HV002", fdw_dynamic_parameter_value_needed },
-		{ "HV010", fdw_function_sequence_error },
-		{ "HV021", fdw_inconsistent_descriptor_information },
-		{ "HV024", fdw_invalid_attribute_value },
-		{ "HV007", fdw_invalid_column_name },
-		{ "HV008", fdw_invalid_column_number },
-		{ "HV004", fdw_invalid_data_type },
-		{ "HV006", fdw_invalid_data_type_descriptors },
-		{ "HV091", fdw_invalid_descriptor_field_identifier },
-		{ "HV00B", fdw_invalid_handle },
-		{ "HV00C", fdw_invalid_option_index },
-		{ "HV00D", fdw_invalid_option_name },
-		{ "HV090", fdw_invalid_string_length_or_buffer_length },
-		{ "HV00A", fdw_invalid_string_format },
-		{ "HV009", fdw_invalid_use_of_null_pointer },
-		{ "HV014", fdw_too_many_handles },
-		{ "HV001", fdw_out_of_memory },
-		{ "HV00P", fdw_no_schemas },
-		{ "HV00J", fdw_option_name_not_found },
-		{ "HV00K", fdw_reply_handle },
-		{ "HV00Q", fdw_schema_not_found },
-		{ "HV00R", fdw_table_not_found },
-		{ "HV00L", fdw_unable_to_create_execution },
-		{ "HV00M", fdw_unable_to_create_reply },
-		{ "HV00N", fdw_unable_to_establish_connection },
+		{ pack("HV000"), fdw_error },
+		{ pack("HV001"), fdw_out_of_memory },
+		{ pack("HV002"), fdw_dynamic_parameter_value_needed },
+		{ pack("HV004"), fdw_invalid_data_type },
+		{ pack("HV005"), fdw_column_name_not_found },
+		{ pack("HV006"), fdw_invalid_data_type_descriptors },
+		{ pack("HV007"), fdw_invalid_column_name },
+		{ pack("HV008"), fdw_invalid_column_number },
+		{ pack("HV009"), fdw_invalid_use_of_null_pointer },
+		{ pack("HV00A"), fdw_invalid_string_format },
+		{ pack("HV00B"), fdw_invalid_handle },
+		{ pack("HV00C"), fdw_invalid_option_index },
+		{ pack("HV00D"), fdw_invalid_option_name },
+		{ pack("HV00J"), fdw_option_name_not_found },
+		{ pack("HV00K"), fdw_reply_handle },
+		{ pack("HV00L"), fdw_unable_to_create_execution },
+		{ pack("HV00M"), fdw_unable_to_create_reply },
+		{ pack("HV00N"), fdw_unable_to_establish_connection },
+		{ pack("HV00P"), fdw_no_schemas },
+		{ pack("HV00Q"), fdw_schema_not_found },
+		{ pack("HV00R"), fdw_table_not_found },
+		{ pack("HV010"), fdw_function_sequence_error },
+		{ pack("HV014"), fdw_too_many_handles },
+		{ pack("HV021"), fdw_inconsistent_descriptor_information },
+		{ pack("HV024"), fdw_invalid_attribute_value },
+		{ pack("HV090"), fdw_invalid_string_length_or_buffer_length },
+		{ pack("HV091"), fdw_invalid_descriptor_field_identifier },
 		//@}
 		//@{
 		/** @name Class P0 — PL/pgSQL Error */
-		{ "P0000", plpgsql_error },
-		{ "P0001", raise_exception },
-		{ "P0002", no_data_found },
-		{ "P0003", too_many_rows },
+		{ pack("P0000"), plpgsql_error },
+		{ pack("P0001"), raise_exception },
+		{ pack("P0002"), no_data_found },
+		{ pack("P0003"), too_many_rows },
 		//@}
 		//@{
 		/** @name Class XX — Internal Error */
-		{ "XX000", internal_error },
-		{ "XX001", data_corrupted },
-		{ "XX002", index_corrupted },
+		{ pack("XX000"), internal_error },
+		{ pack("XX001"), data_corrupted },
+		{ pack("XX002"), index_corrupted },
+		//@}
+};
+
+constexpr std::size_t codestr_count =
+		sizeof(CODESTR_TO_STATE) / sizeof(CODESTR_TO_STATE[0]);
+
+constexpr bool
+is_sorted(std::size_t i = 1)
+{
+	return i >= codestr_count ||
+		(CODESTR_TO_STATE[i - 1].packed < CODESTR_TO_STATE[i].packed && is_sorted(i + 1));
+}
+static_assert(is_sorted(), "SQLSTATE codes must be sorted and unique");
+
+struct state_string {
+	code			state;
+	char const*		str;
 };
 
-const std::map<code, std::string> STATE_TO_CODESTR {
+/** SQLSTATE code strings, indexed by the code */
+constexpr state_string STATE_TO_CODESTR[] {
+		{ unknown_code, "" },
 		//@{
 		/** @name Class 00 — Successful Completion */
 		{ successful_completion, "00000" },
@@ -418,7 +467,8 @@ const std::map<code, std::string> STATE_TO_CODESTR {
 		//@}
 		//@{
 		/** @name Class 0L — Invalid Grantor */
-		{ invalid_grantor, "0L000" }, { invalid_grant_operation, "0LP01" },
+		{ invalid_grantor, "0L000" },
+		{ invalid_grant_operation, "0LP01" },
 		//@}
 		//@{
 		/** @name Class 0P — Invalid Role Specification */
@@ -471,7 +521,6 @@ const std::map<code, std::string> STATE_TO_CODESTR {
 		{ null_value_no_indicator_parameter, "22002" },
 		{ numeric_value_out_of_range, "22003" },
 		{ string_data_length_mismatch, "22026" },
-		{ string_data_right_truncation, "22001" },
 		{ substring_error, "22011" },
 		{ trim_error, "22027" },
 		{ unterminated_c_string, "22024" },
@@ -553,15 +602,11 @@ const std::map<code, std::string> STATE_TO_CODESTR {
 		/** @name Class 38 — External Routine Exception */
 		{ external_routine_exception, "38000" },
 		{ containing_sql_not_permitted, "38001" },
-		{ modifying_sql_data_not_permitted, "38002" },
-		{ prohibited_sql_statement_attempted, "38003" },
-		{ reading_sql_data_not_permitted, "38004" },
 		//@}
 		//@{
 		/** @name Class 39 — External Routine Invocation Exception */
 		{ external_routine_invocation_exception, "39000" },
 		{ invalid_sqlstate_returned, "39001" },
-		{ null_value_not_allowed, "39004" },
 		{ trigger_protocol_violated, "39P01" },
 		{ srf_protocol_violated, "39P02" },
 		//@}
@@ -718,20 +763,61 @@ const std::map<code, std::string> STATE_TO_CODESTR {
 		{ internal_error, "XX000" },
 		{ data_corrupted, "XX001" },
 		{ index_corrupted, "XX002" },
+		//@}
 };
 
+constexpr std::size_t state_count =
+		sizeof(STATE_TO_CODESTR) / sizeof(STATE_TO_CODESTR[0]);
+
+constexpr bool
+is_indexed(std::size_t i = 0)
+{
+	return i >= state_count ||
+		(STATE_TO_CODESTR[i].state == static_cast<code>(i) && is_indexed(i + 1));
+}
+static_assert(state_count == index_corrupted + 1,
+		"A code string for every SQLSTATE code");
+static_assert(is_indexed(), "Code strings must be in the order of codes");
+
 } // namespace
 
 code
-code_to_state(std::string const& val)
+code_to_state(char const* val, std::size_t size)
 {
-	auto f = CODESTR_TO_STATE.find(val);
-	if (f != CODESTR_TO_STATE.end()) {
-		return f->second;
+	if (size != code_size)
+		return unknown_code;
+	for (std::size_t i = 0; i < code_size; ++i) {
+		if (digit(val[i]) == invalid_digit)
+			return unknown_code;
+	}
+	std::uint32_t packed = pack(val);
+	packed_state const* end = CODESTR_TO_STATE + codestr_count;
+	packed_state const* f = std::lower_bound(CODESTR_TO_STATE, end, packed,
+		[](packed_state const& lhs, std::uint32_t rhs)
+		{
+			return lhs.packed < rhs;
+		});
+	if (f != end && f->packed == packed) {
+		return f->state;
 	}
 	return unknown_code;
 }
 
+code
+code_to_state(std::string const& val)
+{
+	return code_to_state(val.data(), val.size());
+}
+
+char const*
+state_to_code(code val)
+{
+	std::size_t index = static_cast<std::size_t>(val);
+	if (index < state_count)
+		return STATE_TO_CODESTR[index].str;
+	return "";
+}
+
 }  // namespace sqlstate
 }  // namespace pg
 }  // namespace db
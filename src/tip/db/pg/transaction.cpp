@@ -7,6 +7,7 @@
 
 #include <tip/db/pg/transaction.hpp>
 #include <tip/db/pg/resultset.hpp>
+#include <tip/db/pg/error.hpp>
 #include <tip/db/pg/detail/basic_connection.hpp>
 #include <tip/db/pg/log.hpp>
 
@@ -50,15 +51,22 @@ transaction::in_transaction() const
 void
 transaction::commit_async(notification_callback cb, error_callback ecb)
 {
-    if (!finished_.test_and_set())
-        connection_->commit(cb);
+    if (!finished_.test_and_set()) {
+        connection_->commit(cb, ecb);
+    } else if (ecb) {
+        ecb(error::transaction_closed{});
+    }
 }
 
 void
 transaction::rollback_async(notification_callback cb, error_callback ecb)
 {
-    if (!finished_.test_and_set())
-        connection_->rollback(cb);
+    if (!finished_.test_and_set()) {
+        connection_->rollback(cb, ecb);
+    } else if (cb) {
+        // Nothing to roll back
+        cb();
+    }
 }
 void
 transaction::execute(std::string const& query, query_result_callback result,
@@ -73,12 +81,13 @@ transaction::execute(std::string const& query, query_result_callback result,
     });
 }
 void
-transaction::execute(std::string const& query, type_oid_sequence const& param_types,
+transaction::execute(std::string const& query, type_oid_sequence param_types,
         std::vector< byte > params_buffer,
         query_result_callback result, query_error_callback error)
 {
     connection_->execute(events::execute_prepared{
-        query, param_types, params_buffer,
+        query, ::std::move(param_types),
+        ::std::make_shared< std::vector< byte > const >(::std::move(params_buffer)),
         std::bind(&transaction::handle_results, shared_from_this(),
                 std::placeholders::_1, std::placeholders::_2, result),
         std::bind(&transaction::handle_query_error, shared_from_this(),
@@ -86,6 +95,21 @@ transaction::execute(std::string const& query, type_oid_sequence const& param_ty
     });
 }
 
+void
+transaction::execute(prepared_statement_ptr statement,
+        params_buffer_ptr params,
+        query_result_callback result, query_error_callback error)
+{
+    connection_->execute(events::execute_prepared{
+        {}, {}, ::std::move(params),
+        std::bind(&transaction::handle_results, shared_from_this(),
+                std::placeholders::_1, std::placeholders::_2, result),
+        std::bind(&transaction::handle_query_error, shared_from_this(),
+                std::placeholders::_1, error),
+        ::std::move(statement)
+    });
+}
+
 void
 transaction::handle_results(resultset r, bool complete, query_result_callback result)
 {
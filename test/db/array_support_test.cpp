@@ -11,12 +11,14 @@
 #include <tip/db/pg/detail/tokenizer_base.hpp>
 #include <tip/db/pg/io/vector.hpp>
 #include <tip/db/pg/io/array.hpp>
+#include <tip/db/pg/io/boost_date_time.hpp>
 
 #include "db/config.hpp"
 #include "test-environment.hpp"
 
 #include <boost/iostreams/stream_buffer.hpp>
 #include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/optional/optional_io.hpp>
 
 typedef std::vector< std::string > token_list;
 typedef std::pair< std::string, token_list > test_param_type;
@@ -239,3 +241,221 @@ TEST(ArraySupport, QuotedDatabaseRoundtrip)
 		EXPECT_EQ(in_v, out_v);
 	}
 }
+
+TEST(ArraySupport, BinaryMapping)
+{
+	using namespace tip::db::pg;
+	static_assert(io::traits::cpppg_data_mapping< std::vector< bigint > >::type_oid
+			== oids::type::int8_array, "Vector of bigint maps to int8[]");
+	static_assert(io::traits::cpppg_data_mapping< std::array< integer, 3 > >::type_oid
+			== oids::type::int4_array, "Array of integer maps to int4[]");
+	static_assert(io::traits::cpppg_data_mapping<
+			std::vector< std::vector< double > > >::type_oid
+			== oids::type::float8_array, "Nested vectors map to the element array");
+	static_assert(io::traits::cpppg_data_mapping<
+			std::vector< boost::optional< integer > > >::type_oid
+			== oids::type::int4_array, "Nullable elements map to the element array");
+	static_assert(io::traits::cpppg_data_mapping< std::vector< std::string > >::type_oid
+			== oids::type::text, "Vector of strings is sent as text");
+	static_assert(io::traits::best_formatter< std::vector< smallint > >::value
+			== BINARY_DATA_FORMAT, "Best formatter for vector of smallint is binary");
+	static_assert(io::traits::best_formatter< std::vector< std::string > >::value
+			== TEXT_DATA_FORMAT, "Best formatter for vector of strings is text");
+}
+
+TEST(ArraySupport, BinaryWriteTest)
+{
+	using namespace tip::db::pg;
+	typedef std::vector< byte > buffer_type;
+	typedef std::vector< integer > int_vector;
+
+	{
+		buffer_type buffer;
+		int_vector vals { 1, 2, 3 };
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, vals));
+		buffer_type expected {
+			0, 0, 0, 1,		// ndim
+			0, 0, 0, 0,		// no nulls
+			0, 0, 0, 23,	// int4
+			0, 0, 0, 3,		// dimension
+			0, 0, 0, 1,		// lower bound
+			0, 0, 0, 4, 0, 0, 0, 1,
+			0, 0, 0, 4, 0, 0, 0, 2,
+			0, 0, 0, 4, 0, 0, 0, 3
+		};
+		EXPECT_EQ(expected, buffer);
+		EXPECT_EQ(buffer.size(),
+				io::protocol_writer< BINARY_DATA_FORMAT >(vals).size());
+	}
+	{
+		buffer_type buffer;
+		std::vector< boost::optional< integer > > vals { 1, boost::none };
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, vals));
+		buffer_type expected {
+			0, 0, 0, 1,
+			0, 0, 0, 1,		// has nulls
+			0, 0, 0, 23,
+			0, 0, 0, 2,
+			0, 0, 0, 1,
+			0, 0, 0, 4, 0, 0, 0, 1,
+			-1, -1, -1, -1	// null
+		};
+		EXPECT_EQ(expected, buffer);
+		EXPECT_EQ(buffer.size(),
+				io::protocol_writer< BINARY_DATA_FORMAT >(vals).size());
+	}
+	{
+		buffer_type buffer;
+		int_vector vals;
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, vals));
+		EXPECT_EQ((buffer_type{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23 }), buffer);
+	}
+	{
+		// Not rectangular
+		buffer_type buffer;
+		std::vector< int_vector > vals { { 1, 2 }, { 3 } };
+		EXPECT_FALSE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, vals));
+		EXPECT_TRUE(buffer.empty());
+	}
+}
+
+TEST(ArraySupport, BinaryRoundtrip)
+{
+	using namespace tip::db::pg;
+	typedef std::vector< byte > buffer_type;
+
+	{
+		std::vector< bigint > in_v(10000), out_v;
+		for (std::size_t i = 0; i < in_v.size(); ++i) {
+			in_v[i] = 0x100000000LL * i + i;
+		}
+		buffer_type buffer;
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in_v));
+		EXPECT_EQ(20 + 12 * in_v.size(), buffer.size());
+		EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), out_v));
+		EXPECT_EQ(in_v, out_v);
+	}
+	{
+		std::vector< std::vector< integer > > in_v { { 1, 2, 3 }, { 4, 5, 6 } }, out_v;
+		buffer_type buffer;
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in_v));
+		EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), out_v));
+		EXPECT_EQ(in_v, out_v);
+		std::string text;
+		EXPECT_TRUE(io::binary_to_text(oids::type::int4_array,
+				buffer.begin(), buffer.end(), text));
+		EXPECT_EQ("{{1,2,3},{4,5,6}}", text);
+
+		// Rank mismatch
+		std::vector< integer > flat{ 42 };
+		EXPECT_EQ(buffer.begin(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), flat));
+		EXPECT_EQ(std::vector< integer >{ 42 }, flat);
+	}
+	{
+		std::vector< boost::optional< integer > > in_v { 1, boost::none, 3 }, out_v;
+		buffer_type buffer;
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in_v));
+		EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), out_v));
+		EXPECT_EQ(in_v, out_v);
+		std::string text;
+		EXPECT_TRUE(io::binary_to_text(oids::type::int4_array,
+				buffer.begin(), buffer.end(), text));
+		EXPECT_EQ("{1,NULL,3}", text);
+
+		// Null can't be read into a non-nullable element
+		std::vector< integer > ints;
+		EXPECT_EQ(buffer.begin(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), ints));
+	}
+	{
+		std::array< double, 3 > in_a {{ 1.5, -2.25, 1e100 }};
+		std::array< double, 2 > short_a {{ 0, 0 }};
+		std::array< double, 4 > long_a {{ 0, 0, 0, 42 }};
+		buffer_type buffer;
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in_a));
+		EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), short_a));
+		EXPECT_EQ((std::array< double, 2 >{{ 1.5, -2.25 }}), short_a);
+		EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), long_a));
+		EXPECT_EQ((std::array< double, 4 >{{ 1.5, -2.25, 1e100, 42 }}), long_a);
+	}
+	{
+		std::vector< integer > in_v, out_v{ 1, 2 };
+		buffer_type buffer;
+		EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in_v));
+		EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+				buffer.begin(), buffer.end(), out_v));
+		EXPECT_TRUE(out_v.empty());
+		std::string text;
+		EXPECT_TRUE(io::binary_to_text(oids::type::int4_array,
+				buffer.begin(), buffer.end(), text));
+		EXPECT_EQ("{}", text);
+	}
+}
+
+TEST(ArraySupport, BinaryToTextQuotes)
+{
+	using namespace tip::db::pg;
+	typedef std::vector< byte > buffer_type;
+
+	std::vector< boost::posix_time::ptime > in_v {
+		boost::posix_time::time_from_string("2016-03-24 12:34:56"),
+		boost::posix_time::time_from_string("1999-12-31 23:59:59.5")
+	}, out_v;
+	buffer_type buffer;
+	EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in_v));
+	std::string text;
+	EXPECT_TRUE(io::binary_to_text(oids::type::timestamp_array,
+			buffer.begin(), buffer.end(), text));
+	EXPECT_EQ(R"~({"2016-03-24 12:34:56","1999-12-31 23:59:59.5"})~", text);
+	io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), out_v);
+	EXPECT_EQ(in_v, out_v);
+}
+
+TEST(ArraySupport, AnyBinaryArrayParameter)
+{
+	using namespace tip::db::pg;
+	if (!test::environment::test_database.empty()) {
+		db_service::add_connection(test::environment::test_database);
+		connection_options opts = connection_options::parse(test::environment::test_database);
+
+		typedef std::vector< bigint > id_vector;
+
+		id_vector ids(10000);
+		for (std::size_t i = 0; i < ids.size(); ++i) {
+			ids[i] = i * 2;
+		}
+		resultset res;
+
+		db_service::begin(opts.alias,
+		[&](transaction_ptr tran) {
+			query(tran, "select count(*)::bigint, array_agg(g)::bigint[] "
+					"from generate_series(0, 100) g where g = any($1)", ids)(
+			[&res](transaction_ptr, resultset r, bool) {
+				res = r;
+				db_service::stop();
+			},
+			[](error::db_error const&) {
+				db_service::stop();
+			}
+			);
+		},
+		[](error::db_error const&) {
+			db_service::stop();
+		}
+		);
+		db_service::run();
+		ASSERT_FALSE(res.empty());
+		ASSERT_EQ(1, res.size());
+		bigint count{0};
+		id_vector found;
+		res.front().to(count, found);
+		EXPECT_EQ(51, count);
+		EXPECT_EQ(id_vector(ids.begin(), ids.begin() + 51), found);
+	}
+}
@@ -0,0 +1,399 @@
+/*
+ * binary_io_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <tip/db/pg.hpp>
+#include <tip/db/pg/query.hpp>
+#include <tip/db/pg/io/boost_date_time.hpp>
+#include <tip/db/pg/io/ip_address.hpp>
+#include <tip/db/pg/io/uuid.hpp>
+#include <tip/db/pg/detail/result_impl.hpp>
+
+#include <boost/uuid/string_generator.hpp>
+
+#include <limits>
+
+#include "db/config.hpp"
+#include "test-environment.hpp"
+
+using namespace tip::db::pg;
+using boost::posix_time::ptime;
+using boost::gregorian::date;
+using boost::posix_time::time_duration;
+using ip_address = ASIO_NAMESPACE::ip::address;
+
+namespace {
+
+template < typename T >
+T
+binary_roundtrip(T const& val, size_t expected_size)
+{
+    std::vector<byte> buffer;
+    EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, val));
+    EXPECT_EQ(expected_size, buffer.size());
+    T res;
+    auto c = io::protocol_read< BINARY_DATA_FORMAT >(buffer.cbegin(), buffer.cend(), res);
+    EXPECT_EQ(buffer.cend(), c) << "The whole buffer is consumed";
+    return res;
+}
+
+std::vector<byte>
+make_buffer(std::initializer_list<int> bytes)
+{
+    return std::vector<byte>(bytes.begin(), bytes.end());
+}
+
+/**
+ * Result set with a single binary field, as received for a prepared
+ * statement
+ */
+resultset
+make_binary_field(oids::type::oid_type oid, std::vector<byte> const& bytes)
+{
+    auto impl = std::make_shared< tip::db::pg::detail::result_impl >();
+    field_description fd{};
+    fd.name = "value";
+    fd.type_oid = oid;
+    fd.format_code = BINARY_DATA_FORMAT;
+    impl->row_description().push_back(fd);
+    tip::db::pg::detail::row_data row;
+    row.offsets.push_back(row.data.size());
+    row.data.insert(row.data.end(), bytes.begin(), bytes.end());
+    row.offsets.push_back(row.data.size());
+    impl->add_row(row);
+    return resultset{ impl };
+}
+
+}  /* namespace  */
+
+TEST(BinaryIOTest, FloatingPoint)
+{
+    EXPECT_EQ(3.1415926f, binary_roundtrip(3.1415926f, 4));
+    EXPECT_EQ(-0.5f, binary_roundtrip(-0.5f, 4));
+    EXPECT_EQ(std::numeric_limits<float>::max(),
+            binary_roundtrip(std::numeric_limits<float>::max(), 4));
+    EXPECT_EQ(3.141592653589793, binary_roundtrip(3.141592653589793, 8));
+    EXPECT_EQ(-1e300, binary_roundtrip(-1e300, 8));
+    EXPECT_EQ(std::numeric_limits<double>::infinity(),
+            binary_roundtrip(std::numeric_limits<double>::infinity(), 8));
+
+    // Network byte order
+    std::vector<byte> buffer;
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer, 1.0);
+    EXPECT_EQ(make_buffer({0x3f, 0xf0, 0, 0, 0, 0, 0, 0}), buffer);
+}
+
+TEST(BinaryIOTest, Bool)
+{
+    EXPECT_TRUE(binary_roundtrip(true, 1));
+    EXPECT_FALSE(binary_roundtrip(false, 1));
+}
+
+TEST(BinaryIOTest, Date)
+{
+    date d{2016, boost::gregorian::Mar, 24};
+    EXPECT_EQ(d, binary_roundtrip(d, 4));
+    d = date{1999, boost::gregorian::Dec, 31};
+    EXPECT_EQ(d, binary_roundtrip(d, 4));
+    d = date{boost::gregorian::pos_infin};
+    EXPECT_EQ(d, binary_roundtrip(d, 4));
+
+    std::vector<byte> buffer;
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer, date{2000, boost::gregorian::Jan, 2});
+    EXPECT_EQ(make_buffer({0, 0, 0, 1}), buffer);
+}
+
+TEST(BinaryIOTest, TimeDuration)
+{
+    time_duration td{18, 30, 15, 500000};
+    EXPECT_EQ(td, binary_roundtrip(td, 16));
+    td = -time_duration{36, 0, 0};
+    EXPECT_EQ(td, binary_roundtrip(td, 16));
+
+    // time value, only microseconds
+    std::vector<byte> buffer;
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer, time_duration{1, 0, 0}.total_microseconds());
+    time_duration res;
+    io::protocol_read< BINARY_DATA_FORMAT >(buffer.cbegin(), buffer.cend(), res);
+    EXPECT_EQ(time_duration(1, 0, 0), res);
+
+    // interval 1 day 00:00:01
+    buffer = make_buffer({0, 0, 0, 0, 0, 0x0f, 0x42, 0x40, 0, 0, 0, 1, 0, 0, 0, 0});
+    io::protocol_read< BINARY_DATA_FORMAT >(buffer.cbegin(), buffer.cend(), res);
+    EXPECT_EQ(time_duration(24, 0, 1), res);
+
+    // interval 1 mon 1 day 00:00:01, a month has no fixed length
+    buffer = make_buffer({0, 0, 0, 0, 0, 0x0f, 0x42, 0x40, 0, 0, 0, 1, 0, 0, 0, 1});
+    EXPECT_EQ(buffer.cbegin(),
+            io::protocol_read< BINARY_DATA_FORMAT >(buffer.cbegin(), buffer.cend(), res));
+    EXPECT_EQ(time_duration(24, 0, 1), res) << "The value is not changed";
+    std::string text{"1 mon 1 day 00:00:01"};
+    EXPECT_EQ(text.begin(),
+            io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), res));
+    text = "1 year";
+    EXPECT_EQ(text.begin(),
+            io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), res));
+    EXPECT_EQ(time_duration(24, 0, 1), res);
+
+    // Such intervals are read as text
+    resultset rs = make_binary_field(oids::type::interval, buffer);
+    EXPECT_EQ("1 mon 1 day 00:00:01", rs[0][0].as< std::string >());
+}
+
+TEST(BinaryIOTest, Timestamp)
+{
+    ptime ts{ date{2016, boost::gregorian::Mar, 24}, time_duration{18, 0, 0, 123} };
+    EXPECT_EQ(ts, binary_roundtrip(ts, 8));
+    ts = ptime{ boost::posix_time::neg_infin };
+    EXPECT_EQ(ts, binary_roundtrip(ts, 8));
+}
+
+TEST(BinaryIOTest, IPAddress)
+{
+    ip_address addr = ASIO_NAMESPACE::ip::address_v4{ {{192, 168, 0, 1}} };
+    EXPECT_EQ(addr, binary_roundtrip(addr, 8));
+    addr = ASIO_NAMESPACE::ip::address_v6::loopback();
+    EXPECT_EQ(addr, binary_roundtrip(addr, 20));
+
+    std::vector<byte> buffer;
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer,
+            ip_address{ ASIO_NAMESPACE::ip::address_v4{ {{10, 0, 0, 1}} } });
+    EXPECT_EQ(make_buffer({2, 32, 0, 4, 10, 0, 0, 1}), buffer);
+}
+
+TEST(BinaryIOTest, UUID)
+{
+    boost::uuids::uuid id = boost::uuids::string_generator{}(
+            "b1a7c6bb-2e96-4e5b-9a5b-1c9b7e7d3f00");
+    EXPECT_EQ(id, binary_roundtrip(id, 16));
+}
+
+class BinaryToTextTest : public ::testing::TestWithParam<
+        std::tuple< oids::type::oid_type, std::vector<byte>, std::string > > {
+public:
+    static ParamType
+    make_test_data(oids::type::oid_type oid, std::initializer_list<int> bytes,
+            std::string const& expected)
+    {
+        return std::make_tuple(oid, make_buffer(bytes), expected);
+    }
+};
+
+TEST_P(BinaryToTextTest, Convert)
+{
+    oids::type::oid_type oid;
+    std::vector<byte> buffer;
+    std::string expected;
+    std::tie(oid, buffer, expected) = GetParam();
+
+    std::string text;
+    EXPECT_TRUE(io::binary_to_text(oid, buffer.cbegin(), buffer.cend(), text));
+    EXPECT_EQ(expected, text);
+}
+
+INSTANTIATE_TEST_CASE_P(IOTest, BinaryToTextTest,
+    ::testing::Values(
+        BinaryToTextTest::make_test_data(oids::type::boolean, {1}, "t"),
+        BinaryToTextTest::make_test_data(oids::type::int2, {0xff, 0xfe}, "-2"),
+        BinaryToTextTest::make_test_data(oids::type::oid, {0xff, 0xff, 0xff, 0xff}, "4294967295"),
+        BinaryToTextTest::make_test_data(oids::type::tid, {0, 0, 0, 1, 0, 2}, "(1,2)"),
+        BinaryToTextTest::make_test_data(oids::type::float8,
+                {0x3f, 0xf8, 0, 0, 0, 0, 0, 0}, "1.5"),
+        BinaryToTextTest::make_test_data(oids::type::float4,
+                {0x7f, 0xc0, 0, 0}, "NaN"),
+        // -123.4500
+        BinaryToTextTest::make_test_data(oids::type::numeric,
+                {0, 2, 0, 0, 0x40, 0, 0, 4, 0, 123, 0x11, 0x94}, "-123.4500"),
+        // 10000.05
+        BinaryToTextTest::make_test_data(oids::type::numeric,
+                {0, 3, 0, 1, 0, 0, 0, 2, 0, 1, 0, 0, 0x01, 0xf4}, "10000.05"),
+        // 0.0001
+        BinaryToTextTest::make_test_data(oids::type::numeric,
+                {0, 1, 0xff, 0xff, 0, 0, 0, 4, 0, 1}, "0.0001"),
+        BinaryToTextTest::make_test_data(oids::type::date, {0, 0, 0x17, 0x27}, "2016-03-24"),
+        BinaryToTextTest::make_test_data(oids::type::date, {0xff, 0xff, 0xff, 0xff}, "1999-12-31"),
+        BinaryToTextTest::make_test_data(oids::type::date, {0x7f, 0xff, 0xff, 0xff}, "infinity"),
+        BinaryToTextTest::make_test_data(oids::type::time,
+                {0, 0, 0, 0x0f, 0x82, 0x97, 0xdc, 0xe0}, "18:30:15.5"),
+        BinaryToTextTest::make_test_data(oids::type::timestamp,
+                {0, 0, 0, 0, 0, 0, 0, 1}, "2000-01-01 00:00:00.000001"),
+        BinaryToTextTest::make_test_data(oids::type::timestamptz,
+                {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+                "1999-12-31 23:59:59.999999+00"),
+        BinaryToTextTest::make_test_data(oids::type::interval,
+                {0, 0, 0, 0x03, 0x6c, 0x8b, 0xc0, 0x80, 0, 0, 0, 3, 0, 0, 0, 14},
+                "1 year 2 mons 3 days 04:05:06"),
+        BinaryToTextTest::make_test_data(oids::type::interval,
+                {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, "00:00:00"),
+        BinaryToTextTest::make_test_data(oids::type::bytea, {0xde, 0xad}, "\\xdead"),
+        BinaryToTextTest::make_test_data(oids::type::inet, {2, 32, 0, 4, 10, 0, 0, 1}, "10.0.0.1"),
+        BinaryToTextTest::make_test_data(oids::type::cidr, {2, 8, 1, 4, 10, 0, 0, 0}, "10.0.0.0/8"),
+        BinaryToTextTest::make_test_data(oids::type::macaddr,
+                {0x08, 0x00, 0x2b, 0x01, 0x02, 0x03}, "08:00:2b:01:02:03"),
+        BinaryToTextTest::make_test_data(oids::type::jsonb, {1, '{', '}'}, "{}"),
+        BinaryToTextTest::make_test_data(oids::type::json, {'[', ']'}, "[]")
+    )
+);
+
+TEST(BinaryToTextTest, TextParsersAcceptOutput)
+{
+    std::vector<byte> buffer;
+    std::string text;
+
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer, 0.1);
+    ASSERT_TRUE(io::binary_to_text(oids::type::float8, buffer.cbegin(), buffer.cend(), text));
+    double dbl{0};
+    io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), dbl);
+    EXPECT_EQ(0.1, dbl);
+
+    buffer.clear();
+    date d{2016, boost::gregorian::Mar, 24};
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer, d);
+    ASSERT_TRUE(io::binary_to_text(oids::type::date, buffer.cbegin(), buffer.cend(), text));
+    date d_out;
+    io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), d_out);
+    EXPECT_EQ(d, d_out);
+
+    buffer = make_buffer({0, 0, 0, 0x03, 0x6c, 0x8b, 0xc0, 0x80, 0, 0, 0, 3, 0, 0, 0, 0});
+    ASSERT_TRUE(io::binary_to_text(oids::type::interval, buffer.cbegin(), buffer.cend(), text));
+    EXPECT_EQ("3 days 04:05:06", text);
+    time_duration bin_td, txt_td;
+    io::protocol_read< BINARY_DATA_FORMAT >(buffer.cbegin(), buffer.cend(), bin_td);
+    EXPECT_NE(text.begin(), io::protocol_read< TEXT_DATA_FORMAT >(text.begin(), text.end(), txt_td));
+    EXPECT_EQ(bin_td, txt_td);
+}
+
+TEST(BinaryIOTest, Json)
+{
+    EXPECT_TRUE(io::traits::has_binary_parser(oids::type::json));
+    EXPECT_TRUE(io::traits::has_binary_parser(oids::type::jsonb));
+
+    std::string doc{"{\"a\": [1, 2], \"b\": null}"};
+    std::vector<byte> buffer(doc.begin(), doc.end());
+    EXPECT_EQ(doc, make_binary_field(oids::type::json, buffer)[0][0].as< std::string >());
+
+    // jsonb is the text after a version byte
+    buffer.insert(buffer.begin(), 1);
+    EXPECT_EQ(doc, make_binary_field(oids::type::jsonb, buffer)[0][0].as< std::string >());
+    buffer[0] = 2;
+    EXPECT_THROW(make_binary_field(oids::type::jsonb, buffer)[0][0].as< std::string >(),
+            error::db_error);
+}
+
+TEST(BinaryIOTest, MacAddr)
+{
+    EXPECT_TRUE(io::traits::has_binary_parser(oids::type::macaddr));
+
+    std::vector<byte> buffer = make_buffer({0x08, 0x00, 0x2b, 0x01, 0x02, 0xff});
+    resultset res = make_binary_field(oids::type::macaddr, buffer);
+    bytea mac = res[0][0].as< bytea >();
+    EXPECT_EQ(buffer, static_cast< std::vector<byte> const& >(mac));
+    EXPECT_EQ("08:00:2b:01:02:ff", res[0][0].as< std::string >());
+
+    std::vector<byte> out;
+    io::protocol_write< BINARY_DATA_FORMAT >(out, mac);
+    EXPECT_EQ(buffer, out);
+}
+
+TEST(BinaryIOTest, Numeric)
+{
+    EXPECT_TRUE(io::traits::has_binary_parser(oids::type::numeric));
+
+    // -123.4500
+    resultset res = make_binary_field(oids::type::numeric,
+            make_buffer({0, 2, 0, 0, 0x40, 0, 0, 4, 0, 123, 0x11, 0x94}));
+    EXPECT_EQ("-123.4500", res[0][0].as< std::string >());
+    EXPECT_EQ(-123.45, res[0][0].as< double >());
+    // 12345678.9
+    res = make_binary_field(oids::type::numeric,
+            make_buffer({0, 3, 0, 1, 0, 0, 0, 1, 0x04, 0xd2, 0x16, 0x2e, 0x23, 0x28}));
+    EXPECT_EQ("12345678.9", res[0][0].as< std::string >());
+    EXPECT_EQ(12345678.9, res[0][0].as< double >());
+    // NaN
+    res = make_binary_field(oids::type::numeric,
+            make_buffer({0, 0, 0, 0, 0xc0, 0, 0, 0}));
+    EXPECT_EQ("NaN", res[0][0].as< std::string >());
+}
+
+TEST(BinaryIOTest, DBRoundtrip)
+{
+    if (!test::environment::test_database.empty()) {
+        db_service::initialize(1,
+            {
+                { "application_name", "test-pg-async"   },
+                { "client_encoding",  "UTF8"            },
+                { "TimeZone",         "UTC"             }
+            });
+        db_service::add_connection(test::environment::test_database);
+        connection_options opts = connection_options::parse(test::environment::test_database);
+
+        double dbl_val = 3.141592653589793;
+        date date_val{2016, boost::gregorian::Mar, 24};
+        time_duration td_val{36, 30, 0, 250000};
+        ip_address addr_val = ASIO_NAMESPACE::ip::address_v4{ {{192, 168, 0, 1}} };
+        std::string json_val{"[1, 2]"};
+        std::string mac_val{"08:00:2b:01:02:ff"};
+        std::string num_val{"-123.4500"};
+        resultset res;
+
+        db_service::begin(opts.alias,
+        [&](transaction_ptr tran) {
+            query(tran, "select $1::float8, $2::date, $3::interval, $4::inet, $5::bool, "
+                    "$6::json, $7::jsonb, $8::macaddr, $9::numeric",
+                    dbl_val, date_val, td_val, addr_val, true,
+                    json_val, json_val, mac_val, num_val)(
+            [&res](transaction_ptr, resultset r, bool){
+                res = r;
+            },
+            [](error::db_error const&) {
+            });
+            tran->commit_async([](){
+                db_service::stop();
+            });
+        },
+        [](error::db_error const&) {
+            db_service::stop();
+        });
+
+        db_service::run();
+
+        ASSERT_FALSE(res.empty());
+        ASSERT_EQ(1, res.size());
+        ASSERT_EQ(9, res.columns_size());
+
+        double dbl_out;
+        date date_out;
+        time_duration td_out;
+        ip_address addr_out;
+        bool bool_out;
+        res.front().to(dbl_out, date_out, td_out, addr_out, bool_out);
+        EXPECT_EQ(dbl_val, dbl_out);
+        EXPECT_EQ(date_val, date_out);
+        EXPECT_EQ(td_val, td_out);
+        EXPECT_EQ(addr_val, addr_out);
+        EXPECT_TRUE(bool_out);
+
+        // Binary values read into types without a binary parser
+        std::string str_out;
+        res.front()[1].to(str_out);
+        EXPECT_EQ("2016-03-24", str_out);
+        res.front()[3].to(str_out);
+        EXPECT_EQ("192.168.0.1", str_out);
+
+        std::string json_out, jsonb_out, mac_out, num_out;
+        res.front()[5].to(json_out);
+        res.front()[6].to(jsonb_out);
+        res.front()[7].to(mac_out);
+        res.front()[8].to(num_out);
+        EXPECT_EQ(json_val, json_out);
+        EXPECT_EQ(json_val, jsonb_out);
+        EXPECT_EQ(mac_val, mac_out);
+        EXPECT_EQ(num_val, num_out);
+        EXPECT_EQ(6, res.front()[7].as< bytea >().size());
+    }
+}
@@ -0,0 +1,221 @@
+/*
+ * buffer_pool_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <tip/db/pg/detail/buffer_pool.hpp>
+#include <tip/db/pg/detail/result_impl.hpp>
+#include <tip/db/pg/resultset.hpp>
+
+#include "mock_backend.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+/**
+ * Allocations made by the test thread while counting is on. Other threads,
+ * as the log writer or io threads, allocate at any time.
+ */
+std::atomic< std::size_t > allocation_count{0};
+thread_local bool count_allocations = false;
+
+}  // namespace
+
+void*
+operator new(std::size_t size)
+{
+    if (count_allocations)
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace test {
+
+namespace {
+
+/**
+ * Build a DataRow message with a text value, a binary int4 value and a null
+ */
+std::vector< byte >
+make_data_row(int row)
+{
+    backend_stream out;
+    out.data_row({ "row #" + std::to_string(row % 10),
+            wire_field::binary(integer{ row }), wire_field{} });
+    return out.bytes();
+}
+
+/**
+ * Read a result the way a connection does: every message is taken from
+ * the pool, parsed into a row reused for all results and copied to the
+ * result.
+ */
+void
+read_rows(detail::buffer_pool& pool, detail::result_impl& res,
+        std::vector< std::vector< byte > > const& messages)
+{
+    static detail::row_data row;
+    for (auto const& bytes : messages) {
+        detail::message_ptr m = pool.acquire_message();
+        std::copy(bytes.begin(), bytes.end(), m->output());
+        m->reset_read();
+        row.clear();
+        ASSERT_TRUE(m->read(row));
+        res.add_row(row);
+        pool.release_message(std::move(m));
+    }
+}
+
+}  // namespace
+
+TEST(BufferPoolTest, SteadyStateIsAllocationFree)
+{
+    const int row_count = 1000;
+    std::vector< std::vector< byte > > messages;
+    for (int i = 0; i < row_count; ++i)
+        messages.push_back(make_data_row(i));
+
+    auto pool = std::make_shared< detail::buffer_pool >();
+    // Warm up the pool: the first results allocate the arena
+    for (int i = 0; i < 3; ++i) {
+        detail::result_impl res(pool);
+        read_rows(*pool, res, messages);
+        ASSERT_EQ(row_count, res.size());
+    }
+    EXPECT_EQ(1, pool->pooled_arenas());
+    EXPECT_LT(0, pool->pooled_bytes());
+
+    for (int i = 0; i < 3; ++i) {
+        detail::result_impl res(pool);
+        std::size_t before = allocation_count.load();
+        count_allocations = true;
+        read_rows(*pool, res, messages);
+        count_allocations = false;
+        EXPECT_EQ(before, allocation_count.load())
+            << "Reading rows into a result allocated memory";
+        ASSERT_EQ(row_count, res.size());
+        EXPECT_FALSE(res.is_null(row_count - 1, 0));
+        EXPECT_TRUE(res.is_null(row_count - 1, 2));
+    }
+}
+
+TEST(BufferPoolTest, ArenaReturnedOnResultsetRelease)
+{
+    std::vector< std::vector< byte > > messages;
+    for (int i = 0; i < 10; ++i)
+        messages.push_back(make_data_row(i));
+
+    auto pool = std::make_shared< detail::buffer_pool >();
+    auto impl = std::make_shared< detail::result_impl >(pool);
+    impl->row_description().resize(3);
+    impl->row_description()[1].type_oid = oids::type::int4;
+    impl->row_description()[1].format_code = BINARY_DATA_FORMAT;
+    read_rows(*pool, *impl, messages);
+    {
+        resultset res{ impl };
+        impl.reset();
+        EXPECT_EQ(0, pool->pooled_arenas());
+        EXPECT_EQ(7, res[7][1].as< integer >());
+    }
+    EXPECT_EQ(1, pool->pooled_arenas());
+
+    // The pool is bounded
+    auto small_pool = std::make_shared< detail::buffer_pool >(16);
+    {
+        detail::result_impl res(small_pool);
+        read_rows(*small_pool, res, messages);
+    }
+    EXPECT_EQ(0, small_pool->pooled_arenas());
+
+    // Results outliving the pool free their rows
+    impl = std::make_shared< detail::result_impl >(pool);
+    read_rows(*pool, *impl, messages);
+    pool.reset();
+    impl.reset();
+}
+
+TEST(RowArenaTest, Chunks)
+{
+    detail::row_arena arena;
+    detail::row_data row;
+    // Rows don't fit into a single chunk
+    const int row_count = 2000;
+    for (int i = 0; i < row_count; ++i) {
+        row.clear();
+        std::string text = "row #" + std::to_string(i);
+        row.offsets.push_back(row.data.size());
+        row.data.insert(row.data.end(), text.begin(), text.end());
+        row.offsets.push_back(row.data.size());
+        row.null_map.push_back(1);
+        row.offsets.push_back(row.data.size());
+        io::protocol_write< BINARY_DATA_FORMAT >(row.data, integer{ i });
+        arena.push_back(row);
+    }
+    // A row larger than a chunk
+    row.clear();
+    row.offsets.push_back(0);
+    row.data.resize(detail::row_arena::max_chunk_size * 2, 'x');
+    arena.push_back(row);
+
+    ASSERT_EQ(row_count + 1, arena.size());
+    EXPECT_LT(1, arena.chunks());
+    auto first = arena.field_buffer_bounds(0, 0);
+    for (int i = 0; i < row_count; ++i) {
+        ASSERT_EQ(3, arena.row_size(i));
+        auto b = arena.field_buffer_bounds(i, 0);
+        EXPECT_EQ("row #" + std::to_string(i), std::string(b.first, b.second));
+        EXPECT_FALSE(arena.is_null(i, 0));
+        EXPECT_TRUE(arena.is_null(i, 1));
+        b = arena.field_buffer_bounds(i, 1);
+        EXPECT_EQ(b.first, b.second);
+        integer val{0};
+        b = arena.field_buffer_bounds(i, 2);
+        io::protocol_read< BINARY_DATA_FORMAT >(b.first, b.second, val);
+        EXPECT_EQ(i, val);
+    }
+    // Data didn't move while the arena grew
+    EXPECT_EQ(first, arena.field_buffer_bounds(0, 0));
+    auto b = arena.field_buffer_bounds(row_count, 0);
+    EXPECT_EQ(detail::row_arena::max_chunk_size * 2, b.second - b.first);
+    EXPECT_THROW(arena.row_size(row_count + 1), std::out_of_range);
+    EXPECT_THROW(arena.is_null(0, 3), std::out_of_range);
+
+    std::size_t capacity = arena.capacity();
+    std::size_t chunks = arena.chunks();
+    arena.clear();
+    EXPECT_TRUE(arena.empty());
+    EXPECT_EQ(capacity, arena.capacity());
+    EXPECT_EQ(chunks, arena.chunks());
+    arena.shrink(detail::row_arena::max_chunk_size);
+    EXPECT_GE(detail::row_arena::max_chunk_size, arena.capacity());
+    EXPECT_GT(chunks, arena.chunks());
+}
+
+} /* namespace test */
+} /* namespace pg */
+} /* namespace db */
+} /* namespace tip */
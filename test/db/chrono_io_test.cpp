@@ -0,0 +1,175 @@
+/*
+ * chrono_io_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <tip/db/pg.hpp>
+#include <tip/db/pg/query.hpp>
+#include <tip/db/pg/io/std_chrono.hpp>
+
+#include "db/config.hpp"
+#include "test-environment.hpp"
+
+using namespace tip::db::pg;
+using std::chrono::system_clock;
+
+namespace {
+
+typedef std::vector< byte > buffer_type;
+
+system_clock::time_point
+make_time_point(std::int64_t unix_usecs)
+{
+    return system_clock::time_point{ std::chrono::duration_cast< system_clock::duration >(
+            std::chrono::microseconds{ unix_usecs }) };
+}
+
+}  // namespace
+
+static_assert(io::traits::best_formatter< system_clock::time_point >::value
+        == BINARY_DATA_FORMAT, "Best formatter for time_point is binary");
+static_assert(io::traits::best_parser< system_clock::time_point >::value
+        == BINARY_DATA_FORMAT, "Best parser for time_point is binary");
+static_assert(io::traits::cpppg_data_mapping< system_clock::time_point >::type_oid
+        == oids::type::timestamptz, "time_point is mapped to timestamptz");
+static_assert(io::traits::cpppg_data_mapping< std::chrono::seconds >::type_oid
+        == oids::type::interval, "duration is mapped to interval");
+
+TEST(ChronoIOTest, TimePointBinary)
+{
+    // 2000-01-01 00:00:01.5 UTC
+    auto tp = make_time_point(946684801500000LL);
+    buffer_type buffer;
+    EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, tp));
+    EXPECT_EQ((buffer_type{ 0, 0, 0, 0, 0, 0x16, (char)0xe3, 0x60 }), buffer);
+
+    system_clock::time_point out;
+    EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+            buffer.begin(), buffer.end(), out));
+    EXPECT_EQ(tp, out);
+
+    buffer.clear();
+    io::protocol_write< BINARY_DATA_FORMAT >(buffer, system_clock::time_point::max());
+    io::protocol_read< BINARY_DATA_FORMAT >(buffer.begin(), buffer.end(), out);
+    EXPECT_EQ(system_clock::time_point::max(), out);
+}
+
+TEST(ChronoIOTest, TimePointText)
+{
+    system_clock::time_point out;
+    std::string literal{ "2016-03-24 18:00:00.25+03" };
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), out));
+    // 2016-03-24 15:00:00.25 UTC
+    EXPECT_EQ(make_time_point(1458831600250000LL), out);
+
+    literal = "2016-03-24 15:00:00.25";
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), out));
+    EXPECT_EQ(make_time_point(1458831600250000LL), out);
+
+    literal = "-infinity";
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), out));
+    EXPECT_EQ(system_clock::time_point::min(), out);
+
+    literal = "garbage";
+    EXPECT_EQ(literal.begin(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), out));
+}
+
+TEST(ChronoIOTest, DurationBinary)
+{
+    std::chrono::milliseconds in{ 90061001 }; // 1 day 01:01:01.001
+    buffer_type buffer;
+    EXPECT_TRUE(io::protocol_write< BINARY_DATA_FORMAT >(buffer, in));
+    EXPECT_EQ(16, buffer.size());
+    std::chrono::milliseconds out;
+    EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+            buffer.begin(), buffer.end(), out));
+    EXPECT_EQ(in, out);
+
+    // interval '2 days 00:00:01'
+    buffer = buffer_type{
+        0, 0, 0, 0, 0, 0x0f, 0x42, 0x40,
+        0, 0, 0, 2,
+        0, 0, 0, 0
+    };
+    std::chrono::seconds secs;
+    EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+            buffer.begin(), buffer.end(), secs));
+    EXPECT_EQ(std::chrono::seconds{ 2 * 86400 + 1 }, secs);
+
+    // interval '1 mon 2 days 00:00:01', a month has no fixed length
+    buffer.back() = 1;
+    EXPECT_EQ(buffer.begin(), io::protocol_read< BINARY_DATA_FORMAT >(
+            buffer.begin(), buffer.end(), secs));
+    EXPECT_EQ(std::chrono::seconds{ 2 * 86400 + 1 }, secs);
+
+    // timetz '12:00:00+03'
+    buffer = buffer_type{
+        0, 0, 0, 0x0a, 0x0e, (char)0xeb, (char)0xb0, 0x00,
+        (char)0xff, (char)0xff, (char)0xd5, (char)0xd0
+    };
+    EXPECT_EQ(buffer.end(), io::protocol_read< BINARY_DATA_FORMAT >(
+            buffer.begin(), buffer.end(), secs));
+    EXPECT_EQ(std::chrono::hours{ 12 }, secs);
+    std::string text;
+    EXPECT_TRUE(io::binary_to_text(oids::type::timetz, buffer.begin(), buffer.end(), text));
+    EXPECT_EQ("12:00:00+03", text);
+}
+
+TEST(ChronoIOTest, DurationText)
+{
+    std::chrono::seconds out;
+    std::string literal{ "1 day 02:00:00" };
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), out));
+    EXPECT_EQ(std::chrono::hours{ 26 }, out);
+
+    literal = "12:00:00+03";
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), out));
+    EXPECT_EQ(std::chrono::hours{ 12 }, out);
+}
+
+TEST(ChronoIOTest, DBRoundtrip)
+{
+    if (!test::environment::test_database.empty()) {
+        db_service::add_connection(test::environment::test_database);
+        connection_options opts = connection_options::parse(test::environment::test_database);
+
+        auto tp = make_time_point(1458831600250000LL);
+        std::chrono::microseconds dur{ 3723000004LL };
+        resultset res;
+
+        db_service::begin(opts.alias,
+        [&](transaction_ptr tran) {
+            query(tran, "select $1::timestamptz, $2::interval, '12:00:00+03'::timetz",
+                    tp, dur)(
+            [&res](transaction_ptr, resultset r, bool) {
+                res = r;
+                db_service::stop();
+            },
+            [](error::db_error const&) {
+                db_service::stop();
+            });
+        },
+        [](error::db_error const&) {
+            db_service::stop();
+        });
+        db_service::run();
+
+        ASSERT_FALSE(res.empty());
+        system_clock::time_point out_tp;
+        std::chrono::microseconds out_dur, out_time;
+        res.front().to(out_tp, out_dur, out_time);
+        EXPECT_EQ(tp, out_tp);
+        EXPECT_EQ(dur, out_dur);
+        EXPECT_EQ(std::chrono::hours{ 12 }, out_time);
+    }
+}
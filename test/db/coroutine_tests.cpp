@@ -0,0 +1,189 @@
+/*
+ * coroutine_tests.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <tip/db/pg.hpp>
+#include <tip/db/pg/coroutine.hpp>
+
+#include <tip/db/pg/log.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "db/config.hpp"
+#include "test-environment.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+LOCAL_LOGGING_FACILITY(PGTEST, TRACE);
+
+using namespace tip::db::pg;
+
+namespace {
+
+/**
+ * Fire and forget coroutine for running the tests
+ */
+struct task {
+    struct promise_type {
+        task
+        get_return_object()
+        { return {}; }
+        std::suspend_never
+        initial_suspend() noexcept
+        { return {}; }
+        std::suspend_never
+        final_suspend() noexcept
+        { return {}; }
+        void
+        return_void() {}
+        void
+        unhandled_exception()
+        { std::terminate(); }
+    };
+};
+
+}  // namespace
+
+TEST(CoroutineTest, BeginUnknownAlias)
+{
+    bool caught = false;
+    auto coro = [&]() -> task {
+        try {
+            co_await async_begin("no_such_alias"_db);
+        } catch (error::connection_error const&) {
+            caught = true;
+        }
+    };
+    coro();
+    EXPECT_TRUE(caught);
+}
+
+TEST(CoroutineTest, QueryUnknownAlias)
+{
+    bool caught = false;
+    auto coro = [&]() -> task {
+        try {
+            co_await query("no_such_alias"_db, "select 1");
+        } catch (error::connection_error const&) {
+            caught = true;
+        }
+    };
+    coro();
+    EXPECT_TRUE(caught);
+}
+
+namespace {
+
+/**
+ * Awaiter handing the operation callbacks over to the test
+ */
+class manual_awaiter : public tip::db::pg::detail::operation_awaiter< int > {
+public:
+    using value_callback = std::function< void(int) >;
+
+    manual_awaiter(value_callback& value, error_callback& error)
+        : value_{value}, error_{error} {}
+
+    void
+    await_suspend(std::coroutine_handle<> h)
+    {
+        auto state = suspend(h);
+        value_ = [state](int v) { state->set_value(v); };
+        error_ = [state](error::db_error const& e) { state->set_error(e); };
+    }
+private:
+    value_callback& value_;
+    error_callback& error_;
+};
+
+}  // namespace
+
+TEST(CoroutineTest, ResumeOnce)
+{
+    manual_awaiter::value_callback on_value;
+    error_callback on_error;
+    int resumed = 0;
+    int result = 0;
+    auto coro = [&]() -> task {
+        try {
+            result = co_await manual_awaiter{ on_value, on_error };
+        } catch (error::db_error const&) {
+            result = -1;
+        }
+        ++resumed;
+    };
+
+    coro();
+    EXPECT_EQ(0, resumed);
+    // The coroutine finishes and its frame is destroyed in the first call
+    on_value(1);
+    on_value(2);
+    on_error(error::query_error("Late error"));
+    EXPECT_EQ(1, resumed);
+    EXPECT_EQ(1, result);
+
+    resumed = 0;
+    coro();
+    on_error(error::query_error("Query failed"));
+    on_value(1);
+    EXPECT_EQ(1, resumed);
+    EXPECT_EQ(-1, result);
+}
+
+TEST(CoroutineTest, Transaction)
+{
+    if (!test::environment::test_database.empty()) {
+        ASSERT_NO_THROW(db_service::add_connection(test::environment::test_database));
+        connection_options opts = connection_options::parse(test::environment::test_database);
+
+        bool finished = false;
+        auto coro = [&]() -> task {
+            try {
+                transaction_ptr tran = co_await async_begin(opts.alias);
+                EXPECT_TRUE(tran.get());
+                resultset res = co_await query(tran,
+                        "select $1::integer as num", 42);
+                EXPECT_EQ(1, res.size());
+                EXPECT_EQ(42, res[0][0].as< integer >());
+
+                res = co_await query(tran,
+                        "select * from generate_series(1, 1000)");
+                EXPECT_EQ(1000, res.size());
+
+                co_await async_commit(tran);
+
+                // The transaction is rolled back after a query error
+                tran = co_await async_begin(opts.alias);
+                bool query_failed = false;
+                try {
+                    co_await query(tran, "select * from _shouldnt_be_there_");
+                } catch (error::db_error const&) {
+                    query_failed = true;
+                }
+                EXPECT_TRUE(query_failed);
+                bool commit_failed = false;
+                try {
+                    co_await async_commit(tran);
+                } catch (error::db_error const&) {
+                    commit_failed = true;
+                }
+                EXPECT_TRUE(commit_failed);
+                co_await async_rollback(tran);
+                finished = true;
+            } catch (error::db_error const& e) {
+                ADD_FAILURE() << "Exception in coroutine " << e.what();
+            }
+            db_service::stop();
+        };
+        coro();
+        db_service::run();
+        EXPECT_TRUE(finished);
+    }
+}
+
+#endif /* __cpp_impl_coroutine */
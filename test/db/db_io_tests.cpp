@@ -7,11 +7,17 @@
 
 #include <tip/db/pg/protocol_io_traits.hpp>
 #include <tip/db/pg/query.hpp>
+#include <tip/db/pg/io/bytea.hpp>
 
 #include <tip/db/pg/log.hpp>
 
 #include <gtest/gtest.h>
 
+#include <clocale>
+#include <cmath>
+#include <limits>
+#include <string>
+
 using namespace tip::db::pg;
 
 
@@ -71,6 +77,160 @@ INSTANTIATE_TEST_CASE_P(
 		::testing::Values("foo", "bar", "trololo")
 );
 
+static_assert(std::is_same< io::protocol_parser< bigint, TEXT_DATA_FORMAT >::parser_base,
+		io::detail::text_data_parser< bigint, io::INTEGRAL > >::value,
+		"Integral text parser is selected for bigint");
+static_assert(std::is_same< io::protocol_parser< double, TEXT_DATA_FORMAT >::parser_base,
+		io::detail::text_data_parser< double, io::FLOATING_POINT > >::value,
+		"Floating point text parser is selected for double");
+static_assert(std::is_same< io::protocol_parser< char, TEXT_DATA_FORMAT >::parser_base,
+		io::detail::text_data_parser< char, io::OTHER > >::value,
+		"Characters are parsed with input operator");
+
+template < typename T >
+struct NumericTextParseParam {
+	std::string literal;
+	T expected;
+	std::size_t consumed;
+};
+
+class IntegerTextParseTest :
+		public ::testing::TestWithParam< NumericTextParseParam< bigint > > {
+};
+
+TEST_P(IntegerTextParseTest, Parses)
+{
+	ParamType param = GetParam();
+	bigint val{-1};
+	auto res = io::protocol_read< TEXT_DATA_FORMAT >(param.literal.begin(),
+			param.literal.end(), val);
+	EXPECT_EQ(param.consumed, res - param.literal.begin());
+	if (param.consumed)
+		EXPECT_EQ(param.expected, val);
+	else
+		EXPECT_EQ(-1, val) << "Value is not modified on failure";
+}
+
+INSTANTIATE_TEST_CASE_P(IOTest,
+		IntegerTextParseTest,
+		::testing::Values(
+			NumericTextParseParam< bigint >{ "0", 0, 1 },
+			NumericTextParseParam< bigint >{ "42", 42, 2 },
+			NumericTextParseParam< bigint >{ "+42", 42, 3 },
+			NumericTextParseParam< bigint >{ "-42", -42, 3 },
+			NumericTextParseParam< bigint >{ "9223372036854775807",
+				std::numeric_limits< bigint >::max(), 19 },
+			NumericTextParseParam< bigint >{ "-9223372036854775808",
+				std::numeric_limits< bigint >::min(), 20 },
+			NumericTextParseParam< bigint >{ "123,456", 123, 3 },
+			NumericTextParseParam< bigint >{ "9223372036854775808", 0, 0 },
+			NumericTextParseParam< bigint >{ "-", 0, 0 },
+			NumericTextParseParam< bigint >{ "", 0, 0 },
+			NumericTextParseParam< bigint >{ "foo", 0, 0 }
+));
+
+class DoubleTextParseTest :
+		public ::testing::TestWithParam< NumericTextParseParam< double > > {
+};
+
+TEST_P(DoubleTextParseTest, Parses)
+{
+	ParamType param = GetParam();
+	double val{-1};
+	auto res = io::protocol_read< TEXT_DATA_FORMAT >(param.literal.begin(),
+			param.literal.end(), val);
+	EXPECT_EQ(param.consumed, res - param.literal.begin());
+	if (!param.consumed)
+		EXPECT_EQ(-1, val) << "Value is not modified on failure";
+	else if (std::isnan(param.expected))
+		EXPECT_TRUE(std::isnan(val));
+	else
+		EXPECT_EQ(param.expected, val);
+}
+
+INSTANTIATE_TEST_CASE_P(IOTest,
+		DoubleTextParseTest,
+		::testing::Values(
+			NumericTextParseParam< double >{ "0", 0, 1 },
+			NumericTextParseParam< double >{ "3.14159", 3.14159, 7 },
+			NumericTextParseParam< double >{ "-1.5e-10", -1.5e-10, 8 },
+			NumericTextParseParam< double >{ "1e+300", 1e300, 6 },
+			NumericTextParseParam< double >{ "0.30000000000000004",
+				0.30000000000000004, 19 },
+			NumericTextParseParam< double >{ "Infinity",
+				std::numeric_limits< double >::infinity(), 8 },
+			NumericTextParseParam< double >{ "-Infinity",
+				-std::numeric_limits< double >::infinity(), 9 },
+			NumericTextParseParam< double >{ "NaN",
+				std::numeric_limits< double >::quiet_NaN(), 3 },
+			NumericTextParseParam< double >{ "2.5,3", 2.5, 3 },
+			NumericTextParseParam< double >{ "", 0, 0 },
+			NumericTextParseParam< double >{ "bar", 0, 0 }
+));
+
+TEST(IOTest, DoubleTextParseCommaLocale)
+{
+	char const* const comma_locales[] = {
+		"de_DE.UTF-8", "de_DE.utf8", "de_DE", "ru_RU.UTF-8", "ru_RU.utf8",
+		"fr_FR.UTF-8", "fr_FR.utf8"
+	};
+	std::string saved{ std::setlocale(LC_NUMERIC, nullptr) };
+	char const* name = nullptr;
+	for (auto l : comma_locales) {
+		if (std::setlocale(LC_NUMERIC, l) &&
+				std::localeconv()->decimal_point[0] == ',') {
+			name = l;
+			break;
+		}
+	}
+	if (!name) {
+		std::setlocale(LC_NUMERIC, saved.c_str());
+		GTEST_SKIP() << "No comma decimal point locale installed";
+	}
+
+	std::string literal{ "1.5" };
+	double dbl{0};
+	auto res = io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), dbl);
+	float flt{0};
+	auto fres = io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), flt);
+	std::setlocale(LC_NUMERIC, saved.c_str());
+
+	EXPECT_EQ(literal.end(), res) << "Locale " << name;
+	EXPECT_EQ(1.5, dbl) << "Locale " << name;
+	EXPECT_EQ(literal.end(), fres) << "Locale " << name;
+	EXPECT_EQ(1.5f, flt) << "Locale " << name;
+}
+
+TEST(IOTest, SmallIntegralTextParse)
+{
+	std::string literal{ "32767" };
+	smallint s{0};
+	EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), s));
+	EXPECT_EQ(32767, s);
+	literal = "32768";
+	EXPECT_EQ(literal.begin(), io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), s));
+	EXPECT_EQ(32767, s);
+
+	literal = "4294967295";
+	uinteger u{0};
+	EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), u));
+	EXPECT_EQ(4294967295u, u);
+	literal = "-1";
+	EXPECT_EQ(literal.begin(), io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), u));
+
+	literal = "2.5";
+	float f{0};
+	EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), f));
+	EXPECT_EQ(2.5f, f);
+}
+
 class ByteaTextParseTest :
 		public ::testing::TestWithParam< std::pair< std::string, size_t > > {
 public:
@@ -121,6 +281,42 @@ INSTANTIATE_TEST_CASE_P(IOTest,
 			""
 ));
 
+TEST(IOTest, ByteaTextParseContents)
+{
+	std::string literal{ "\\x00017f80Ff1234aBcDeF" };
+	bytea val;
+	EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+			literal.begin(), literal.end(), val));
+	EXPECT_EQ((bytea{ 0x00, 0x01, 0x7f, (char)0x80, (char)0xff, 0x12, 0x34,
+		(char)0xab, (char)0xcd, (char)0xef }), val);
+
+	// Lengths around the vectorized block sizes
+	static char const HEX[] = "0123456789abcdef";
+	for (std::size_t sz : { 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000 }) {
+		bytea expected;
+		std::string hex{ "\\x" };
+		for (std::size_t i = 0; i < sz; ++i) {
+			unsigned char b = (i * 37 + 11) & 0xff;
+			expected.push_back(b);
+			hex.push_back(HEX[b >> 4]);
+			hex.push_back(HEX[b & 0x0f]);
+		}
+		EXPECT_EQ(hex.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+				hex.begin(), hex.end(), val)) << "Size " << sz;
+		EXPECT_EQ(expected, val) << "Size " << sz;
+		// Invalid character in every position
+		for (std::size_t pos = 2; pos < hex.size(); pos += 7) {
+			std::string invalid = hex;
+			invalid[pos] = (pos % 3) ? 'g' : (char)0xc0;
+			bytea untouched{ 1, 2, 3 };
+			EXPECT_EQ(invalid.begin(), io::protocol_read< TEXT_DATA_FORMAT >(
+					invalid.begin(), invalid.end(), untouched))
+					<< "Size " << sz << " position " << pos;
+			EXPECT_EQ(3, untouched.size());
+		}
+	}
+}
+
 class QueryParamsWriteTest : public ::testing::TestWithParam< std::tuple<
 		std::vector< oids::type::oid_type >,
 		std::vector< char >,
@@ -19,6 +19,31 @@
 LOCAL_LOGGING_FACILITY(PGTEST, TRACE);
 using namespace tip::db::pg;
 
+TEST(SqlStateTest, Lookup)
+{
+    EXPECT_EQ(sqlstate::successful_completion, sqlstate::code_to_state("00000"));
+    EXPECT_EQ(sqlstate::unique_violation, sqlstate::code_to_state("23505"));
+    EXPECT_EQ(sqlstate::index_corrupted, sqlstate::code_to_state("XX002"));
+    // Several strings for a code
+    EXPECT_EQ(sqlstate::string_data_right_truncation, sqlstate::code_to_state("01004"));
+    EXPECT_EQ(sqlstate::string_data_right_truncation, sqlstate::code_to_state("22001"));
+
+    EXPECT_EQ(sqlstate::unknown_code, sqlstate::code_to_state(""));
+    EXPECT_EQ(sqlstate::unknown_code, sqlstate::code_to_state("2350"));
+    EXPECT_EQ(sqlstate::unknown_code, sqlstate::code_to_state("235055"));
+    EXPECT_EQ(sqlstate::unknown_code, sqlstate::code_to_state("23x05"));
+    EXPECT_EQ(sqlstate::unknown_code, sqlstate::code_to_state("ZZZZZ"));
+
+    EXPECT_STREQ("23505", sqlstate::state_to_code(sqlstate::unique_violation));
+    EXPECT_STREQ("01004", sqlstate::state_to_code(sqlstate::string_data_right_truncation));
+    EXPECT_STREQ("", sqlstate::state_to_code(sqlstate::unknown_code));
+    for (int c = sqlstate::successful_completion; c <= sqlstate::index_corrupted; ++c) {
+        sqlstate::code state = static_cast< sqlstate::code >(c);
+        EXPECT_EQ(state, sqlstate::code_to_state(sqlstate::state_to_code(state)))
+            << sqlstate::state_to_code(state);
+    }
+}
+
 TEST(ErrorTest, InvalidQueryError)
 {
     if (!test::environment::test_database.empty()) {
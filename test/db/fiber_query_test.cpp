@@ -13,10 +13,16 @@
 
 #include <tip/db/pg.hpp>
 #include <tip/db/pg/log.hpp>
+#include <tip/db/pg/detail/basic_connection.hpp>
 
 #include <pushkin/asio/fiber/shared_work.hpp>
 #include <boost/fiber/all.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
 #include "db/config.hpp"
 #include "test-environment.hpp"
 
@@ -90,6 +96,195 @@ TEST(FiberTest, DISABLED_TheOnly)
     }
 }
 
+TEST(FiberTest, WaitResumedFromIoThread)
+{
+    auto svc = ::std::make_shared< asio_config::io_service >();
+    ::std::thread io_thread;
+    int value{0};
+    bool caught{false};
+    {
+        auto runner = ::psst::asio::fiber::use_shared_work_algorithm( svc );
+        fiber{
+            [&]()
+            {
+                {
+                    detail::fiber_wait< int > waiter{ fiber_yield{} };
+                    auto w = waiter.handle();
+                    io_thread = ::std::thread{ [w]()
+                    {
+                        ::std::this_thread::sleep_for(::std::chrono::milliseconds(10));
+                        w.set_value(42);
+                    } };
+                    value = waiter.get();
+                }
+                {
+                    detail::fiber_wait< void > waiter{ fiber_yield{} };
+                    auto w = waiter.handle();
+                    svc->post([w](){
+                        w.set_error(error::connection_error{"Test error"});
+                    });
+                    try {
+                        waiter.get();
+                    } catch (error::db_error const&) {
+                        caught = true;
+                    }
+                }
+                svc->stop();
+            }
+        }.detach();
+        runner->run();
+    }
+    io_thread.join();
+    EXPECT_EQ(42, value);
+    EXPECT_TRUE(caught);
+}
+
+TEST(FiberTest, WaitResumedOnce)
+{
+    ::std::function< void(int) > late;
+    int value{0};
+    {
+        detail::fiber_wait< int > waiter{ fiber_yield{} };
+        auto w = waiter.handle();
+        w.set_value(42);
+        w.set_value(100500);
+        w.set_error(error::query_error{"Late error"});
+        late = [w](int v) { w.set_value(v); };
+        EXPECT_NO_THROW(value = waiter.get());
+    }
+    // The waiter is gone, the call must not reach it
+    late(100500);
+    EXPECT_EQ(42, value);
+}
+
+namespace {
+
+/**
+ * Connection failing to commit, the rest of operations do nothing
+ */
+class commit_error_connection : public basic_connection {
+    void
+    do_connect(connection_options const&) override {}
+    dbalias const&
+    get_alias() const override
+    { return alias_; }
+    bool
+    is_in_transaction() const override
+    { return true; }
+    void
+    do_begin(events::begin&&) override {}
+    void
+    do_commit(notification_callback, error_callback ecb) override
+    {
+        if (ecb)
+            ecb(error::query_error{"Commit failed"});
+    }
+    void
+    do_rollback(notification_callback cb, error_callback) override
+    {
+        if (cb)
+            cb();
+    }
+    void
+    do_execute(events::execute&&) override {}
+    void
+    do_execute(events::execute_prepared&&) override {}
+    void
+    do_terminate() override {}
+
+    dbalias alias_{"test"};
+};
+
+}  // namespace
+
+TEST(FiberTest, YieldCommitError)
+{
+    auto trx = ::std::make_shared< transaction >(
+            ::std::make_shared< commit_error_connection >());
+    try {
+        trx->commit(fiber_yield{});
+        ADD_FAILURE() << "Commit didn't throw";
+    } catch (error::db_error const& e) {
+        EXPECT_EQ(::std::string{"Commit failed"}, e.what());
+    }
+    // The transaction is finished by the failed commit
+    try {
+        trx->commit(fiber_yield{});
+        ADD_FAILURE() << "Commit of a finished transaction didn't throw";
+    } catch (error::db_error const& e) {
+        EXPECT_EQ(::std::string{ error::transaction_closed{}.what() }, e.what());
+    }
+    EXPECT_NO_THROW(trx->rollback(fiber_yield{}));
+}
+
+TEST(FiberTest, YieldUnknownAlias)
+{
+    EXPECT_THROW(db_service::begin("no_such_alias"_db, fiber_yield{}),
+            error::connection_error);
+    EXPECT_THROW(query("no_such_alias"_db, "select 1")(fiber_yield{}),
+            error::connection_error);
+}
+
+/**
+ * Same as the test above, but the fibers are suspended via yield handler
+ * instead of promises. Scale with -q (fibers per thread) and -x (threads)
+ */
+TEST(FiberTest, YieldTransactions)
+{
+    if (!environment::test_database.empty()) {
+        ASSERT_NO_THROW(db_service::add_connection(environment::test_database,
+                            environment::connection_pool));
+        connection_options opts = connection_options::parse(environment::test_database);
+
+        const auto fiber_cnt    = environment::num_requests;
+        const auto thread_cnt   = environment::num_threads;
+        ::std::atomic<int> committed{0};
+
+        auto fib_fn = [&](boost::fibers::barrier& barrier) {
+            try {
+                auto trx = db_service::begin(opts.alias, fiber_yield{});
+                EXPECT_TRUE(trx.get());
+
+                auto res = query(trx, "select $1::integer as num", 42)(fiber_yield{});
+                EXPECT_EQ(1, res.size());
+                EXPECT_EQ(42, res[0][0].as< integer >());
+
+                trx->commit(fiber_yield{});
+                ++committed;
+            } catch (::std::exception const& e) {
+                local_log(logger::ERROR) << "Exception while running test " << e.what();
+            }
+
+            if (barrier.wait()) {
+                db_service::stop();
+            }
+        };
+
+        auto start = ::std::chrono::steady_clock::now();
+        ::std::vector< ::std::thread > threads;
+        threads.reserve(thread_cnt);
+        boost::fibers::barrier b(fiber_cnt * thread_cnt);
+
+        for(auto i = 0; i < thread_cnt; ++i) {
+            threads.emplace_back([&](){
+                auto runner = ::psst::asio::fiber::use_shared_work_algorithm( db_service::io_service() );
+                for (auto i = 0; i < fiber_cnt; ++i) {
+                    fiber{ fib_fn, ::std::ref(b) }.detach();
+                }
+                runner->run();
+            });
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+        auto elapsed = ::std::chrono::duration_cast< ::std::chrono::milliseconds >(
+                ::std::chrono::steady_clock::now() - start);
+        EXPECT_EQ(fiber_cnt * thread_cnt, committed);
+        ::std::cout << committed << " transactions in " << elapsed.count() << "ms\n";
+    }
+}
+
 } /* namespace test */
 } /* namespace pg */
 } /* namespace db */
@@ -13,6 +13,7 @@
 #include <tip/db/pg/error.hpp>
 
 #include <tip/db/pg/detail/protocol.hpp>
+#include <tip/db/pg/detail/result_impl.hpp>
 
 #include <tip/db/pg/detail/basic_connection.hpp>
 #include <tip/db/pg/detail/connection_pool.hpp>
@@ -86,6 +87,143 @@ TEST( LiteralsTest, ConnectionString )
     EXPECT_EQ("", opts.password);
 }
 
+TEST( ResultsetTest, IndexOfName )
+{
+    using namespace tip::db::pg;
+    auto impl = std::make_shared< tip::db::pg::detail::result_impl >();
+    for (auto name : { "id", "name", "id", "value" }) {
+        field_description fd{};
+        fd.name = name;
+        impl->row_description().push_back(fd);
+    }
+    resultset res{ impl };
+    EXPECT_EQ(0, res.index_of_name("id")); // first of duplicate names
+    EXPECT_EQ(1, res.index_of_name("name"));
+    EXPECT_EQ(3, res.index_of_name("value"));
+    EXPECT_EQ(resultset::npos, res.index_of_name("missing"));
+    EXPECT_EQ("value", res.field("value").name);
+    EXPECT_THROW(res.field("missing"), std::runtime_error);
+
+    // Changing the description drops the index
+    impl->row_description()[3].name = "other";
+    EXPECT_EQ(resultset::npos, res.index_of_name("value"));
+    EXPECT_EQ(3, res.index_of_name("other"));
+
+    // Index built for a prepared statement is reused
+    tip::db::pg::detail::result_impl::name_index_ptr idx =
+            tip::db::pg::detail::result_impl::build_name_index(impl->row_description());
+    auto other = std::make_shared< tip::db::pg::detail::result_impl >();
+    other->row_description() = impl->row_description();
+    other->set_name_index(idx);
+    EXPECT_EQ(idx, other->name_index());
+    EXPECT_EQ(3, resultset{ other }.index_of_name("other"));
+}
+
+namespace {
+/** Type read via the input operator */
+struct stream_point {
+    int x, y;
+};
+std::istream&
+operator >> (std::istream& is, stream_point& val)
+{
+    char sep;
+    return is >> val.x >> sep >> val.y;
+}
+}  // namespace
+
+static_assert(tip::db::pg::io::traits::has_raw_parser<
+        tip::db::pg::integer, tip::db::pg::TEXT_DATA_FORMAT >::value,
+        "Integers are parsed in place");
+static_assert(tip::db::pg::io::traits::has_raw_parser<
+        std::string, tip::db::pg::TEXT_DATA_FORMAT >::value,
+        "Strings are parsed in place");
+static_assert(tip::db::pg::io::traits::has_raw_parser<
+        tip::db::pg::bigint, tip::db::pg::BINARY_DATA_FORMAT >::value,
+        "Binary integers are parsed in place");
+static_assert(!tip::db::pg::io::traits::has_raw_parser<
+        stream_point, tip::db::pg::TEXT_DATA_FORMAT >::value,
+        "Input operator types are read via a stream buffer");
+
+TEST( ResultsetTest, FieldAccess )
+{
+    using namespace tip::db::pg;
+    auto impl = std::make_shared< tip::db::pg::detail::result_impl >();
+    field_description fd{};
+    fd.name = "num";
+    fd.type_oid = oids::type::int4;
+    impl->row_description().push_back(fd);
+    fd.name = "big";
+    fd.type_oid = oids::type::int8;
+    fd.format_code = BINARY_DATA_FORMAT;
+    impl->row_description().push_back(fd);
+    fd.name = "point";
+    fd.type_oid = oids::type::text;
+    fd.format_code = TEXT_DATA_FORMAT;
+    impl->row_description().push_back(fd);
+    fd.name = "empty";
+    impl->row_description().push_back(fd);
+
+    tip::db::pg::detail::row_data row;
+    std::string num{"-42"};
+    row.offsets.push_back(row.data.size());
+    row.data.insert(row.data.end(), num.begin(), num.end());
+    row.offsets.push_back(row.data.size());
+    io::protocol_write< BINARY_DATA_FORMAT >(row.data, bigint{ 1LL << 40 });
+    std::string point{"3,4"};
+    row.offsets.push_back(row.data.size());
+    row.data.insert(row.data.end(), point.begin(), point.end());
+    row.offsets.push_back(row.data.size());
+    impl->add_row(row);
+
+    resultset res{ impl };
+    EXPECT_EQ(-42, res[0][0].as< integer >());
+    EXPECT_EQ("-42", res[0][0].as< std::string >());
+    EXPECT_EQ(1LL << 40, res[0][1].as< bigint >());
+    stream_point pt = res[0][2].as< stream_point >();
+    EXPECT_EQ(3, pt.x);
+    EXPECT_EQ(4, pt.y);
+    EXPECT_EQ("", res[0][3].as< std::string >());
+}
+
+TEST( QueryParamsTest, Encoding )
+{
+    using namespace tip::db::pg;
+    std::vector< oids::type::oid_type > param_types;
+    std::vector< byte > params;
+    tip::db::pg::detail::write_params(param_types, params, integer{ 10 },
+            std::string{ "abc" }, bigint{ -1 });
+    // The buffer is allocated once with the exact size
+    EXPECT_EQ(params.size(), params.capacity());
+    ASSERT_EQ(3, param_types.size());
+
+    std::vector< byte > expected;
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, smallint{ 3 });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, (smallint)BINARY_DATA_FORMAT);
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, (smallint)TEXT_DATA_FORMAT);
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, (smallint)BINARY_DATA_FORMAT);
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, smallint{ 3 });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, integer{ 4 });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, integer{ 10 });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, integer{ 3 });
+    expected.insert(expected.end(), { 'a', 'b', 'c' });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, integer{ 8 });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, bigint{ -1 });
+    EXPECT_EQ(expected, params);
+
+    // Text only parameters
+    params.clear();
+    param_types.clear();
+    tip::db::pg::detail::write_params(param_types, params, std::string{ "x" }, std::string{});
+    expected.clear();
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, (smallint)TEXT_DATA_FORMAT);
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, smallint{ 2 });
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, integer{ 1 });
+    expected.push_back('x');
+    io::protocol_write< BINARY_DATA_FORMAT >(expected, integer{ 0 });
+    EXPECT_EQ(expected, params);
+}
+
 TEST( ConnectionTest, Connect)
 {
     using namespace tip::db::pg;
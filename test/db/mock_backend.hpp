@@ -0,0 +1,371 @@
+/*
+ * mock_backend.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#ifndef LIB_PG_ASYNC_TEST_DB_MOCK_BACKEND_HPP_
+#define LIB_PG_ASYNC_TEST_DB_MOCK_BACKEND_HPP_
+
+#include <tip/db/pg/asio_config.hpp>
+#include <tip/db/pg/common.hpp>
+#include <tip/db/pg/protocol_io_traits.hpp>
+#include <tip/db/pg/detail/protocol.hpp>
+
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace test {
+
+using wire_buffer = std::vector< byte >;
+
+/**
+ * Column of a RowDescription message
+ */
+struct wire_column {
+    std::string             name;
+    oids::type::oid_type    type;
+    protocol_data_format    format;
+
+    wire_column(std::string const& n,
+            oids::type::oid_type t = oids::type::text,
+            protocol_data_format fmt = TEXT_DATA_FORMAT)
+        : name{n}, type{t}, format{fmt} {}
+    wire_column(char const* n)
+        : wire_column{ std::string{n} } {}
+};
+
+/**
+ * Value of a DataRow field, null when default constructed
+ */
+struct wire_field {
+    bool        is_null;
+    wire_buffer bytes;
+
+    wire_field() : is_null{true}, bytes{} {}
+    wire_field(std::string const& text)
+        : is_null{false}, bytes(text.begin(), text.end()) {}
+    wire_field(char const* text)
+        : wire_field{ std::string{text} } {}
+
+    /** Value in binary format */
+    template < typename T >
+    static wire_field
+    binary(T val)
+    {
+        wire_field f;
+        f.is_null = false;
+        io::protocol_write< BINARY_DATA_FORMAT >(f.bytes, val);
+        return f;
+    }
+};
+
+/**
+ * Backend messages as they are read from the socket, appended to a buffer.
+ *
+ * @code
+ * backend_stream out;
+ * out.row_description({ "id" }).data_row({ "1" }).command_complete("SELECT 1");
+ * @endcode
+ */
+class backend_stream {
+public:
+    backend_stream() : buffer_{} {}
+
+    wire_buffer&
+    bytes()
+    { return buffer_; }
+    wire_buffer const&
+    bytes() const
+    { return buffer_; }
+
+    /** Append a message with a ready body */
+    backend_stream&
+    message(detail::message_tag tag, wire_buffer const& body = wire_buffer{})
+    {
+        message_writer msg{ buffer_, tag };
+        buffer_.insert(buffer_.end(), body.begin(), body.end());
+        return *this;
+    }
+
+    backend_stream&
+    authentication(integer state, std::string const& data = std::string{})
+    {
+        message_writer msg{ buffer_, detail::authentication_tag };
+        write(state);
+        buffer_.insert(buffer_.end(), data.begin(), data.end());
+        return *this;
+    }
+    backend_stream&
+    parameter_status(std::string const& key, std::string const& value)
+    {
+        message_writer msg{ buffer_, detail::parameter_status_tag };
+        write(key);
+        write(value);
+        return *this;
+    }
+    backend_stream&
+    backend_key_data(integer pid, integer key)
+    {
+        message_writer msg{ buffer_, detail::backend_key_data_tag };
+        write(pid);
+        write(key);
+        return *this;
+    }
+    backend_stream&
+    parameter_description(std::vector< oids::type::oid_type > const& types)
+    {
+        message_writer msg{ buffer_, detail::parameter_desription_tag };
+        write(static_cast< smallint >(types.size()));
+        for (auto t : types) {
+            write(static_cast< integer >(t));
+        }
+        return *this;
+    }
+    backend_stream&
+    row_description(std::initializer_list< wire_column > columns)
+    {
+        return row_description(std::vector< wire_column >(columns));
+    }
+    backend_stream&
+    row_description(std::vector< wire_column > const& columns)
+    {
+        message_writer msg{ buffer_, detail::row_description_tag };
+        write(static_cast< smallint >(columns.size()));
+        for (auto const& col : columns) {
+            write(col.name);
+            write(integer{ 0 });    // table oid
+            write(smallint{ 0 });   // attribute number
+            write(static_cast< integer >(col.type));
+            write(smallint{ -1 });  // type size
+            write(integer{ -1 });   // type modifier
+            write(static_cast< smallint >(col.format));
+        }
+        return *this;
+    }
+    backend_stream&
+    data_row(std::initializer_list< wire_field > fields)
+    {
+        return data_row(std::vector< wire_field >(fields));
+    }
+    backend_stream&
+    data_row(std::vector< wire_field > const& fields)
+    {
+        message_writer msg{ buffer_, detail::data_row_tag };
+        write(static_cast< smallint >(fields.size()));
+        for (auto const& f : fields) {
+            if (f.is_null) {
+                write(integer{ -1 });
+            } else {
+                write(static_cast< integer >(f.bytes.size()));
+                buffer_.insert(buffer_.end(), f.bytes.begin(), f.bytes.end());
+            }
+        }
+        return *this;
+    }
+    backend_stream&
+    command_complete(std::string const& tag)
+    {
+        message_writer msg{ buffer_, detail::command_complete_tag };
+        write(tag);
+        return *this;
+    }
+    backend_stream&
+    ready_for_query(char status)
+    {
+        message_writer msg{ buffer_, detail::ready_for_query_tag };
+        buffer_.push_back(status);
+        return *this;
+    }
+private:
+    /**
+     * Message under construction, the length is patched on destruction
+     */
+    class message_writer {
+    public:
+        message_writer(wire_buffer& out, detail::message_tag tag)
+            : out_(out), start_{ out.size() + 1 }
+        {
+            out_.push_back(tag);
+            io::protocol_write< BINARY_DATA_FORMAT >(out_, integer{ 0 });
+        }
+        ~message_writer()
+        {
+            wire_buffer len;
+            io::protocol_write< BINARY_DATA_FORMAT >(len,
+                    static_cast< integer >(out_.size() - start_));
+            std::copy(len.begin(), len.end(), out_.begin() + start_);
+        }
+    private:
+        wire_buffer&    out_;
+        std::size_t     start_;
+    };
+
+    template < typename T >
+    void
+    write(T val)
+    {
+        io::protocol_write< BINARY_DATA_FORMAT >(buffer_, val);
+    }
+    void
+    write(std::string const& str)
+    {
+        buffer_.insert(buffer_.end(), str.begin(), str.end());
+        buffer_.push_back(0);
+    }
+private:
+    wire_buffer buffer_;
+};
+
+/**
+ * Connection transport without a socket.
+ *
+ * Bytes pushed by a test with feed are handed to the connection in the
+ * calling thread. Messages the connection writes are passed to the
+ * responder, its answer is delivered through the io service.
+ */
+class fake_transport {
+public:
+    using io_service_ptr = asio_config::io_service_ptr;
+    using error_code = asio_config::error_code;
+    using connect_callback = std::function< void (error_code const&) >;
+    using read_handler = std::function< void (error_code const&, std::size_t) >;
+    /**
+     * Answers a frontend message, the startup message has empty_tag.
+     * Called under the transport lock.
+     */
+    using responder_type = std::function<
+            void (byte const* data, std::size_t size, backend_stream& out) >;
+public:
+    fake_transport(io_service_ptr svc)
+        : svc_{svc}, mutex_{}, buffer_{nullptr}, handler_{}, pending_{}
+    {
+        instance() = this;
+    }
+    ~fake_transport()
+    {
+        if (instance() == this)
+            instance() = nullptr;
+    }
+
+    /** The transport created last */
+    static fake_transport*&
+    instance()
+    {
+        static fake_transport* transport = nullptr;
+        return transport;
+    }
+    /** Responder for all transports, frontend messages are dropped if empty */
+    static responder_type&
+    responder()
+    {
+        static responder_type resp;
+        return resp;
+    }
+
+    void
+    connect_async(connection_options const&, connect_callback cb)
+    {
+        cb(error_code{});
+    }
+
+    bool
+    connected() const
+    {
+        return true;
+    }
+
+    void
+    close()
+    {
+    }
+
+    template < typename HandlerType >
+    void
+    async_read(ASIO_NAMESPACE::streambuf& buffer, HandlerType handler)
+    {
+        std::lock_guard< std::mutex > lock{mutex_};
+        buffer_ = &buffer;
+        handler_ = handler;
+        deliver();
+    }
+
+    template < typename BufferType, typename HandlerType >
+    void
+    async_write(BufferType const& buffer, HandlerType handler)
+    {
+        std::size_t size = ASIO_NAMESPACE::buffer_size(buffer);
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            if (responder()) {
+                responder()(ASIO_NAMESPACE::buffer_cast< byte const* >(buffer),
+                        size, pending_);
+                deliver();
+            }
+        }
+        svc_->post([handler, size]() mutable { handler(error_code{}, size); });
+    }
+
+    /**
+     * Hand the bytes to the connection in the calling thread. If the
+     * connection is not reading, the bytes are delivered when it starts.
+     */
+    void
+    feed(wire_buffer const& bytes)
+    {
+        read_handler handler;
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            if (!handler_) {
+                pending_.bytes().insert(pending_.bytes().end(),
+                        bytes.begin(), bytes.end());
+                return;
+            }
+            std::ostream os(buffer_);
+            os.write(bytes.data(), bytes.size());
+            handler.swap(handler_);
+        }
+        handler(error_code{}, bytes.size());
+    }
+    void
+    feed(backend_stream const& stream)
+    {
+        feed(stream.bytes());
+    }
+private:
+    /** Post pending bytes to the reading connection */
+    void
+    deliver()
+    {
+        if (!handler_ || pending_.bytes().empty())
+            return;
+        std::ostream os(buffer_);
+        os.write(pending_.bytes().data(), pending_.bytes().size());
+        std::size_t size = pending_.bytes().size();
+        pending_.bytes().clear();
+        read_handler handler;
+        handler.swap(handler_);
+        svc_->post([handler, size]() mutable { handler(error_code{}, size); });
+    }
+private:
+    io_service_ptr              svc_;
+    std::mutex                  mutex_;
+    ASIO_NAMESPACE::streambuf*  buffer_;
+    read_handler                handler_;
+    backend_stream              pending_;
+};
+
+}  // namespace test
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+#endif /* LIB_PG_ASYNC_TEST_DB_MOCK_BACKEND_HPP_ */
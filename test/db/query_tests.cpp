@@ -305,3 +305,57 @@ TEST(QueryTest, BasicResultParsing)
         }
     }
 }
+
+TEST(PreparedQueryTest, SharedStatement)
+{
+    prepared_query< integer, std::string > q("main"_db,
+            "select $1::integer, $2::text");
+    prepared_query< integer, std::string > copy = q;
+    // Copies share the statement
+    EXPECT_EQ(q.statement().get(), copy.statement().get());
+    ASSERT_EQ(2, q.statement()->param_types.size());
+    EXPECT_EQ(oids::type::int4, q.statement()->param_types[0]);
+    EXPECT_EQ(oids::type::text, q.statement()->param_types[1]);
+    EXPECT_EQ("select $1::integer, $2::text", q.statement()->expression);
+
+    // The same name as the one generated for an ad-hoc query
+    prepared_statement adhoc{ "select $1::integer, $2::text",
+        { oids::type::int4, oids::type::text } };
+    EXPECT_EQ(adhoc.name, q.statement()->name);
+    prepared_query< bigint > other("main"_db, "select $1::integer");
+    EXPECT_NE(other.statement()->name, q.statement()->name);
+
+    prepared_query< > no_params("main"_db, "select 1");
+    EXPECT_TRUE(no_params.statement()->param_types.empty());
+}
+
+TEST(PreparedQueryTest, Run)
+{
+    if (!test::environment::test_database.empty()) {
+        ASSERT_NO_THROW(db_service::add_connection(test::environment::test_database));
+        connection_options opts = connection_options::parse(test::environment::test_database);
+
+        prepared_query< integer, std::string > q(opts.alias,
+                "select $1::integer as num, $2::text as str");
+        const int run_count = 10;
+        int results = 0;
+        for (int i = 0; i < run_count; ++i) {
+            q(i, std::to_string(i),
+            [&, i](transaction_ptr tran, resultset r, bool complete) {
+                if (complete) {
+                    ASSERT_EQ(1, r.size());
+                    EXPECT_EQ(i, r[0][0].as< integer >());
+                    EXPECT_EQ(std::to_string(i), r[0][1].as< std::string >());
+                    tran->commit_async();
+                    if (++results == run_count)
+                        db_service::stop();
+                }
+            },
+            [](error::db_error const&) {
+                FAIL();
+            });
+        }
+        db_service::run();
+        EXPECT_EQ(run_count, results);
+    }
+}
@@ -0,0 +1,314 @@
+/*
+ * row_mapping_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+
+#include <tip/db/pg.hpp>
+#include <tip/db/pg/query.hpp>
+#include <tip/db/pg/detail/result_impl.hpp>
+#include <tip/db/pg/detail/protocol_parsers.hpp>
+
+#include <boost/optional/optional_io.hpp>
+
+#include <cstring>
+
+#include "db/config.hpp"
+#include "test-environment.hpp"
+
+namespace pg_test {
+
+struct person {
+    tip::db::pg::integer            id;
+    std::string                     name;
+    boost::optional< std::string >  email;
+};
+
+struct account {
+    tip::db::pg::bigint             id;
+    std::string                     owner;
+    double                          balance;
+};
+
+}  // namespace pg_test
+
+PG_ASYNC_ROW_MAPPING(::pg_test::person, (id)(name)(email))
+
+namespace tip {
+namespace db {
+namespace pg {
+namespace io {
+namespace traits {
+
+template < >
+struct row_mapping< ::pg_test::account > {
+    template < typename Visitor >
+    static void
+    visit(Visitor& v)
+    {
+        v("account_id",     &::pg_test::account::id);
+        v("owner",          &::pg_test::account::owner);
+        v("balance",        &::pg_test::account::balance);
+    }
+};
+
+}  // namespace traits
+}  // namespace io
+}  // namespace pg
+}  // namespace db
+}  // namespace tip
+
+using namespace tip::db::pg;
+
+namespace {
+
+field_description
+make_field(std::string const& name, oids::type::oid_type oid,
+        protocol_data_format fmt = TEXT_DATA_FORMAT)
+{
+    return field_description{ name, 0, 0, oid, -1, 0, fmt, 0 };
+}
+
+/**
+ * Build a row from field values, an empty optional is a null field
+ */
+detail::row_data
+make_row(std::initializer_list< boost::optional< std::string > > fields)
+{
+    detail::row_data row;
+    detail::row_data::size_type index = 0;
+    for (auto const& f : fields) {
+        row.offsets.push_back(row.data.size());
+        if (f) {
+            row.data.insert(row.data.end(), f->begin(), f->end());
+        } else {
+            row.null_map.push_back(index);
+        }
+        ++index;
+    }
+    return row;
+}
+
+}  // namespace
+
+TEST(RowMappingTest, TextColumnsByName)
+{
+    auto impl = std::make_shared< detail::result_impl >();
+    // Column order differs from member order, an extra column is ignored
+    impl->row_description().push_back(make_field("email", oids::type::text));
+    impl->row_description().push_back(make_field("extra", oids::type::int4));
+    impl->row_description().push_back(make_field("name", oids::type::text));
+    impl->row_description().push_back(make_field("id", oids::type::int4));
+    impl->add_row(make_row({ std::string{"ann@example.com"},
+        std::string{"1"}, std::string{"Ann"}, std::string{"10"} }));
+    impl->add_row(make_row({ boost::none,
+        std::string{"2"}, std::string{"Bob"}, std::string{"20"} }));
+
+    resultset res{ impl };
+    std::vector< pg_test::person > persons;
+    res.to(persons);
+    ASSERT_EQ(2, persons.size());
+    EXPECT_EQ(10, persons[0].id);
+    EXPECT_EQ("Ann", persons[0].name);
+    EXPECT_EQ(boost::optional< std::string >{ "ann@example.com" }, persons[0].email);
+    EXPECT_EQ(20, persons[1].id);
+    EXPECT_EQ("Bob", persons[1].name);
+    EXPECT_FALSE(persons[1].email.is_initialized());
+}
+
+TEST(RowMappingTest, BinaryColumns)
+{
+    auto impl = std::make_shared< detail::result_impl >();
+    impl->row_description().push_back(
+            make_field("account_id", oids::type::int8, BINARY_DATA_FORMAT));
+    // No binary parser for std::string from int4, read via text conversion
+    impl->row_description().push_back(
+            make_field("owner", oids::type::int4, BINARY_DATA_FORMAT));
+    impl->row_description().push_back(make_field("balance", oids::type::float8));
+
+    std::vector< byte > id_buffer, owner_buffer;
+    io::protocol_write< BINARY_DATA_FORMAT >(id_buffer, bigint{ 1234567890123 });
+    io::protocol_write< BINARY_DATA_FORMAT >(owner_buffer, integer{ 42 });
+
+    detail::row_data row;
+    row.offsets.push_back(0);
+    row.data.insert(row.data.end(), id_buffer.begin(), id_buffer.end());
+    row.offsets.push_back(row.data.size());
+    row.data.insert(row.data.end(), owner_buffer.begin(), owner_buffer.end());
+    row.offsets.push_back(row.data.size());
+    std::string balance{"100.5"};
+    row.data.insert(row.data.end(), balance.begin(), balance.end());
+    impl->add_row(row);
+
+    resultset res{ impl };
+    std::vector< pg_test::account > accounts;
+    res.to(accounts);
+    ASSERT_EQ(1, accounts.size());
+    EXPECT_EQ(1234567890123, accounts[0].id);
+    EXPECT_EQ("42", accounts[0].owner);
+    EXPECT_EQ(100.5, accounts[0].balance);
+}
+
+TEST(RowMappingTest, Errors)
+{
+    auto impl = std::make_shared< detail::result_impl >();
+    impl->row_description().push_back(make_field("id", oids::type::int4));
+    impl->row_description().push_back(make_field("name", oids::type::text));
+    impl->add_row(make_row({ std::string{"1"}, std::string{"Ann"} }));
+
+    resultset res{ impl };
+    std::vector< pg_test::person > persons;
+    // No 'email' column in the result set
+    EXPECT_THROW(res.to(persons), error::db_error);
+
+    impl = std::make_shared< detail::result_impl >();
+    impl->row_description().push_back(make_field("id", oids::type::int4));
+    impl->row_description().push_back(make_field("name", oids::type::text));
+    impl->row_description().push_back(make_field("email", oids::type::text));
+    impl->add_row(make_row({ boost::none, std::string{"Ann"}, boost::none }));
+    // Null value for a non-nullable member
+    res = resultset{ impl };
+    EXPECT_THROW(res.to(persons), error::value_is_null);
+}
+
+TEST(RowMappingTest, DBRoundtrip)
+{
+    if (!test::environment::test_database.empty()) {
+        db_service::add_connection(test::environment::test_database);
+        connection_options opts = connection_options::parse(test::environment::test_database);
+
+        resultset res;
+        db_service::begin(opts.alias,
+        [&](transaction_ptr tran) {
+            query(tran, "select name, email, id from (values "
+                    "(1, 'Ann', 'ann@example.com'), (2, 'Bob', null)) "
+                    "as t(id, name, email) order by id")(
+            [&res](transaction_ptr, resultset r, bool){
+                res = r;
+            },
+            [](error::db_error const&) {
+            });
+            tran->commit_async([](){
+                db_service::stop();
+            });
+        },
+        [](error::db_error const&) {
+            db_service::stop();
+        });
+
+        db_service::run();
+
+        std::vector< pg_test::person > persons;
+        res.to(persons);
+        ASSERT_EQ(2, persons.size());
+        EXPECT_EQ(1, persons[0].id);
+        EXPECT_EQ("Ann", persons[0].name);
+        EXPECT_EQ(boost::optional< std::string >{ "ann@example.com" }, persons[0].email);
+        EXPECT_EQ(2, persons[1].id);
+        EXPECT_EQ("Bob", persons[1].name);
+        EXPECT_FALSE(persons[1].email.is_initialized());
+    }
+}
+
+TEST(ColumnExtractionTest, BinaryFixedWidth)
+{
+    auto impl = std::make_shared< detail::result_impl >();
+    impl->row_description().push_back(
+            make_field("id", oids::type::int8, BINARY_DATA_FORMAT));
+    impl->row_description().push_back(
+            make_field("price", oids::type::float8, BINARY_DATA_FORMAT));
+    impl->row_description().push_back(
+            make_field("qty", oids::type::int4, BINARY_DATA_FORMAT));
+    impl->row_description().push_back(make_field("name", oids::type::text));
+
+    // Enough rows for the vectorized path and a scalar tail
+    const int row_count = 37;
+    for (int i = 0; i < row_count; ++i) {
+        detail::row_data row;
+        row.offsets.push_back(row.data.size());
+        io::protocol_write< BINARY_DATA_FORMAT >(row.data, bigint{ 10000000000LL + i });
+        row.offsets.push_back(row.data.size());
+        io::protocol_write< BINARY_DATA_FORMAT >(row.data, i * 0.5);
+        row.offsets.push_back(row.data.size());
+        if (i % 5) {
+            io::protocol_write< BINARY_DATA_FORMAT >(row.data, integer{ -i });
+        } else {
+            row.null_map.push_back(2);
+        }
+        row.offsets.push_back(row.data.size());
+        std::string name = "item" + std::to_string(i);
+        row.data.insert(row.data.end(), name.begin(), name.end());
+        impl->add_row(row);
+    }
+
+    resultset res{ impl };
+    std::vector< bigint > ids = res.column< bigint >("id");
+    std::vector< double > prices;
+    res.column(1, prices);
+    std::vector< boost::optional< integer > > qty = res.column< boost::optional< integer > >(2);
+    std::vector< std::string > names = res.column< std::string >(3);
+    // int8 column read as text
+    std::vector< std::string > id_strings = res.column< std::string >(0);
+
+    ASSERT_EQ(row_count, ids.size());
+    ASSERT_EQ(row_count, prices.size());
+    ASSERT_EQ(row_count, qty.size());
+    ASSERT_EQ(row_count, names.size());
+    for (int i = 0; i < row_count; ++i) {
+        EXPECT_EQ(10000000000LL + i, ids[i]);
+        EXPECT_EQ(i * 0.5, prices[i]);
+        if (i % 5) {
+            EXPECT_EQ(boost::optional< integer >{ -i }, qty[i]);
+        } else {
+            EXPECT_FALSE(qty[i].is_initialized());
+        }
+        EXPECT_EQ("item" + std::to_string(i), names[i]);
+        EXPECT_EQ(std::to_string(10000000000LL + i), id_strings[i]);
+    }
+
+    bigint buffer[row_count];
+    res.column(0, buffer, row_count);
+    EXPECT_EQ(10000000000LL + row_count - 1, buffer[row_count - 1]);
+    EXPECT_THROW(res.column(0, buffer, row_count - 1), std::out_of_range);
+
+    // Nulls in a non-nullable column
+    std::vector< integer > int_qty;
+    EXPECT_THROW(res.column(2, int_qty), error::value_is_null);
+    EXPECT_THROW(res.column< integer >("missing"), error::db_error);
+    EXPECT_THROW(res.column< integer >(4), std::out_of_range);
+}
+
+template < typename T >
+void
+check_big_to_native()
+{
+    // Lengths around the 16 and 32 byte vector widths
+    for (std::size_t count = 0; count < 41; ++count) {
+        std::vector< T > values(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = static_cast< T >(0x0102030405060708ULL * (i + 1));
+        }
+        std::vector< char > data;
+        for (auto v : values) {
+            io::protocol_write< BINARY_DATA_FORMAT >(data, v);
+        }
+        ASSERT_EQ(count * sizeof(T), data.size());
+        io::detail::big_to_native(data.data(), count, sizeof(T));
+        for (std::size_t i = 0; i < count; ++i) {
+            T v;
+            std::memcpy(&v, data.data() + i * sizeof(T), sizeof(T));
+            EXPECT_EQ(values[i], v) << "width " << sizeof(T)
+                    << " count " << count << " index " << i;
+        }
+    }
+}
+
+TEST(ColumnExtractionTest, BigToNative)
+{
+    check_big_to_native< smallint >();
+    check_big_to_native< integer >();
+    check_big_to_native< bigint >();
+}
@@ -115,3 +115,84 @@ INSTANTIATE_TEST_CASE_P(IOTest, DateTimeIOTest,
     )
 );
 
+
+class DateTimeLayoutTest : public DateTimeIOTest {};
+
+TEST_P(DateTimeLayoutTest, Parse)
+{
+    ParamType test_val = GetParam();
+
+    boost::posix_time::ptime val;
+    auto res = io::protocol_read< TEXT_DATA_FORMAT >(test_val.first.begin(),
+            test_val.first.end(), val);
+    EXPECT_EQ( test_val.second, val );
+    if (!test_val.second.is_not_a_date_time()) {
+        EXPECT_EQ( test_val.first.end(), res ) << "The whole value is consumed";
+    } else {
+        EXPECT_EQ( test_val.first.begin(), res ) << "Nothing is consumed";
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(IOTest, DateTimeLayoutTest,
+    ::testing::Values(
+        DateTimeIOTest::make_test_data(
+            "2016-03-24 18:01:02",
+            { date{ 2016, boost::gregorian::Mar, 24 }, time_duration{ 18, 1, 2 } }),
+        DateTimeIOTest::make_test_data(
+            "2016-03-24 18:01:02.5",
+            { date{ 2016, boost::gregorian::Mar, 24 },
+                time_duration{ 18, 1, 2 } + boost::posix_time::milliseconds(500) }),
+        DateTimeIOTest::make_test_data(
+            "2016-03-24 18:01:02.000123",
+            { date{ 2016, boost::gregorian::Mar, 24 },
+                time_duration{ 18, 1, 2 } + boost::posix_time::microseconds(123) }),
+        DateTimeIOTest::make_test_data(
+            "2016-02-29 23:59:59.999999+05:30",
+            { date{ 2016, boost::gregorian::Feb, 29 },
+                time_duration{ 23, 59, 59 } + boost::posix_time::microseconds(999999) }),
+        DateTimeIOTest::make_test_data(
+            "1900-12-31 00:00:00-03:20:15",
+            { date{ 1900, boost::gregorian::Dec, 31 }, time_duration{ 0, 0, 0 } }),
+        DateTimeIOTest::make_test_data(
+            "infinity", ptime{ boost::posix_time::pos_infin }),
+        DateTimeIOTest::make_test_data(
+            "-infinity", ptime{ boost::posix_time::neg_infin }),
+        // Invalid values
+        DateTimeIOTest::make_test_data("2015-02-29 00:00:00", {}),
+        DateTimeIOTest::make_test_data("2016-13-01 00:00:00", {}),
+        DateTimeIOTest::make_test_data("2016-03-24 24:00:00", {}),
+        DateTimeIOTest::make_test_data("2016-03-24 18:60:00", {}),
+        DateTimeIOTest::make_test_data("2016-03-24T18:00:00", {}),
+        DateTimeIOTest::make_test_data("2016-03-24 18:00:00.", {}),
+        DateTimeIOTest::make_test_data("2016-3-24 18:00:00", {}),
+        DateTimeIOTest::make_test_data("2016-03-24", {})
+    )
+);
+
+TEST(IOTest, DateTextParse)
+{
+    ::std::string literal{ "2016-03-24" };
+    date val;
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), val));
+    EXPECT_EQ((date{ 2016, boost::gregorian::Mar, 24 }), val);
+
+    literal = "2016-04-31";
+    EXPECT_EQ(literal.begin(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), val));
+    EXPECT_EQ((date{ 2016, boost::gregorian::Mar, 24 }), val);
+}
+
+TEST(IOTest, TimeTextParse)
+{
+    ::std::string literal{ "12:34:56.789" };
+    time_duration val;
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), val));
+    EXPECT_EQ(time_duration(12, 34, 56) + boost::posix_time::milliseconds(789), val);
+
+    literal = "1 day 01:00:00";
+    EXPECT_EQ(literal.end(), io::protocol_read< TEXT_DATA_FORMAT >(
+            literal.begin(), literal.end(), val));
+    EXPECT_EQ(time_duration(25, 0, 0), val);
+}